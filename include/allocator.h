@@ -0,0 +1,96 @@
+#ifndef C_CUBE_ALLOCATOR_H
+#define C_CUBE_ALLOCATOR_H
+
+#include <cstddef>
+#include <array>
+#include <memory>
+#include <atomic>
+
+// Ayırmaların hangi alt sisteme ait olduğunu belirten etiket.
+// Host, bu etiketlere göre bütçe tutabilir veya ayrı havuzlar kullanabilir.
+enum class AllocCategory {
+    Object,      // GC tarafından yönetilen C-CUBE nesneleri (instance, liste, fonksiyon ...)
+    Ast,         // Parser'ın ürettiği AST düğümleri
+    Token,       // Token ve kaynak metin tamponları
+    Environment, // Ortamlar ve değişken haritaları
+    Collector,   // GC'nin kendi kayıtları (nesne meta verisi, nesil kümeleri, tutamaç tablosu)
+    Other,
+    Count        // Kategori sayısı (dizi boyutu için)
+};
+
+const char* allocCategoryName(AllocCategory category);
+
+// Host'un takabileceği ayırıcı arayüzü. Gc, Parser ve Interpreter yapılandırılırken verilir;
+// çalışma zamanındaki tüm ayırmalar bir kategori etiketiyle buradan geçer.
+class Allocator {
+public:
+    virtual ~Allocator() = default;
+
+    virtual void* allocate(std::size_t size, std::size_t alignment, AllocCategory category) = 0;
+    virtual void deallocate(void* ptr, std::size_t size, std::size_t alignment, AllocCategory category) = 0;
+
+    // Boş sayfaları işletim sistemine geri vermesi için ipucu (tam koleksiyonlardan sonra çağrılır).
+    // retainBytes kadar boş bellek sonraki ayırmalar için tutulabilir. Varsayılan: hiçbir şey yapma.
+    virtual void trim(std::size_t retainBytes) { (void)retainBytes; }
+};
+
+// Varsayılan ayırıcı: global operator new/delete kullanır ve kategori başına bayt sayar.
+// Sayaçlar atomiktir; ayırıcı birden fazla iş parçacığından kullanılabilir.
+class DefaultAllocator : public Allocator {
+public:
+    void* allocate(std::size_t size, std::size_t alignment, AllocCategory category) override;
+    void deallocate(void* ptr, std::size_t size, std::size_t alignment, AllocCategory category) override;
+    // glibc üzerinde malloc_trim ile boş arena sayfalarını (madvise/munmap) geri verir
+    void trim(std::size_t retainBytes) override;
+
+    std::size_t bytesInUse(AllocCategory category) const {
+        return inUse[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<std::size_t>, static_cast<std::size_t>(AllocCategory::Count)> inUse{};
+};
+
+// Süreç genelinde paylaşılan varsayılan ayırıcı
+DefaultAllocator& defaultAllocator();
+
+// Allocator'ı STL kapsayıcılarına ve std::allocate_shared'e bağlayan adaptör
+template <typename T>
+class StlAllocator {
+public:
+    using value_type = T;
+
+    StlAllocator(Allocator& allocator, AllocCategory category) noexcept
+        : allocator(&allocator), category(category) {}
+
+    template <typename U>
+    StlAllocator(const StlAllocator<U>& other) noexcept
+        : allocator(other.allocator), category(other.category) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(allocator->allocate(n * sizeof(T), alignof(T), category));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        allocator->deallocate(ptr, n * sizeof(T), alignof(T), category);
+    }
+
+    template <typename U>
+    bool operator==(const StlAllocator<U>& other) const {
+        return allocator == other.allocator && category == other.category;
+    }
+    template <typename U>
+    bool operator!=(const StlAllocator<U>& other) const { return !(*this == other); }
+
+    // Farklı türe yeniden bağlanan kopyalar (rebind) erişebilsin diye public
+    Allocator* allocator;
+    AllocCategory category;
+};
+
+// Verilen ayırıcı ve kategoriyle shared_ptr oluşturur (nesne ve kontrol bloğu tek ayırmada)
+template <typename T, typename... Args>
+std::shared_ptr<T> allocateShared(Allocator& allocator, AllocCategory category, Args&&... args) {
+    return std::allocate_shared<T>(StlAllocator<T>(allocator, category), std::forward<Args>(args)...);
+}
+
+#endif // C_CUBE_ALLOCATOR_H
@@ -0,0 +1,156 @@
+#ifndef C_CUBE_AOT_RUNTIME_H
+#define C_CUBE_AOT_RUNTIME_H
+
+#include <initializer_list>
+#include <limits> // Üretilen koddaki inf/nan literal'leri
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ast.h"         // Üretilen kodun kurduğu tanım düğümleri (fun, class, import, super)
+#include "interpreter.h" // Ortamlar ve işlem yardımcıları
+#include "value.h"       // Value
+
+// c-cube --emit-cpp ile C++'a çevrilmiş (AOT) modüllerin çalışma zamanı arayüzü. Üretilen kod
+// yalnızca bu başlığı içerir ve ana programla birlikte derlenir (bkz. cpp_emitter.h).
+//
+// Değişkenler yorumlayıcıdaki gibi Environment'larda tutulur ve işlemler Interpreter'ın
+// yardımcılarından (lookUpVariable, binaryOp, callValue, ...) geçer; bu yüzden derlenmiş bir modül
+// isim çözümlemesi, kapanışlar, GC kökleri ve hata mesajları bakımından yorumlanan hâliyle aynı
+// davranır. Kazanç visitor dolaşımının ve AST'nin ortadan kalkmasından, sayı işlemlerinin satır içi
+// yapılmasından gelir. Fonksiyonlar ve metotlar gövdesi C++ fonksiyonu olan FunStmt'ler olarak
+// kurulur; böylece CCubeFunction, bind, sınıflar ve super yorumlayıcıdakiyle aynı kodu kullanır.
+
+// Derlenmiş fonksiyon gövdesi (Interpreter::FunctionState::aotBody). Gövde, parametrelerin tanımlandığı ortamda
+// çalışır; return deyimleri istisna yerine dönüş değeriyle çıkar.
+class AotFunction {
+public:
+    using Body = Value (*)(Interpreter&);
+
+    explicit AotFunction(Body body) : body(body) {}
+
+    Body body;
+};
+
+class AotRuntime {
+public:
+    // Modülün üst düzey bildirimlerini o an geçerli (modül) ortamda çalıştırır
+    using ModuleBody = void (*)(Interpreter&);
+
+    // Derlenmiş modülü import adıyla kaydeder. Üretilen kodda statik bir Registration nesnesi
+    // olarak bulunur; ModuleLoader bu modülleri dosya aramadan önce çözümler.
+    struct Registration {
+        Registration(const char* moduleName, ModuleBody body);
+    };
+
+    // Modülü globals'ın altında yeni bir ortamda çalıştırır (CubeModuleReader::readModule karşılığı).
+    // Çalışma zamanı hatasında nullptr döner.
+    static ModulePtr loadModule(Interpreter& interpreter, const std::string& moduleName, ModuleBody body);
+
+    // Blok kapsamı: yeni ortamı açar, kapsamdan çıkılırken (istisnayla da) öncekini geri yükler.
+    // Önceki ortam kapsam boyunca GC yığın köküdür (Interpreter::executeBlock'taki gibi).
+    class Scope {
+    public:
+        explicit Scope(Interpreter& in) : in(in), previous(in.environment), callerRoot(in.gc, previous.get()) {
+            in.environment = in.newEnvironment(previous);
+        }
+        ~Scope() { in.environment = previous; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Interpreter& in;
+        std::shared_ptr<Environment> previous;
+        GcStackRoot callerRoot;
+    };
+
+    // Sonraki işlenenler değerlendirilirken C++ yerelinde bekleyen ara sonucu GC köküne ekler
+    class Root {
+    public:
+        Root(Interpreter& in, const Value& value) : root(in.gc, value) {}
+
+    private:
+        GcStackRoot root;
+    };
+
+    static SourceLoc at(int line) { return SourceLoc::fromLine(line); }
+
+    // --- Değişkenler ---
+    static Value get(Interpreter& in, const std::string& name, SourceLoc loc) {
+        return in.lookUpVariable(name, loc);
+    }
+    static void define(Interpreter& in, const std::string& name, const Value& value) {
+        in.environment->define(name, value);
+    }
+    static void assign(Interpreter& in, const std::string& name, const Value& value, SourceLoc loc) {
+        in.environment->assign(name, value, loc);
+    }
+
+    // --- İşlemler ---
+    static bool truthy(Interpreter& in, const Value& value) { return in.isTruthy(value); }
+    static bool equal(Interpreter& in, const Value& a, const Value& b) { return in.isEqual(a, b); }
+
+    // Operatör üretilen kodda sabit olduğu için satır içine alınınca switch katlanır. İki sayı
+    // işlenenli durum burada hesaplanır; bölme (sıfır denetimi) ve diğer türler genel yoldan gider.
+    static Value binary(Interpreter& in, TokenType op, SourceLoc loc, const Value& left, const Value& right) {
+        if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right)) {
+            const double l = std::get<double>(left);
+            const double r = std::get<double>(right);
+            switch (op) {
+                case TokenType::PLUS: return l + r;
+                case TokenType::MINUS: return l - r;
+                case TokenType::STAR: return l * r;
+                case TokenType::GREATER: return l > r;
+                case TokenType::GREATER_EQUAL: return l >= r;
+                case TokenType::LESS: return l < r;
+                case TokenType::LESS_EQUAL: return l <= r;
+                case TokenType::EQUAL_EQUAL: return l == r;
+                case TokenType::BANG_EQUAL: return l != r;
+                default: break;
+            }
+        }
+        return in.binaryOp(op, loc, left, right);
+    }
+
+    static Value unary(Interpreter& in, TokenType op, SourceLoc loc, const Value& right) {
+        if (op == TokenType::MINUS && std::holds_alternative<double>(right)) return -std::get<double>(right);
+        if (op == TokenType::BANG) return !in.isTruthy(right);
+        return in.unaryOp(op, loc, right);
+    }
+
+    static Value call(Interpreter& in, const Value& callee, const std::vector<Value>& arguments, SourceLoc paren) {
+        return in.callValue(callee, arguments, paren);
+    }
+    static Value getProperty(Interpreter& in, const Value& object, const std::string& name, SourceLoc loc) {
+        return in.getProperty(object, name, loc);
+    }
+    static std::shared_ptr<CCubeInstance> instanceForSet(Interpreter& in, const Value& object, SourceLoc loc) {
+        return in.instanceForSet(object, loc);
+    }
+    static Value index(Interpreter& in, const Value& object, const Value& position, SourceLoc bracket) {
+        return in.indexValue(object, position, bracket);
+    }
+    static Value list(Interpreter& in, const std::vector<Value>& elements) { return in.gc.createList(elements); }
+
+    static RuntimeException error(Interpreter& in, SourceLoc loc, const std::string& message) {
+        return in.runtimeError(loc, message);
+    }
+
+    // --- Yorumlayıcının yürüttüğü tanımlar ---
+    // Üretilen kod bu düğümleri ilk yürütmede bir kez kurar (fonksiyon içi statik) ve her seferinde
+    // yorumlayıcıya yürütür; fonksiyon nesnesi, sınıf kurulumu ve modül yükleme böylece ortaktır.
+    static std::shared_ptr<FunStmt> function(const char* name, SourceLoc loc,
+                                             std::initializer_list<const char*> params, AotFunction::Body body);
+    // function() ile kurulan düğümün gövdesi; diğer düğümler için nullptr. Yorumlayıcı bunu
+    // fonksiyonun yan tablo kaydına bir kez kopyalar (bkz. Interpreter::functionState).
+    static std::shared_ptr<const AotFunction> bodyOf(const FunStmt& declaration);
+    static StmtPtr classDeclaration(const char* name, SourceLoc loc, const char* superclass, SourceLoc superclassLoc,
+                                    std::vector<std::shared_ptr<FunStmt>> methods); // superclass: yoksa nullptr
+    static StmtPtr import(const char* moduleName, SourceLoc loc, const char* alias);
+    static ExprPtr super(SourceLoc keyword, const char* method, SourceLoc methodLoc);
+
+    static void execute(Interpreter& in, const StmtPtr& stmt) { in.execute(stmt); }
+    static Value evaluate(Interpreter& in, const ExprPtr& expr) { return in.evaluate(expr); }
+};
+
+#endif // C_CUBE_AOT_RUNTIME_H
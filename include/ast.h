@@ -3,10 +3,13 @@
 
 #include <vector>
 #include <string>
+#include <string_view> // Tembel fonksiyon gövdelerinin kaynak aralığı için
 #include <memory> // std::shared_ptr için
 #include <variant> // LiteralType için
 
 #include "token.h" // Token sınıfı için
+#include "source_location.h" // SourceLoc: düğümler Token kopyası yerine 32 bitlik konum tutar
+#include "name_table.h"      // Name: interned tanımlayıcılar
 
 // İleri Bildirimler (Forward Declarations)
 // AST düğümlerini ziyaret edecek Visitor arayüzü
@@ -22,6 +25,8 @@ class Stmt;
 using StmtPtr = std::shared_ptr<Stmt>;
 
 // --- İfade (Expression) Sınıfları ---
+// Düğümler Token saklamaz: operatörler TokenType, isimler Name, konumlar SourceLoc olarak tutulur.
+// Hata mesajları için satır numarası sourceMap().line(loc) ile çözülür.
 
 // Tüm ifade AST düğümleri için temel sınıf
 class Expr {
@@ -30,14 +35,26 @@ public:
     template <typename R> R accept(ExprVisitor<R>& visitor); // Visitor deseni
 };
 
+// Assign (Atama) İfade: name = value (örn: x = 10)
+class AssignExpr : public Expr {
+public:
+    Name name;     // Atama yapılan değişkenin adı
+    SourceLoc loc; // İsmin konumu
+    ExprPtr value; // Atanan değer
+
+    AssignExpr(Name name, SourceLoc loc, ExprPtr value);
+    template <typename R> R accept(ExprVisitor<R>& visitor);
+};
+
 // Binary (İkili) İfade: sol OP sağ (örn: a + b)
 class BinaryExpr : public Expr {
 public:
     ExprPtr left;
-    Token op;
+    TokenType op;  // Operatör türü
+    SourceLoc loc; // Operatörün konumu
     ExprPtr right;
 
-    BinaryExpr(ExprPtr left, Token op, ExprPtr right);
+    BinaryExpr(ExprPtr left, TokenType op, SourceLoc loc, ExprPtr right);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
@@ -45,10 +62,10 @@ public:
 class CallExpr : public Expr {
 public:
     ExprPtr callee; // Çağrılan ifade (bir fonksiyon, metot veya sınıf olabilir)
-    Token paren;    // Parantez token'ı (hata raporlama için)
+    SourceLoc paren; // Kapanan parantezin konumu (hata raporlama için)
     std::vector<ExprPtr> arguments; // Argüman listesi
 
-    CallExpr(ExprPtr callee, Token paren, std::vector<ExprPtr> arguments);
+    CallExpr(ExprPtr callee, SourceLoc paren, std::vector<ExprPtr> arguments);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
@@ -56,9 +73,10 @@ public:
 class GetExpr : public Expr {
 public:
     ExprPtr object; // Üzerinde erişim yapılan obje
-    Token name;     // Erişilen özelliğin/metodun adı
+    Name name;      // Erişilen özelliğin/metodun adı
+    SourceLoc loc;  // İsmin konumu
 
-    GetExpr(ExprPtr object, Token name);
+    GetExpr(ExprPtr object, Name name, SourceLoc loc);
     template <typename R> R R accept(ExprVisitor<R>& visitor);
 };
 
@@ -71,6 +89,17 @@ public:
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
+// Index (Dizin Erişimi) İfade: object[index] (örn: list[0])
+class IndexExpr : public Expr {
+public:
+    ExprPtr object;  // Dizinlenen ifade (liste)
+    SourceLoc bracket; // Kapanan ']' konumu (hata raporlama için)
+    ExprPtr index;     // Dizin ifadesi
+
+    IndexExpr(ExprPtr object, SourceLoc bracket, ExprPtr index);
+    template <typename R> R accept(ExprVisitor<R>& visitor);
+};
+
 // Literal İfade: sayı, string, boolean, none (örn: 123, "hello", true, none)
 class LiteralExpr : public Expr {
 public:
@@ -84,10 +113,11 @@ public:
 class LogicalExpr : public Expr {
 public:
     ExprPtr left;
-    Token op; // AND veya OR
+    TokenType op;  // AND veya OR
+    SourceLoc loc;
     ExprPtr right;
 
-    LogicalExpr(ExprPtr left, Token op, ExprPtr right);
+    LogicalExpr(ExprPtr left, TokenType op, SourceLoc loc, ExprPtr right);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
@@ -95,48 +125,52 @@ public:
 class SetExpr : public Expr {
 public:
     ExprPtr object; // Üzerinde atama yapılan obje
-    Token name;     // Atama yapılan özelliğin adı
+    Name name;      // Atama yapılan özelliğin adı
+    SourceLoc loc;  // İsmin konumu
     ExprPtr value;  // Atanan değer
 
-    SetExpr(ExprPtr object, Token name, ExprPtr value);
+    SetExpr(ExprPtr object, Name name, SourceLoc loc, ExprPtr value);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
 // Super (Üst Sınıf) İfade: super.method (örn: super.init())
 class SuperExpr : public Expr {
 public:
-    Token keyword; // 'super' token'ı
-    Token method;  // Metodun adı
+    SourceLoc keyword;   // 'super' konumu
+    Name method;         // Metodun adı
+    SourceLoc methodLoc; // Metot isminin konumu
 
-    SuperExpr(Token keyword, Token method);
+    SuperExpr(SourceLoc keyword, Name method, SourceLoc methodLoc);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
 // This (Mevcut Obje) İfade: this
 class ThisExpr : public Expr {
 public:
-    Token keyword; // 'this' token'ı
+    SourceLoc keyword; // 'this' konumu
 
-    ThisExpr(Token keyword);
+    ThisExpr(SourceLoc keyword);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
 // Unary (Tekli) İfade: OP sağ (örn: -a, !b)
 class UnaryExpr : public Expr {
 public:
-    Token op;
+    TokenType op;  // BANG veya MINUS
+    SourceLoc loc;
     ExprPtr right;
 
-    UnaryExpr(Token op, ExprPtr right);
+    UnaryExpr(TokenType op, SourceLoc loc, ExprPtr right);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
 // Variable (Değişken) İfade: identifier (örn: x, my_var)
 class VariableExpr : public Expr {
 public:
-    Token name; // Değişkenin adı
+    Name name;     // Değişkenin adı
+    SourceLoc loc;
 
-    VariableExpr(Token name);
+    VariableExpr(Name name, SourceLoc loc);
     template <typename R> R accept(ExprVisitor<R>& visitor);
 };
 
@@ -171,11 +205,12 @@ public:
 // Class (Sınıf) Bildirimi: class MyClass < SuperClass { ... }
 class ClassStmt : public Stmt {
 public:
-    Token name;      // Sınıfın adı
+    Name name;       // Sınıfın adı
+    SourceLoc loc;
     ExprPtr superclass; // Üst sınıf ifadesi (VariableExpr olur)
     std::vector<std::shared_ptr<class FunStmt>> methods; // Sınıfın metotları
 
-    ClassStmt(Token name, ExprPtr superclass, std::vector<std::shared_ptr<class FunStmt>> methods);
+    ClassStmt(Name name, SourceLoc loc, ExprPtr superclass, std::vector<std::shared_ptr<class FunStmt>> methods);
     template <typename R> R accept(StmtVisitor<R>& visitor);
 };
 
@@ -191,11 +226,23 @@ public:
 // Fun (Fonksiyon) Bildirimi: fun myFunc(params) { ... }
 class FunStmt : public Stmt {
 public:
-    Token name;
-    std::vector<Token> params; // Parametre isimleri
+    Name name;
+    SourceLoc loc;
+    std::vector<Name> params; // Parametre isimleri
     std::vector<StmtPtr> body; // Fonksiyon gövdesi (statement listesi)
 
-    FunStmt(Token name, std::vector<Token> params, std::vector<StmtPtr> body);
+    // Tembel gövde: ön-parse modunda gövde yalnızca süslü parantezleri eşleştirilerek atlanır,
+    // AST ilk çağrıda kurulur (bkz. Parser::parseLazyBody). bodyParsed true ise body hazırdır.
+    bool bodyParsed = true;
+    std::string_view bodySource;         // '{' ile '}' arasındaki kaynak metin (kaynak tamponuna bakar)
+    int bodyLine = 0;                    // bodySource'un başladığı satır
+    std::vector<std::string> freeNames;  // Gövdede tanımlanmadan kullanılan isimler (üst küme; dış kapsamdan gelmeli)
+    // Yürütme arka uçlarının durumu (düz kodlama, sayaçlar, makine kodu) düğümde değil
+    // Interpreter::FunctionState'te tutulur
+
+    FunStmt(Name name, SourceLoc loc, std::vector<Name> params, std::vector<StmtPtr> body);
+    FunStmt(Name name, SourceLoc loc, std::vector<Name> params, std::string_view bodySource, int bodyLine,
+            std::vector<std::string> freeNames);
     template <typename R> R accept(StmtVisitor<R>& visitor);
 };
 
@@ -213,30 +260,32 @@ public:
 // Import (İçe Aktarma) Bildirimi: import module_name; veya import module_name as alias;
 class ImportStmt : public Stmt {
 public:
-    Token moduleName; // Modülün adı (Token olarak)
+    Name moduleName;   // Modülün adı
+    SourceLoc loc;
     std::string alias; // Takma ad (eğer varsa, boşsa yok)
 
-    ImportStmt(Token moduleName, std::string alias = "");
+    ImportStmt(Name moduleName, SourceLoc loc, std::string alias = "");
     template <typename R> R accept(StmtVisitor<R>& visitor);
 };
 
 // Return (Dönüş) Bildirimi: return expression; veya return;
 class ReturnStmt : public Stmt {
 public:
-    Token keyword; // 'return' token'ı (hata raporlama için)
-    ExprPtr value;   // Dönüş değeri (opsiyonel)
+    SourceLoc keyword; // 'return' konumu (hata raporlama için)
+    ExprPtr value;     // Dönüş değeri (opsiyonel)
 
-    ReturnStmt(Token keyword, ExprPtr value);
+    ReturnStmt(SourceLoc keyword, ExprPtr value);
     template <typename R> R accept(StmtVisitor<R>& visitor);
 };
 
 // Var (Değişken) Bildirimi: var name = value;
 class VarStmt : public Stmt {
 public:
-    Token name;
+    Name name;
+    SourceLoc loc;
     ExprPtr initializer; // Başlangıç değeri (opsiyonel)
 
-    VarStmt(Token name, ExprPtr initializer);
+    VarStmt(Name name, SourceLoc loc, ExprPtr initializer);
     template <typename R> R accept(StmtVisitor<R>& visitor);
 };
 
@@ -244,7 +293,7 @@ public:
 class WhileStmt : public Stmt {
 public:
     ExprPtr condition;
-    StmtPtr body;
+    StmtPtr body; // İzleme JIT'i durumu Interpreter::LoopState'tedir
 
     WhileStmt(ExprPtr condition, StmtPtr body);
     template <typename R> R accept(StmtVisitor<R>& visitor);
@@ -278,10 +327,12 @@ public:
 template <typename R>
 class ExprVisitor {
 public:
+    virtual R visitAssignExpr(std::shared_ptr<AssignExpr> expr) = 0;
     virtual R visitBinaryExpr(std::shared_ptr<BinaryExpr> expr) = 0;
     virtual R visitCallExpr(std::shared_ptr<CallExpr> expr) = 0;
     virtual R visitGetExpr(std::shared_ptr<GetExpr> expr) = 0;
     virtual R visitGroupingExpr(std::shared_ptr<GroupingExpr> expr) = 0;
+    virtual R visitIndexExpr(std::shared_ptr<IndexExpr> expr) = 0;
     virtual R visitLiteralExpr(std::shared_ptr<LiteralExpr> expr) = 0;
     virtual R visitLogicalExpr(std::shared_ptr<LogicalExpr> expr) = 0;
     virtual R visitSetExpr(std::shared_ptr<SetExpr> expr) = 0;
@@ -380,10 +431,12 @@ R Stmt::accept(StmtVisitor<R>& visitor) {
 // Bu yüzden daha güvenli olan referans tabanlı accept implementasyonunu kullanalım.
 
 // İfade (Expression) Düğümlerinin accept() implementasyonları
+template <typename R> R AssignExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitAssignExpr(std::static_pointer_cast<AssignExpr>(shared_from_this())); }
 template <typename R> R BinaryExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitBinaryExpr(std::static_pointer_cast<BinaryExpr>(shared_from_this())); }
 template <typename R> R CallExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitCallExpr(std::static_pointer_cast<CallExpr>(shared_from_this())); }
 template <typename R> R GetExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitGetExpr(std::static_pointer_cast<GetExpr>(shared_from_this())); }
 template <typename R> R GroupingExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitGroupingExpr(std::static_pointer_cast<GroupingExpr>(shared_from_this())); }
+template <typename R> R IndexExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitIndexExpr(std::static_pointer_cast<IndexExpr>(shared_from_this())); }
 template <typename R> R LiteralExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitLiteralExpr(std::static_pointer_cast<LiteralExpr>(shared_from_this())); }
 template <typename R> R LogicalExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitLogicalExpr(std::static_pointer_cast<LogicalExpr>(shared_from_this())); }
 template <typename R> R SetExpr::accept(ExprVisitor<R>& visitor) { return visitor.visitSetExpr(std::static_pointer_cast<SetExpr>(shared_from_this())); }
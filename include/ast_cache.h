@@ -0,0 +1,46 @@
+#ifndef C_CUBE_AST_CACHE_H
+#define C_CUBE_AST_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ast.h"       // StmtPtr
+#include "allocator.h" // Yüklenen düğümler AllocCategory::Ast ile ayrılır
+
+// Çözümlenmiş AST'nin ikili önbelleği (.ccbc). Önbellek dosyası kaynağın içerik özeti
+// (FNV-1a 64), boyutu ve derleyici sürümüyle anahtarlanır; biri tutmazsa dosya yok sayılır
+// ve kaynak yeniden parse edilir. Kaynak metin yine okunur (özet ve tembel fonksiyon
+// gövdeleri için) ama tarama ve parse atlanır.
+//
+// Dosya düzeni: "CCBC" | u32 biçim sürümü | derleyici sürümü | u64 özet | u64 boyut |
+// isim tablosu | bildirim listesi. Tamsayılar LEB128, konumlar kaynağa göreli ofsettir.
+namespace AstCache {
+
+// Düğüm düzeni (ast.h) ya da kodlama değiştiğinde artırılır; eski önbellekler böylece okunmaz
+constexpr uint32_t FORMAT_VERSION = 1;
+
+// --no-ast-cache ile kapatılır; kapalıyken load/store hiçbir şey yapmadan false döner
+void setEnabled(bool enabled);
+bool isEnabled();
+
+// Kapalıyken (varsayılan) tembel fonksiyon gövdesi içeren dosyalar yüklenmez: o gövdeler
+// hiç parse edilmediği için sözdizimi denetiminden geçmemiştir. Kaynak yeniden parse edilir.
+void setAcceptLazyBodies(bool accept);
+
+uint64_t hashSource(std::string_view source);
+
+// Önbellek dosyasının yolu: C_CUBE_CACHE_DIR tanımlıysa o dizinde, değilse kaynağın yanında
+// aynı isimle ve .ccbc uzantısıyla
+std::string cachePathFor(const std::string& sourcePath);
+
+// source, sourceMap()'e kayıtlı tampon olmalıdır (konumlar ona göre yazılır/okunur).
+// İkisi de başarısızlıkta false döner; yazma hataları (salt okunur dizin vb.) önemsizdir.
+bool store(const std::string& cachePath, std::string_view source, const std::vector<StmtPtr>& program);
+bool load(const std::string& cachePath, std::string_view source, Allocator& allocator,
+          std::vector<StmtPtr>& program);
+
+} // namespace AstCache
+
+#endif // C_CUBE_AST_CACHE_H
@@ -3,13 +3,45 @@
 
 #include "callable.h" // Callable arayüzünü kullanıyoruz
 #include "value.h"    // ValuePtr kullanıyoruz
+#include "object.h"   // NativeFunction bir Object'tir
 
 #include <vector>
 #include <string>
 #include <memory> // std::shared_ptr için
+#include <functional> // std::function için
 
 // Interpreter sınıfını kullanacağımız için ileri bildirim
 class Interpreter;
+class Environment;
+class Gc;
+
+// C++ tarafında yazılmış, script'ten çağrılabilen fonksiyon.
+// Value içinde ObjPtr olarak tutulabilmesi için Object'ten türer.
+class NativeFunction : public Object, public Callable {
+public:
+    using Body = std::function<Value(Interpreter&, const std::vector<Value>&)>;
+
+    NativeFunction(std::string name, size_t arity, Body body)
+        : name(std::move(name)), paramCount(arity), body(std::move(body)) {}
+
+    // Callable arayüzünden
+    virtual size_t arity() const override { return paramCount; }
+    virtual Value call(Interpreter& interpreter, const std::vector<Value>& arguments) override {
+        return body(interpreter, arguments);
+    }
+
+    // Object arayüzünden
+    virtual ObjectType getType() const override { return ObjectType::NATIVE_FUNCTION; }
+    virtual std::string toString() const override { return "<native fn " + name + ">"; }
+    virtual size_t getSize() const override { return sizeof(NativeFunction) + name.capacity(); }
+
+    const std::string& getName() const { return name; }
+
+private:
+    std::string name;
+    size_t paramCount;
+    Body body;
+};
 
 // Built-in 'print' fonksiyonu
 class BuiltinPrint : public Callable {
@@ -47,6 +79,22 @@ public:
     }
 };
 
+namespace BuiltinFunctions {
+    // Yerleşik fonksiyonları ve modülleri (clock, gc, weak) verilen global ortama tanımlar.
+    void defineBuiltins(std::shared_ptr<Environment> globals, Gc& gc);
+
+    // Script seviyesinde çöp toplayıcı kontrolü sağlayan 'gc' modülünü oluşturur:
+    //   gc.collect(full), gc.step(budget), gc.idle(ms), gc.pause(), gc.resume(), gc.stats(),
+    //   gc.setNurserySize(n), gc.setPromotionThreshold(n)
+    ObjPtr makeGcModule(Gc& gc);
+
+    // Zayıf referanslar ve zayıf anahtarlı tablolar için 'weak' modülünü oluşturur:
+    //   weak.ref(obj), weak.get(ref), weak.alive(ref),
+    //   weak.map(), weak.set(map, key, value), weak.lookup(map, key),
+    //   weak.has(map, key), weak.remove(map, key), weak.size(map)
+    ObjPtr makeWeakModule(Gc& gc);
+}
+
 // Ek built-in fonksiyonlar buraya eklenebilir (örn: input, len, tip dönüşümleri vb.)
 // Oyun geliştirme odaklı built-in'ler (örn: get_entity, spawn_actor, load_scene) daha sonra buraya eklenecektir.
 
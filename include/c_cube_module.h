@@ -19,6 +19,7 @@ public:
 
     // Modülün bir üyesini ismine göre döndürür
     Value getMember(const Token& name);
+    Value getMember(const std::string& name, SourceLoc loc);
 
     // Object arayüzünden
     virtual ObjectType getType() const override { return ObjectType::C_CUBE_MODULE; }
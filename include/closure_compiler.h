@@ -0,0 +1,83 @@
+#ifndef C_CUBE_CLOSURE_COMPILER_H
+#define C_CUBE_CLOSURE_COMPILER_H
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ast.h"   // Derlenen düğümler ve Visitor arayüzleri
+#include "value.h" // Value
+
+class Interpreter;
+
+// Derlenmiş ifade/bildirim: önceden bağlanmış bir C++ kapanışı. Yürütme, visitor çift
+// yönlendirmesi yerine doğrudan bu kapanışların çağrılmasıdır.
+using CompiledExpr = std::function<Value(Interpreter&)>;
+using CompiledStmt = std::function<void(Interpreter&)>;
+
+// Bir bildirim listesinin derlenmiş hâli (fonksiyon gövdesi veya program)
+class CompiledBlock {
+public:
+    std::vector<CompiledStmt> statements;
+
+    void run(Interpreter& interpreter) const {
+        for (const auto& statement : statements) statement(interpreter);
+    }
+};
+
+// --exec=closure arka ucu: AST'yi bir kez kapanış ağacına derler. Operatör seçimi ve
+// işlenenleri sabit olan tür denetimleri derleme zamanında yapılır; sabit işlenenli sayısal
+// ifadeler katlanır. Çalışma zamanı semantiği ve hata mesajları Interpreter'ın yardımcılarından
+// (binaryOp, callValue, ...) gelir, bu yüzden ağaç yürütücüsüyle aynıdır. Düz karşılığı
+// olmayan düğümler (fun, class, import, match, super) ağaç yürütücüsüne devredilir.
+class ClosureCompiler : public ExprVisitor<CompiledExpr>, public StmtVisitor<CompiledStmt> {
+public:
+    static std::shared_ptr<const CompiledBlock> compile(const std::vector<StmtPtr>& statements);
+
+    // --- ExprVisitor ---
+    CompiledExpr visitAssignExpr(std::shared_ptr<AssignExpr> expr) override;
+    CompiledExpr visitBinaryExpr(std::shared_ptr<BinaryExpr> expr) override;
+    CompiledExpr visitCallExpr(std::shared_ptr<CallExpr> expr) override;
+    CompiledExpr visitGetExpr(std::shared_ptr<GetExpr> expr) override;
+    CompiledExpr visitGroupingExpr(std::shared_ptr<GroupingExpr> expr) override;
+    CompiledExpr visitIndexExpr(std::shared_ptr<IndexExpr> expr) override;
+    CompiledExpr visitLiteralExpr(std::shared_ptr<LiteralExpr> expr) override;
+    CompiledExpr visitLogicalExpr(std::shared_ptr<LogicalExpr> expr) override;
+    CompiledExpr visitSetExpr(std::shared_ptr<SetExpr> expr) override;
+    CompiledExpr visitSuperExpr(std::shared_ptr<SuperExpr> expr) override;
+    CompiledExpr visitThisExpr(std::shared_ptr<ThisExpr> expr) override;
+    CompiledExpr visitUnaryExpr(std::shared_ptr<UnaryExpr> expr) override;
+    CompiledExpr visitVariableExpr(std::shared_ptr<VariableExpr> expr) override;
+    CompiledExpr visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> expr) override;
+
+    // --- StmtVisitor ---
+    CompiledStmt visitBlockStmt(std::shared_ptr<BlockStmt> stmt) override;
+    CompiledStmt visitClassStmt(std::shared_ptr<ClassStmt> stmt) override;
+    CompiledStmt visitExprStmt(std::shared_ptr<ExprStmt> stmt) override;
+    CompiledStmt visitFunStmt(std::shared_ptr<FunStmt> stmt) override;
+    CompiledStmt visitIfStmt(std::shared_ptr<IfStmt> stmt) override;
+    CompiledStmt visitImportStmt(std::shared_ptr<ImportStmt> stmt) override;
+    CompiledStmt visitReturnStmt(std::shared_ptr<ReturnStmt> stmt) override;
+    CompiledStmt visitVarStmt(std::shared_ptr<VarStmt> stmt) override;
+    CompiledStmt visitWhileStmt(std::shared_ptr<WhileStmt> stmt) override;
+    CompiledStmt visitMatchStmt(std::shared_ptr<MatchStmt> stmt) override;
+
+private:
+    CompiledExpr expr(const ExprPtr& node);
+    CompiledStmt stmt(const StmtPtr& node);
+    std::shared_ptr<const CompiledBlock> block(const std::vector<StmtPtr>& statements);
+    CompiledStmt tree(StmtPtr node); // Ağaç yürütücüsüne devret
+
+    // İki sayı işlenenli operatörler için kapanış (sabit işlenenin denetimi derlemede yapılır)
+    template <typename Op>
+    static CompiledExpr numericBinary(CompiledExpr left, CompiledExpr right, const Value* leftConst,
+                                      const Value* rightConst, SourceLoc loc, Op op);
+
+    // Derleme zamanında değeri bilinen ifadeler (literal'ler ve katlanmış işlemler)
+    std::unordered_map<const Expr*, Value> constants;
+    const Value* constantOf(const ExprPtr& node) const;
+    CompiledExpr constant(const ExprPtr& node, Value value);
+};
+
+#endif // C_CUBE_CLOSURE_COMPILER_H
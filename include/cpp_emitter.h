@@ -0,0 +1,95 @@
+#ifndef C_CUBE_CPP_EMITTER_H
+#define C_CUBE_CPP_EMITTER_H
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ast.h" // Çevrilen düğümler ve Visitor arayüzleri
+
+// c-cube --emit-cpp: bir modülün AST'sini, aot_runtime.h'deki çalışma zamanı arayüzüne karşı yazılmış
+// C++ kaynağına çevirir. Üretilen dosya ana programla birlikte derlendiğinde modül, import adıyla
+// ModuleLoader'a kaydolur ve dosyası aranmadan bu koddan yüklenir.
+//
+// Her fonksiyon ve metot gövdesi ayrı bir C++ fonksiyonuna, üst düzey bildirimler modül gövdesi
+// fonksiyonuna dönüşür. İfadeler, değerlendirme sırası korunsun diye her ara sonucu bir geçici
+// değişkene yazan düz koda çevrilir; and/or ve if/while C++ denetim akışı olur. Sınıf, import ve
+// super tanımları küçük AST düğümleri olarak kurulup yorumlayıcıya yürütülür (bkz. AotRuntime).
+//
+// Fonksiyon gövdeleri çözümlenmiş olmalıdır (--eager-parse ile parse edilmiş AST).
+class CppEmitter : public ExprVisitor<std::string>, public StmtVisitor<void> {
+public:
+    // moduleName import adıdır (örn. "game.utils"); sourcePath yalnızca başlık yorumunda kullanılır
+    static std::string emit(const std::vector<StmtPtr>& program, const std::string& moduleName,
+                            const std::string& sourcePath);
+
+    // --- ExprVisitor: kodu yazar, sonucu tutan C++ ifadesini (geçici değişken ya da sabit) döndürür ---
+    std::string visitAssignExpr(std::shared_ptr<AssignExpr> expr) override;
+    std::string visitBinaryExpr(std::shared_ptr<BinaryExpr> expr) override;
+    std::string visitCallExpr(std::shared_ptr<CallExpr> expr) override;
+    std::string visitGetExpr(std::shared_ptr<GetExpr> expr) override;
+    std::string visitGroupingExpr(std::shared_ptr<GroupingExpr> expr) override;
+    std::string visitIndexExpr(std::shared_ptr<IndexExpr> expr) override;
+    std::string visitLiteralExpr(std::shared_ptr<LiteralExpr> expr) override;
+    std::string visitLogicalExpr(std::shared_ptr<LogicalExpr> expr) override;
+    std::string visitSetExpr(std::shared_ptr<SetExpr> expr) override;
+    std::string visitSuperExpr(std::shared_ptr<SuperExpr> expr) override;
+    std::string visitThisExpr(std::shared_ptr<ThisExpr> expr) override;
+    std::string visitUnaryExpr(std::shared_ptr<UnaryExpr> expr) override;
+    std::string visitVariableExpr(std::shared_ptr<VariableExpr> expr) override;
+    std::string visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> expr) override;
+
+    // --- StmtVisitor ---
+    void visitBlockStmt(std::shared_ptr<BlockStmt> stmt) override;
+    void visitClassStmt(std::shared_ptr<ClassStmt> stmt) override;
+    void visitExprStmt(std::shared_ptr<ExprStmt> stmt) override;
+    void visitFunStmt(std::shared_ptr<FunStmt> stmt) override;
+    void visitIfStmt(std::shared_ptr<IfStmt> stmt) override;
+    void visitImportStmt(std::shared_ptr<ImportStmt> stmt) override;
+    void visitReturnStmt(std::shared_ptr<ReturnStmt> stmt) override;
+    void visitVarStmt(std::shared_ptr<VarStmt> stmt) override;
+    void visitWhileStmt(std::shared_ptr<WhileStmt> stmt) override;
+    void visitMatchStmt(std::shared_ptr<MatchStmt> stmt) override;
+
+private:
+    // Yazılmakta olan C++ fonksiyonu (iç içe fonksiyonlar için yığın olarak tutulur)
+    struct Function {
+        std::string signature;
+        std::ostringstream code;
+        int indent = 1;
+        int temps = 0;
+        bool returnsValue = true; // false: modül gövdesi, return ReturnException fırlatır
+    };
+
+    std::vector<std::unique_ptr<Function>> functions; // Yazılmakta olanlar (en içteki sonda)
+    std::vector<std::string> finished;                // Tamamlanan tanımlar, bitiş sırasıyla
+    std::unordered_map<std::string, std::string> constants; // Metin -> C++ sabitinin adı
+    std::vector<std::string> constantDefinitions;
+    int functionCount = 0;
+    int descriptorCount = 0;
+
+    std::string expr(const ExprPtr& node);
+    void stmt(const StmtPtr& node);
+    void statements(const std::vector<StmtPtr>& body); // Yeni kapsam açmadan
+    void scopedBody(const StmtPtr& node);              // if/while gövdesi: blok ise kapsamı bu süslü parantez açar
+    std::string function(const std::string& comment, const std::vector<StmtPtr>& body); // C++ fonksiyon adını döndürür
+    std::string functionDescriptor(const FunStmt& declaration); // Gövdeyi yazar, AotRuntime::function(...) döndürür
+
+    void line(const std::string& text);
+    void open(const std::string& text);        // "text {" yazar, girintiyi artırır
+    void close(const std::string& text = "}"); // Girintiyi azaltır; text '{' ile bitiyorsa yeniden artırır
+    Function& current() { return *functions.back(); }
+    std::string temp();
+    void scope(); // Yeni ortam açan AotRuntime::Scope yazar
+    void root(const std::string& value); // Geçici değişkeni AotRuntime::Root ile kök yapar
+    std::string descriptor();
+    std::string name(Name name);                  // İsmin std::string sabiti
+    std::string constant(const std::string& text); // Metnin std::string sabiti (isimler ve string literal'leri)
+    static std::string at(SourceLoc loc);          // AotRuntime::at(satır)
+    static std::string quote(const std::string& text);
+    static std::string number(double value);
+};
+
+#endif // C_CUBE_CPP_EMITTER_H
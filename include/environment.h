@@ -9,18 +9,29 @@
 #include "token.h" // Token sınıfı için (hata raporlama ve isim almak için)
 #include "value.h" // Value sınıfı için (değişken değerleri - ObjPtr içerir)
 #include "error_reporter.h" // RuntimeException için (Environment hataları)
+#include "allocator.h"      // Değişken haritası host ayırıcısından ayrılır
+#include "source_location.h" // AST düğümlerinden gelen isimlerin konumu (hata raporlama için)
+
+class Gc; // Kare arenası yazma bariyeri için
 
 class Environment : public std::enable_shared_from_this<Environment> {
+public:
+    // Değişken haritası; düğümleri AllocCategory::Environment etiketiyle ayrılır
+    using ValueMap = std::unordered_map<std::string, Value, std::hash<std::string>, std::equal_to<std::string>,
+                                        StlAllocator<std::pair<const std::string, Value>>>;
+
 private:
     // Bu ortamın kapsadığı üst ortam. Global ortamın parent'ı nullptr'dır.
     std::shared_ptr<Environment> enclosing;
+    // Harita düğümlerinin ayrıldığı ayırıcı (iç ortamlar üst ortamınkini devralır)
+    Allocator* allocator;
     // Değişken isimlerini değerlere eşleştiren harita
-    std::unordered_map<std::string, Value> values;
+    ValueMap values;
 
 public:
     // Global ortam için constructor (parent'ı yok)
-    Environment();
-    // İç içe geçmiş ortamlar için constructor (bir parent'ı var)
+    Environment(Allocator& allocator = defaultAllocator());
+    // İç içe geçmiş ortamlar için constructor (bir parent'ı var, ayırıcısını devralır)
     Environment(std::shared_ptr<Environment> enclosing);
 
     // Yeni bir değişken tanımlar
@@ -29,10 +40,13 @@ public:
     // Mevcut bir değişkene değer atar
     // Atama işlemi, değişkeni mevcut ortamdan başlayarak üst ortamlarda arar.
     void assign(const Token& name, Value value);
+    // AST'den gelen interned isimler için: konum yalnızca hata durumunda satıra çözülür
+    void assign(const std::string& name, Value value, SourceLoc loc);
 
     // Bir değişkenin değerini döndürür
     // Değişkeni mevcut ortamdan başlayarak üst ortamlarda arar.
     Value get(const Token& name);
+    Value get(const std::string& name, SourceLoc loc);
 
     // Belirli bir uzaklıktaki ortamda değişkenin değerini döndürür
     // (Resolver entegre edildiğinde kullanılır)
@@ -50,11 +64,25 @@ public:
 
     // GC'nin bu ortamın içindeki ObjPtr'ları tarayabilmesi için
     // Haritanın değiştirilemez bir referansını döndürür.
-    const std::unordered_map<std::string, Value>& getValues() const { return values; }
+    const ValueMap& getValues() const { return values; }
+    ValueMap& getValuesMutable() { return values; } // GC string birleştirmesi için
+
+    Allocator& getAllocator() const { return *allocator; }
+
+    // Yazma bariyeri: kare arenası ya da boşta artımlı işaretleme sürerken nesne değeri yazılan
+    // ortamlar bu Gc'ye bildirilir (bkz. Gc::beginFrame, Gc::notifyIdle). Diğer zamanlarda nullptr'dır;
+    // aynı anda yalnızca bir Gc bariyeri açabilir.
+    static inline Gc* writeBarrier = nullptr;
 
 private:
+    // Yazılan değer nesneyse ortamı ve değeri writeBarrier'a bildirir
+    void noteStore(const Value& value);
+
     // Belirtilen uzaklıktaki ortamı bulmaya yardımcı metod
     std::shared_ptr<Environment> ancestor(int distance);
 };
 
+// Gc::rememberStore(env, value) (gc.cpp); ortamlar gc.h'yi içermeden bariyeri çağırabilsin diye
+void rememberEnvironmentStore(Gc& gc, const Environment* env, const Value& value);
+
 #endif // C_CUBE_ENVIRONMENT_H
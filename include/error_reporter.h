@@ -15,8 +15,12 @@ class ErrorReporter {
 private:
     bool hadErrorFlag = false;
     bool hadRuntimeErrorFlag = false;
+    bool silent = false; // true iken hatalar basılmaz, yalnızca bayraklar tutulur
 
 public:
+    // Ön parse gibi sonucu atılabilecek işlerde hataların iki kez basılmasını önler
+    void setSilent(bool value) { silent = value; }
+
     void error(int line, const std::string& message) {
         report(line, "", message);
         hadErrorFlag = true;
@@ -27,7 +31,7 @@ public:
         if (token.type == TokenType::END_OF_FILE) {
             report(token.line, " at end", message);
         } else {
-            report(token.line, " at '" + token.lexeme + "'", message);
+            report(token.line, " at '" + std::string(token.lexeme) + "'", message);
         }
         hadErrorFlag = true;
     }
@@ -57,6 +61,7 @@ public:
 
 private:
     void report(int line, const std::string& where, const std::string& message) {
+        if (silent) return;
         std::cerr << "[Satır " << line << "] Hata" << where << ": " << message << std::endl;
     }
 };
@@ -0,0 +1,80 @@
+#ifndef C_CUBE_FLAT_AST_H
+#define C_CUBE_FLAT_AST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ast.h"             // Düzleştirilen ağaç düğümleri
+#include "value.h"           // Sabitler
+#include "source_location.h" // SourceLoc
+
+// AST'nin düz (structure-of-arrays) kodlaması. Her düğüm bir indekstir; türü, işlenenleri ve
+// konumu paralel dizilerde tutulur. Çocuklar ebeveynlerinden önce eklenir, değişken uzunluklu
+// çocuk listeleri (blok bildirimleri, argümanlar, liste elemanları) `lists` dizisinde ardışık
+// durur. Düğümler ayrı ayrı ayrılmadığı ve işaretçi tutmadığı için dolaşma önbellek dostudur;
+// kopyalama ve serileştirme dizilerin kopyalanmasından ibarettir.
+//
+// Yorumlayıcı --exec=flat ile fonksiyon gövdelerini bu kodlamadan yürütür
+// (bkz. Interpreter::executeFlat). Düz karşılığı olmayan bildirimler (fun, class, import,
+// match) ve ifadeler (super) TREE_* düğümleriyle asıl ağaca devredilir.
+class FlatAst {
+public:
+    using Index = uint32_t;
+    static constexpr Index NONE = UINT32_MAX;
+
+    // a/b/c sütunlarının anlamı türe göre değişir:
+    enum class Kind : uint8_t {
+        // İfadeler
+        LITERAL,     // a: constants indeksi
+        VARIABLE,    // a: Name
+        ASSIGN,      // a: Name, b: değer
+        UNARY,       // a: TokenType, b: işlenen
+        BINARY,      // a: TokenType, b: sol, c: sağ
+        LOGICAL,     // a: TokenType, b: sol, c: sağ
+        CALL,        // a: çağrılan, b: lists başlangıcı, c: argüman sayısı
+        GET,         // a: obje, b: Name
+        SET,         // a: obje, b: Name, c: değer
+        INDEX,       // a: liste, b: dizin
+        LIST,        // b: lists başlangıcı, c: eleman sayısı
+        THIS,
+        TREE_EXPR,   // a: treeExprs indeksi
+        // Bildirimler
+        EXPR_STMT,   // a: ifade
+        VAR,         // a: Name, b: başlangıç değeri ya da NONE
+        BLOCK,       // b: lists başlangıcı, c: bildirim sayısı
+        IF,          // a: koşul, b: then, c: else ya da NONE
+        WHILE,       // a: koşul, b: gövde
+        RETURN,      // a: değer ya da NONE
+        TREE_STMT    // a: treeStmts indeksi
+    };
+
+    std::vector<Kind> kinds;
+    std::vector<Index> a;
+    std::vector<Index> b;
+    std::vector<Index> c;
+    std::vector<SourceLoc> locs;   // Hata raporlama için (konumu olmayan düğümlerde geçersiz)
+    std::vector<Index> lists;      // Çocuk listeleri
+    std::vector<Value> constants;  // Literal değerler
+    std::vector<ExprPtr> treeExprs;
+    std::vector<StmtPtr> treeStmts;
+
+    // Kök bildirim listesi: lists[rootBegin, rootBegin + rootCount)
+    Index rootBegin = 0;
+    Index rootCount = 0;
+
+    // Bildirim listesini düzleştirir (tembel fonksiyon gövdeleri TREE_STMT olarak kalır)
+    static FlatAst lower(const std::vector<StmtPtr>& statements);
+
+    size_t size() const { return kinds.size(); }
+
+    Index add(Kind kind, Index first = 0, Index second = 0, Index third = 0, SourceLoc loc = SourceLoc{}) {
+        kinds.push_back(kind);
+        a.push_back(first);
+        b.push_back(second);
+        c.push_back(third);
+        locs.push_back(loc);
+        return static_cast<Index>(kinds.size() - 1);
+    }
+};
+
+#endif // C_CUBE_FLAT_AST_H
@@ -4,8 +4,12 @@
 #include <vector>
 #include <memory>
 #include <unordered_set>
+#include <unordered_map>
 #include <map> // Nesilleri tutmak için
 #include <algorithm> // std::remove_if için
+#include <functional> // Heap doğrulayıcıdaki referans gezintisi için
+#include <cstdint>    // GcHandle için
+#include <chrono>     // Boşta zaman planlaması için
 
 #include "object.h"      // Temel obje sınıfı
 #include "function.h"    // CCubeFunction
@@ -13,7 +17,10 @@
 #include "instance.h"    // CCubeInstance
 #include "list.h"        // CCubeList
 #include "c_cube_module.h" // CCubeModule
+#include "weak_ref.h"      // CCubeWeakRef, CCubeWeakMap
 #include "value.h"       // Value (içinde ObjPtr var)
+#include "error_reporter.h" // RuntimeException (heap sınırı hatası için)
+#include "allocator.h"      // Host ayırıcısı (nesneler AllocCategory::Object ile ayrılır)
 
 // Nesnelerin hash'lenmesi için std::hash specialization'ı
 namespace std {
@@ -24,48 +31,200 @@ namespace std {
     };
 }
 
+// 32-bit nesne tutamacı. Bu bir tutamaç tablosudur, sıkıştırılmış heap referansı değildir:
+// nesneler ve aralarındaki referanslar (ObjPtr) değişmez; yalnızca native kod, shared_ptr
+// (64-bit'te 16 bayt) yerine yoğun tablolarında (örn. motorun varlık dizileri) bu 4 baytlık
+// tutamacı saklayıp Gc::resolveHandle ile çözebilir. Her çözüm bir tablo araması ve shared_ptr kopyasıdır.
+// Düşük 24 bit tutamaç tablosundaki yuva, yüksek 8 bit yuvanın yeniden kullanım etiketidir;
+// böylece ölmüş bir nesnenin tutamacı aynı yuvaya gelen yeni nesneye çözülmez. Etiket taşmadan
+// önce yuva emekliye ayrılır (bkz. Gc::releaseHandle), bu yüzden eski bir tutamaç hiçbir zaman
+// yanlış nesneye çözülmez.
+struct GcHandle {
+    static constexpr uint32_t INDEX_BITS = 24;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+    uint32_t bits = 0; // 0: null tutamaç (yuva 0 kullanılmaz)
+
+    uint32_t index() const { return bits & INDEX_MASK; }
+    uint8_t tag() const { return static_cast<uint8_t>(bits >> INDEX_BITS); }
+    bool isNull() const { return bits == 0; }
+    bool operator==(const GcHandle& other) const { return bits == other.bits; }
+    bool operator!=(const GcHandle& other) const { return bits != other.bits; }
+};
+
+// Sert heap sınırı aşıldığında (acil tam koleksiyondan sonra bile) fırlatılır.
+// RuntimeException'dan türediği için C-CUBE çalışma zamanı hatası olarak raporlanır;
+// script durur ama host süreç (ve diğer yorumlayıcılar) çalışmaya devam eder.
+class GcHeapLimitError : public RuntimeException {
+public:
+    size_t requestedBytes;
+    size_t limitBytes;
+
+    GcHeapLimitError(size_t requested, size_t limit)
+        : RuntimeException(Token(TokenType::IDENTIFIER, "gc", std::monostate{}, -1),
+                           "Heap sınırı aşıldı (" + std::to_string(requested) + " / " +
+                           std::to_string(limit) + " bayt)."),
+          requestedBytes(requested), limitBytes(limit) {}
+};
 
 class Gc {
+    // Host ayırıcısı. GC'nin kendi kapsayıcıları da bundan ayrıldığı için ilk üye olarak
+    // (kapsayıcılardan önce) ilklendirilmelidir.
+    Allocator& allocator;
+
 public:
+    // GC'nin kendi kayıtları için ayırıcı (AllocCategory::Collector)
+    template <typename T>
+    StlAllocator<T> collectorAllocator() const { return StlAllocator<T>(allocator, AllocCategory::Collector); }
+
+    template <typename T>
+    using GcVector = std::vector<T, StlAllocator<T>>;
+
     // GC tarafından yönetilen her nesne için metadata (yaş, nesil bilgisi)
     struct GcObjectMetadata {
         ObjPtr object;
-        int generation;  // 0: Young, 1: Old
+        int generation;  // 0: Young, 1: Old, 2: Frame (kare arenası, bkz. beginFrame)
         int age;         // Young Generation'da kaç koleksiyondan sağ çıktı
         bool marked;     // Mark aşamasında işaretlenmiş mi?
+        size_t size;     // Ayırma sırasında bytesAllocated'a eklenen boyut (sweep'te aynısı düşülür)
+        int pinCount;    // > 0 ise nesne kök sayılır, süpürülmez ve yerinden oynatılmaz
+        GcHandle handle; // Nesne tutamacı (handleOf çağrılana kadar null)
 
-        GcObjectMetadata(ObjPtr obj, int gen)
-            : object(obj), generation(gen), age(0), marked(false) {}
+        GcObjectMetadata(ObjPtr obj, int gen, size_t size = 0)
+            : object(obj), generation(gen), age(0), marked(false), size(size), pinCount(0) {}
     };
 
+    using ObjectSet = std::unordered_set<ObjPtr, std::hash<ObjPtr>, std::equal_to<ObjPtr>, StlAllocator<ObjPtr>>;
+    using MetadataMap = std::unordered_map<ObjPtr, GcObjectMetadata*, std::hash<ObjPtr>, std::equal_to<ObjPtr>,
+                                           StlAllocator<std::pair<const ObjPtr, GcObjectMetadata*>>>;
+
     // Global kökler: Interpreter'ın global ortamındaki değişkenler, vb.
     // Bunlar doğrudan Value olarak saklanabilir ve Value içinde ObjPtr varsa erişilebilir.
-    std::vector<Value*> roots;
+    GcVector<Value*> roots{collectorAllocator<Value*>()};
+
+    // Interpreter'ın ortam üyelerinin adresleri (globals ve mevcut ortam).
+    // Adres tutulduğu için Interpreter ortam değiştirdikçe GC her zaman güncel ortamı görür.
+    const std::shared_ptr<Environment>* interpreter_globals = nullptr;
+    const std::shared_ptr<Environment>* interpreter_environment = nullptr;
+
+    // Yürütme yığını kökleri (LIFO, GcStackRoot ile eklenip çıkarılır). Bir blok ya da çağrı
+    // sürerken çağıranın ortamı ve C++ yığınında tutulan geçici değerler (değerlendirilmiş
+    // callee/argümanlar, yarım kurulmuş liste elemanları) yalnızca burada görünür.
+    GcVector<const Environment*> environmentRoots{collectorAllocator<const Environment*>()};
+    GcVector<const Value*> temporaryRoots{collectorAllocator<const Value*>()};
+    GcVector<const std::vector<Value>*> temporaryVectorRoots{collectorAllocator<const std::vector<Value>*>()};
 
     // Nesiller için haritalar
-    std::unordered_set<ObjPtr> youngGeneration; // Gen0
-    std::unordered_set<ObjPtr> oldGeneration;   // Gen1
+    ObjectSet youngGeneration{collectorAllocator<ObjPtr>()}; // Gen0
+    ObjectSet oldGeneration{collectorAllocator<ObjPtr>()};   // Gen1
+    // Kare arenası: beginFrame/endFrame arasında ayrılan nesneler, ayırma sırasıyla.
+    // Normal koleksiyonlarda süpürülmez ve genç nesil kapasitesine sayılmaz.
+    GcVector<ObjPtr> frameObjects{collectorAllocator<ObjPtr>()}; // Gen2
 
     // Nesillerin meta verilerini tutan harita (ObjPtr'dan GcObjectMetadata'ya)
     // Bu, her ObjPtr için GC ile ilgili bilgilere hızlı erişim sağlar.
-    std::unordered_map<ObjPtr, GcObjectMetadata*> objectMetadata;
+    MetadataMap objectMetadata{collectorAllocator<std::pair<const ObjPtr, GcObjectMetadata*>>()};
 
     // Koleksiyon eşikleri
     size_t youngGenCapacity = 1024 * 10; // Genç nesil için ilk kapasite (byte cinsinden, veya obje sayısı)
                                        // Basitlik için obje sayısı veya rough size tutalım.
     size_t oldGenCapacity = 1024 * 100; // Yaşlı nesil için kapasite
     int youngGenCollections = 0;       // Genç nesil koleksiyon sayısı (terfi için)
-    const int PROMOTION_THRESHOLD = 3; // Genç nesilde bu kadar koleksiyondan sağ kalan terfi eder.
+    int promotionThreshold = 3;        // Genç nesilde bu kadar koleksiyondan sağ kalan terfi eder.
+    int fullCollectionInterval = 5;    // Bu kadar genç nesil koleksiyonundan sonra tam koleksiyon yapılır.
+    size_t fullCollections = 0;        // Yapılan tam koleksiyon sayısı (istatistik için)
+
+    // Kritik bölümler için otomatik koleksiyonları durdurma sayacı (iç içe pause/resume desteklenir)
+    int pauseDepth = 0;
+    // Duraklatılmışken kapasite aşıldıysa, resume() sonrasında bir genç nesil koleksiyonu yapılır
+    bool collectionPending = false;
+    // step() ile biriktirilen iş bütçesi (genç nesil nesne sayısı cinsinden)
+    size_t stepCredit = 0;
 
     // Genel boyut takibi (opsiyonel, hata ayıklama için)
     size_t bytesAllocated = 0;
 
+    // --- Stres ve doğrulama modu (--gc-stress / --gc-verify) ---
+    // stressInterval > 0 ise her N. ayırmada koleksiyon zorlanır.
+    size_t stressInterval = 0;
+    bool stressFullCollections = false; // true: tam koleksiyon, false: genç nesil koleksiyonu
+    size_t allocationCount = 0;         // Toplam ayırma sayısı
+    // true ise her koleksiyondan sonra heap doğrulayıcı çalışır
+    bool verifyHeap = false;
+    size_t verificationFailures = 0;
+
+    // --- Heap sınırları ---
+    // Sert sınır (0: sınırsız): aşılırsa acil tam koleksiyon yapılır, yetmezse GcHeapLimitError fırlatılır.
+    size_t maxHeapBytes = 0;
+    // Yumuşak sınır (0: kapalı): aşıldığında host geri çağrısı bir kez çağrılır.
+    // Kullanım sınırın altına düşene kadar tekrar çağrılmaz.
+    size_t softHeapLimitBytes = 0;
+    std::function<void(Gc&, size_t)> softLimitCallback;
+    bool softLimitNotified = false;
+    size_t emergencyCollections = 0; // Sert sınır nedeniyle yapılan acil koleksiyon sayısı
+
+    // --- Kare arenası ---
+    bool inFrame = false;
+    // Yazma bariyeri kayıtları: kare sürerken nesne değeri yazılan ortamlar ve heap nesneleri.
+    // endFrame kaçışı yalnızca bunlarda ve yığın köklerinde arar. Ortamlar zayıf tutulur (karede
+    // ölen çağrı ortamları atlanır); nesneler ham adresle tutulur ve endFrame'de izlenen nesneler
+    // arasında aranır.
+    std::unordered_map<const Environment*, std::weak_ptr<const Environment>, std::hash<const Environment*>,
+                       std::equal_to<const Environment*>,
+                       StlAllocator<std::pair<const Environment* const, std::weak_ptr<const Environment>>>>
+        frameEnvironmentStores{collectorAllocator<std::pair<const Environment* const, std::weak_ptr<const Environment>>>()};
+    std::unordered_set<const Object*, std::hash<const Object*>, std::equal_to<const Object*>, StlAllocator<const Object*>>
+        frameObjectStores{collectorAllocator<const Object*>()};
+    size_t lastFrameReclaimed = 0; // Son endFrame'de toplu olarak bırakılan nesne sayısı
+    size_t lastFramePromoted = 0;  // Son endFrame'de genç nesle terfi eden nesne sayısı
+
+    // --- Boşta zaman planlaması (notifyIdle) ---
+    double idleNurseryFraction = 0.25;    // Genç nesil bu oranda doluysa boşta küçük koleksiyon yapılır
+    double minorNsPerObject = 200.0;      // Maliyet tahminleri (ns / nesne), ölçümlerle güncellenir
+    double fullNsPerObject = 300.0;
+    size_t oldGenSizeAtLastFull = 0;      // Son tam koleksiyondan sonra yaşlı nesil boyutu
+    size_t idleMinorCollections = 0;
+    size_t idleFullCollections = 0;
+
+    // Boşta artımlı tam koleksiyon: deadline'a sığmayan tam koleksiyon işaretleme ve süpürme
+    // dilimlerine bölünür, kalan iş bir sonraki notifyIdle çağrısında sürer (bkz. advanceIdleCycle).
+    enum class IdlePhase { None, Mark, Sweep };
+    IdlePhase idlePhase = IdlePhase::None;
+    GcVector<ObjPtr> idleGrayObjects{collectorAllocator<ObjPtr>()}; // İşaretli, referansları henüz taranmamış
+    GcVector<ObjPtr> idleSweepQueue{collectorAllocator<ObjPtr>()};  // Döngü başındaki genç ve yaşlı nesneler
+    // Bu döngüde taranmış ortamlar (kapanış zincirleri globals'ta birleşir). Taramadan sonra
+    // yazılan değerleri bariyer gri yapar.
+    std::unordered_set<const Environment*, std::hash<const Environment*>, std::equal_to<const Environment*>,
+                       StlAllocator<const Environment*>>
+        idleScannedEnvironments{collectorAllocator<const Environment*>()};
+    size_t idleCheckInterval = 64;     // Deadline her bu kadar nesnede bir kontrol edilir
+    size_t idleCycleStartBytes = 0;    // Döngü başındaki bytesAllocated (heap kırpma için)
+    size_t idleSlices = 0;             // Artımlı tam koleksiyon için çalışılan boşta çağrı sayısı
+
+    // --- Heap kırpma (tam koleksiyonlardan sonra) ---
+    bool heapTrimEnabled = true;
+    size_t heapTrimRetainBytes = 4 * 1024 * 1024; // Süreçte tutulacak boş bellek hedefi
+    size_t heapTrims = 0;
+
+    // --- String birleştirme (tam koleksiyonlardan sonra) ---
+    bool stringInternEnabled = true;
+    size_t stringInternRuns = 0;
+    size_t lastStringInternShared = 0;     // Son geçişte ortak tampona bağlanan değer sayısı
+    size_t lastStringInternBytes = 0;      // Son geçişte serbest kalan tampon baytı
+    size_t stringInternReclaimedBytes = 0; // Eşit içerikler birleştirilerek geri kazanılan toplam bayt
+
 private:
     // Mark aşaması için yardımcı: Bir nesneyi ve referanslarını işaretler
     void markObject(ObjPtr obj);
     void markValue(const Value& val);
     void markContainer(const std::vector<Value>& container); // Listeler, objeler için
-    void markMap(const std::unordered_map<std::string, Value>& map); // Environment, Instance properties için
+    // Environment (Environment::ValueMap) ve Instance properties için
+    template <typename Map>
+    void markMap(const Map& map) {
+        for (const auto& pair : map) {
+            markValue(pair.second);
+        }
+    }
     void markMapObjects(const std::unordered_map<std::string, ObjPtr>& map); // Class methods için
 
     // Sweep aşaması için yardımcı: İşaretlenmemiş nesneleri toplar
@@ -75,10 +234,102 @@ private:
     // Nesneleri genç nesilden eski nesile terfi ettirir
     void promoteObjects();
 
+    // Zayıf referans desteği
+    // Nesne bu koleksiyondan sağ çıkacak mı? (işaretli, izlenmiyor, kare arenasında
+    // ya da genç nesil koleksiyonunda yaşlı nesilde)
+    bool survivesCollection(const ObjPtr& obj, bool full_collection);
+    // Ephemeron işaretleme: anahtarı canlı olan girdilerin değerlerini sabit noktaya kadar işaretler
+    void markEphemerons(bool full_collection);
+    // Hedefi ölen zayıf referansları ve anahtarı ölen tablo girdilerini temizler (sweep'ten önce).
+    // Ölüm kararı işarete dayanır; bu yüzden C++ yığınında bekleyen her değer (çağıranın ortamı,
+    // argümanlar, ara sonuçlar) GcStackRoot ile kök olmalıdır, aksi halde canlı hedefin referansı silinir.
+    void clearDeadWeakReferences(bool full_collection);
+
+    // Meta veri de host ayırıcısından (AllocCategory::Collector) ayrılır
+    GcObjectMetadata* newMetadata(ObjPtr obj, int generation, size_t size);
+    void deleteMetadata(GcObjectMetadata* metadata);
+
+    // Nesne tutamaç tablosu (GcHandle)
+    struct HandleSlot {
+        GcObjectMetadata* metadata = nullptr; // Boş yuvada nullptr
+        uint8_t tag = 0;                      // Yuva her boşaltıldığında artar
+    };
+    GcVector<HandleSlot> handleSlots = GcVector<HandleSlot>(1, HandleSlot{}, collectorAllocator<HandleSlot>()); // Yuva 0 null referans için ayrılmıştır
+    GcVector<uint32_t> freeHandleSlots{collectorAllocator<uint32_t>()};
+    size_t retiredHandleSlots = 0; // Etiketi tükendiği için bir daha kullanılmayacak yuvalar
+    // Metadata silinmeden önce çağrılır; nesnenin tutamacını geçersiz kılar
+    void releaseHandle(GcObjectMetadata* metadata);
+
+    // Koleksiyon süresini ölçüp nesne başına maliyet tahminini günceller (üstel hareketli ortalama)
+    void recordCollectionCost(bool full_collection, std::chrono::steady_clock::time_point start, size_t objects);
+    // Verilen koleksiyonun tahmini süresi (ns)
+    double estimateCollectionNs(bool full_collection) const;
+
+    // Tam koleksiyonda serbest kalan bellek kırpma eşiğini aşarsa GC'nin kendi
+    // kapsayıcılarını küçültür ve ayırıcıdan boş sayfaları işletim sistemine vermesini ister
+    void trimHeap(size_t freedBytes);
+
+    // Ortam zincirindeki (enclosing dahil) tüm değerleri işaretler
+    void markEnvironmentChain(const Environment* env);
+    // Kalıcı kökleri, sabitlenmiş nesneleri ve yürütme yığınını işaretler (kare arenası hariç)
+    void markRoots();
+    // endFrame: kaçan arena nesnelerini işaretler. Yalnızca arena nesnelerinin içine iner.
+    void markFrameEscapes();
+
+    // Kare ya da boşta işaretleme sürüyorsa Environment::writeBarrier'ı bu Gc'ye bağlar, değilse çözer
+    void updateWriteBarrier();
+
+    // Boşta artımlı tam koleksiyon adımları (bkz. notifyIdle)
+    void startIdleCycle();
+    // Döngüyü deadline'a kadar ilerletir; döngü bittiyse true döner
+    bool advanceIdleCycle(std::chrono::steady_clock::time_point deadline);
+    // İşaretlenmemiş nesneyi işaretler ve gri listeye ekler
+    void shadeIdle(const ObjPtr& obj);
+    void shadeIdle(const Value& value);
+    // Kökleri, kare arenasını ve sabitlenmiş nesneleri gri yapar
+    void shadeIdleRoots();
+    // Gri bir nesnenin referanslarını gri yapar
+    void scanIdleObject(const ObjPtr& obj);
+    // İşaretleme sonu (atomik): kök yeniden taraması, zayıf tablolar ve zayıf referanslar
+    void finishIdleMarking();
+    // Döngüde işaretlenmemiş kalan nesneyi süpürür
+    void sweepIdleObject(const ObjPtr& obj);
+    // Kalan süpürmeyi bitirir ve tam koleksiyon sonrası işleri yapar
+    void finishIdleCycle();
+
+    // Doğrulama modunda son sweep'te toplanan nesneler (sonradan hâlâ erişilebilir mi diye bakılır)
+    GcVector<std::weak_ptr<Object>> sweptObjects{collectorAllocator<std::weak_ptr<Object>>()};
+
+    // Bir nesnenin doğrudan referans verdiği nesneleri gezer (markObject'ten bağımsız, doğrulayıcı için)
+    void traceReferences(const ObjPtr& obj, const std::function<void(const ObjPtr&)>& visit) const;
+    // Köklerden erişilebilen tüm nesneleri toplar
+    std::unordered_set<Object*> collectReachable() const;
+
+    // Yeni oluşturulan bir nesneyi genç nesle kaydeder ve gerekirse koleksiyon tetikler.
+    // Tüm create* fabrika metodları bu ortak yolu kullanır.
+    ObjPtr trackObject(ObjPtr obj, size_t size);
+
+    // Sert heap sınırı: bytesAllocated + pendingBytes sınırı aşıyorsa acil tam koleksiyon yapar,
+    // yine sığmıyorsa GcHeapLimitError fırlatır. Yumuşak sınır bildirimi ayrıca yapılır.
+    void enforceHardLimit(size_t pendingBytes);
+    void notifySoftLimit();
+
+    // Büyüyebilen nesnelerin (liste, instance) büyüme bildirimini bu Gc'ye bağlar (nullptr ile koparır)
+    static void attachGrowthHook(const ObjPtr& obj, Gc* gc);
+
 public:
-    Gc();
+    explicit Gc(Allocator& allocator = defaultAllocator());
     ~Gc(); // Yıkıcıda tüm kalan nesneleri temizle
 
+    Allocator& getAllocator() const { return allocator; }
+
+    // C-CUBE nesnesini host ayırıcısından (AllocCategory::Object) oluşturur.
+    // Dönen nesne henüz izlenmez; createObject ile kaydedilmelidir.
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args) {
+        return allocateShared<T>(allocator, AllocCategory::Object, std::forward<Args>(args)...);
+    }
+
     // C-CUBE değerlerini Heap'te oluşturmak için genel fabrika metodları
     // Bu metodlar, oluşturulan nesnelerin genç nesle eklendiğinden emin olur.
     ObjPtr createObject(std::shared_ptr<CCubeFunction> func);
@@ -89,6 +340,8 @@ public:
 
     ObjPtr createString(const std::string& str); // Stringler için özel bir durum, genellikle ObjPtr içinde
     ObjPtr createList(const std::vector<Value>& elements); // Listeler için
+    ObjPtr createWeakRef(ObjPtr target); // Zayıf referanslar için
+    ObjPtr createWeakMap();              // Zayıf anahtarlı tablolar için
 
     // Kök ekleme ve çıkarma (Interpreter yığını, global değişkenler, vb.)
     void addRoot(Value* val);
@@ -99,6 +352,91 @@ public:
     // Manuel olarak çöp toplama tetikleme
     void collectGarbage(bool full_collection = false);
 
+    // Artımlı ilerleme: 'budget' kadar iş kredisi ekler. Biriken kredi genç neslin
+    // boyutunu karşıladığında bir genç nesil koleksiyonu yapılır ve true döner.
+    bool step(size_t budget);
+
+    // Kritik bölümler için otomatik koleksiyonları durdurur/yeniden başlatır.
+    // Açık collectGarbage() çağrıları duraklatmadan etkilenmez.
+    void pause();
+    void resume();
+    bool isPaused() const { return pauseDepth > 0; }
+
+    // Çalışma zamanında ayarlanabilir parametreler
+    void setNurserySize(size_t objectCount);
+    void setPromotionThreshold(int collections);
+
+    // Interpreter ortamlarını kök olarak bağlar (nullptr ile bağ koparılır)
+    void attachInterpreterRoots(const std::shared_ptr<Environment>* globals,
+                                const std::shared_ptr<Environment>* current);
+
+    // Tam koleksiyon sonrası kırpmada tutulacak boş bellek (0: tümünü geri ver)
+    void setHeapTrimRetention(size_t bytes) { heapTrimRetainBytes = bytes; }
+
+    // Boşta zaman ipucu: host, kare sonunda kalan süreyi bildirir. Tahmini süresi deadline'a
+    // sığan genç nesil koleksiyonu hemen yapılır. Vadesi gelmiş tam koleksiyon sığıyorsa tek
+    // seferde, sığmıyorsa artımlı yapılır: işaretleme ve süpürme deadline'a kadar ilerler ve bir
+    // sonraki çağrıda kaldığı yerden sürer. İşaretleme sürerken yazma bariyeri yeni referansları
+    // gri yapar; işaretleme sonu (kök yeniden taraması, zayıf tablolar) tek adımda yapılır.
+    // Arada ayırma nedeniyle başka bir koleksiyon gerekirse süpürme bitirilir, işaretleme bırakılır.
+    // İş yapıldıysa true döner. Duraklatılmışken hiçbir şey yapmaz.
+    bool notifyIdle(std::chrono::steady_clock::time_point deadline);
+
+    // Tutamaç tablosu: GC tarafından izlenen bir nesne için kalıcı 32-bit tutamaç
+    // döndürür (izlenmeyen nesneler ve tablo dolduğunda null). Nesne süpürüldüğünde tutamaç
+    // geçersizleşir ve resolveHandle nullptr döndürür. Tutamaç nesneyi canlı tutmaz.
+    GcHandle handleOf(const ObjPtr& obj);
+    ObjPtr resolveHandle(GcHandle handle) const;
+    size_t liveHandleCount() const { return handleSlots.size() - 1 - freeHandleSlots.size() - retiredHandleSlots; }
+
+    // Sabitleme: native kod bir nesneyi (ve listelerde eleman tamponunu) ödünç alırken
+    // nesnenin süpürülmemesini ve tamponun yer değiştirmemesini garanti eder.
+    // Çağrılar iç içe olabilir; her pin bir unpin ile eşleşmelidir. Tercihen PinGuard kullanın.
+    void pin(const ObjPtr& obj);
+    void unpin(const ObjPtr& obj);
+    bool isPinned(const ObjPtr& obj) const;
+    size_t pinnedObjectCount() const;
+
+    // Kare arenası modu (host kontrollü). beginFrame ile endFrame arasında ayrılan nesneler
+    // arenada tutulur ve kare ortasındaki koleksiyonlarda kök sayılır. endFrame heap'i taramaz:
+    // kaçış, kare boyunca yazma bariyerinin kaydettiği ortam ve nesnelerden ve yığın köklerinden
+    // yalnızca arena nesneleri izlenerek bulunur (maliyet kare boyutuyla orantılı). Kaçan arena
+    // nesneleri genç nesle terfi eder, gerisi toplu olarak bırakılır.
+    void beginFrame();
+    void endFrame();
+
+    // Yazma bariyeri (bkz. beginFrame, notifyIdle): bir ortama ya da izlenen bir heap nesnesine
+    // (liste, instance, zayıf tablo) nesne değeri yazılmadan önce çağrılır. Kare içinde yazılan yer
+    // kaydedilir, boşta işaretleme sürerken yazılan nesne gri yapılır; diğer zamanlarda bir şey yapmaz.
+    void rememberStore(const Environment* env, const Value& value);
+    void rememberStore(const Object* container, const Value& value) {
+        if (!std::holds_alternative<ObjPtr>(value)) return;
+        if (inFrame) frameObjectStores.insert(container);
+        if (idlePhase == IdlePhase::Mark) shadeIdle(value);
+    }
+
+    // Canlı liste, instance, zayıf tablo ve ortamlardaki eşit içerikli string'leri tek bir
+    // paylaşılan tampona bağlar. Tam koleksiyonlardan sonra otomatik çalışır.
+    void internStrings();
+
+    // İzlenen bir liste ya da instance'ın ayırmadan sonraki büyümesini (ya da küçülmesini) kaydeder:
+    // yeni elemanlar ve alanlar, tampon kapasitesi, saklanan string'lerin uzunluğu. Nesnenin kayıtlı
+    // boyutu ve bytesAllocated birlikte güncellenir. Büyüme sert sınırı aşarsa ayırmadaki gibi acil
+    // tam koleksiyon yapılır, yetmezse GcHeapLimitError fırlatılır (büyüme kayıtlı kalır).
+    void chargeGrowth(const Object* obj, std::ptrdiff_t delta);
+    // Bir değerin nesne dışında tuttuğu bayt (string içeriği); büyüme hesabında kullanılır
+    static size_t payloadBytes(const Value& value);
+
+    // Heap sınırlarını ayarlar (bayt cinsinden, 0 sınırı kapatır)
+    void setHeapLimits(size_t hardLimit, size_t softLimit = 0,
+                       std::function<void(Gc&, size_t)> onSoftLimit = nullptr);
+
+    // Stres modu: her 'everyNth' ayırmada genç (veya full=true ise tam) koleksiyon zorlar. 0 kapatır.
+    void setStressMode(size_t everyNth, bool full);
+    // Heap doğrulayıcı: köklerden erişilebilen her nesnenin izlendiğini ve işaretli olduğunu,
+    // süpürülen hiçbir nesneye hâlâ erişilemediğini kontrol eder. Hata sayısını döndürür.
+    size_t verify();
+
     // Debug amaçlı
     void printStats();
     size_t getTotalAllocatedBytes() const { return bytesAllocated; }
@@ -111,4 +449,68 @@ private:
     void resetMarks();
 };
 
+// RAII sabitleme: kapsam boyunca nesneyi sabitler
+class PinGuard {
+public:
+    PinGuard(Gc& gc, ObjPtr obj) : gc(gc), obj(std::move(obj)) { gc.pin(this->obj); }
+    ~PinGuard() { gc.unpin(obj); }
+
+    PinGuard(const PinGuard&) = delete;
+    PinGuard& operator=(const PinGuard&) = delete;
+
+    const ObjPtr& get() const { return obj; }
+
+private:
+    Gc& gc;
+    ObjPtr obj;
+};
+
+// RAII yığın kökü: kapsam boyunca bir ortamı (üst zinciriyle), bir değeri ya da bir değer
+// vektörünü kök yapar. Vektör adresiyle tutulduğu için kapsam içinde büyüyebilir.
+// Yalnızca kökten uzun yaşayan adlandırılmış yereller için kullanılmalıdır.
+class GcStackRoot {
+public:
+    GcStackRoot(Gc& gc, const Environment* environment) : gc(gc), kind(Kind::EnvironmentRoot) {
+        gc.environmentRoots.push_back(environment);
+    }
+    GcStackRoot(Gc& gc, const Value& value) : gc(gc), kind(Kind::ValueRoot) {
+        gc.temporaryRoots.push_back(&value);
+    }
+    GcStackRoot(Gc& gc, const std::vector<Value>& values) : gc(gc), kind(Kind::VectorRoot) {
+        gc.temporaryVectorRoots.push_back(&values);
+    }
+    ~GcStackRoot() {
+        switch (kind) {
+            case Kind::EnvironmentRoot: gc.environmentRoots.pop_back(); break;
+            case Kind::ValueRoot: gc.temporaryRoots.pop_back(); break;
+            case Kind::VectorRoot: gc.temporaryVectorRoots.pop_back(); break;
+        }
+    }
+
+    GcStackRoot(const GcStackRoot&) = delete;
+    GcStackRoot& operator=(const GcStackRoot&) = delete;
+
+private:
+    enum class Kind { EnvironmentRoot, ValueRoot, VectorRoot };
+    Gc& gc;
+    Kind kind;
+};
+
+// Bir listenin eleman tamponunu kopyalamadan native koda ödünç verir.
+// Ödünç süresince liste sabitlenir; tamponu büyütecek bir add() çağrısı hata fırlatır.
+// Elemanlar yerinde okunup yazılabilir (set_at tamponu taşımaz).
+class ListBorrow {
+public:
+    ListBorrow(Gc& gc, std::shared_ptr<CCubeList> list)
+        : guard(gc, std::static_pointer_cast<Object>(list)), list(std::move(list)) {}
+
+    Value* data() { return list->getElementsMutable().data(); }
+    const Value* data() const { return list->getElements().data(); }
+    size_t size() const { return list->size(); }
+
+private:
+    PinGuard guard;
+    std::shared_ptr<CCubeList> list;
+};
+
 #endif // C_CUBE_GC_H
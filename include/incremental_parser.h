@@ -0,0 +1,96 @@
+#ifndef C_CUBE_INCREMENTAL_PARSER_H
+#define C_CUBE_INCREMENTAL_PARSER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ast.h"            // StmtPtr
+#include "allocator.h"      // AST düğümleri host ayırıcısından ayrılır
+#include "error_reporter.h" // Tam parse'ta hatalar buraya raporlanır
+#include "source_location.h"
+
+// Eski metinde [start, oldEnd) aralığı yeni metinde [start, newEnd) aralığıyla değişti
+struct SourceEdit {
+    size_t start = 0;
+    size_t oldEnd = 0;
+    size_t newEnd = 0;
+};
+
+// REPL ve canlı düzenleme oturumları için artımlı parser. Bir dosyanın son parse edilmiş hâlini
+// üst düzey bildirimler ve kaynak aralıklarıyla tutar. Düzenlemede yalnızca değişen aralığa
+// dokunan bildirimler yeniden taranır ve parse edilir; önceki ve sonraki bildirimlerin
+// alt ağaçları olduğu gibi yeniden kullanılır.
+//
+// Yeniden parse edilen parça yeni bir kaynak tamponu olarak saklanır; eski düğümler eski
+// tamponlara bakmaya devam eder (SourceMap::shiftLines satır numaralarını günceller). Bir parçadan
+// üretilen üst düzey bildirimlerin hepsi bırakıldığında (ne parser'da ne yorumlayıcıda sahibi
+// kaldığında) parça ve SourceMap kaydı serbest bırakılır. Fonksiyon gövdeleri bu yüzden her zaman
+// hemen parse edilir: tembel gövde serbest kalan parçaya bakardı. Parça
+// kendi başına parse edilemiyorsa (örn. düzenleme bir '}' sildi) tüm dosya baştan parse edilir
+// ve hatalar reporter'a her zamanki gibi raporlanır.
+//
+// Değişen bildirimler changedStatements() ile alınır ve çalışan yorumlayıcıda yürütülerek
+// fonksiyon/sınıf tanımları yerinde değiştirilir (bkz. main.cpp'deki REPL oturumu).
+class IncrementalParser {
+public:
+    explicit IncrementalParser(ErrorReporter& reporter, Allocator& allocator = defaultAllocator());
+    ~IncrementalParser(); // Kalan parçaların SourceMap kayıtlarını siler
+    IncrementalParser(const IncrementalParser&) = delete;
+    IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+    // Kaynağı baştan parse eder
+    const std::vector<StmtPtr>& parse(std::string source);
+    // Son parse edilen metne edit uygulanmış hâli olan source'u artımlı parse eder
+    const std::vector<StmtPtr>& reparse(std::string source, const SourceEdit& edit);
+    // Düzenleme aralığını eski ve yeni metnin ortak önek/sonekinden bulur
+    const std::vector<StmtPtr>& reparse(std::string source);
+
+    static SourceEdit diff(std::string_view oldText, std::string_view newText);
+
+    const std::vector<StmtPtr>& statements() const { return program; }
+    // Son parse'ta yeniden oluşturulan üst düzey bildirimler (kaynak sırasıyla); tam parse'ta hepsi
+    const std::vector<StmtPtr>& changedStatements() const { return changed; }
+    // Son çağrı tüm dosyayı baştan parse ettiyse true
+    bool lastParseWasFull() const { return lastFull; }
+
+private:
+    struct Entry {
+        StmtPtr stmt;
+        size_t begin;      // Güncel metindeki aralık [begin, end)
+        size_t end;
+        size_t generation; // Düğümlerin baktığı tampon (chunks anahtarı)
+        SourceLoc loc;     // İlk token'ın konumu (satır kaydırma için)
+    };
+
+    // text'in [begin, end) aralığını yeni bir tampon olarak parse eder; hata yoksa
+    // bildirimleri out'a yazar
+    bool parseRange(size_t begin, size_t end, ErrorReporter& rangeReporter, std::vector<Entry>& out);
+    const std::vector<StmtPtr>& fullParse();
+    void publish();
+    // Bildirimlerinin hepsi bırakılmış parçaları ve SourceMap kayıtlarını serbest bırakır
+    void releaseChunks();
+
+    // AST'nin baktığı kaynak parçası. Düğümler yaşadıkça yaşamalı; sahiplik bildirimlerin
+    // zayıf referanslarıyla izlenir.
+    struct Chunk {
+        std::string text;
+        std::vector<std::weak_ptr<Stmt>> statements;
+    };
+
+    ErrorReporter& reporter;
+    Allocator& allocator;
+    bool lastFull = true;
+
+    std::string text;                // Son parse edilen tam metin
+    std::unordered_map<size_t, Chunk> chunks; // Nesil -> parça (düğüm adresleri sabit kalır)
+    size_t nextGeneration = 0;
+    std::vector<Entry> entries;      // Kaynak sırasıyla üst düzey bildirimler
+    std::vector<StmtPtr> program;
+    std::vector<StmtPtr> changed;
+};
+
+#endif // C_CUBE_INCREMENTAL_PARSER_H
@@ -7,23 +7,28 @@
 
 #include "object.h" // Temel Object sınıfı
 #include "value.h"  // Instance özelliklerinin değerleri için Value
+#include "source_location.h" // Hata konumu için
 
 // İleri bildirimler
 class CCubeClass; // Sınıfı temsil eden CCubeClass'a referans için
 class Interpreter; // Metot çağrıları için
+class Gc;          // Büyüme bildirimi için
 
 class CCubeInstance : public Object, public std::enable_shared_from_this<CCubeInstance> {
 private:
     std::shared_ptr<CCubeClass> klass; // Bu instance'ın ait olduğu sınıf
     std::unordered_map<std::string, Value> properties; // Instance'a özgü özellikler
+    Gc* heap = nullptr; // Yeni alanlar ve değer büyümesi bu Gc'ye bildirilir (heap sınırı için)
 
 public:
     CCubeInstance(std::shared_ptr<CCubeClass> klass);
 
     // Bir özelliğin değerini alır
     Value get(const Token& name);
+    Value get(const std::string& name, SourceLoc loc);
     // Bir özelliğe değer atar
     void set(const Token& name, Value value);
+    void set(const std::string& name, Value value);
 
     // Object arayüzünden
     virtual ObjectType getType() const override { return ObjectType::INSTANCE; }
@@ -33,6 +38,10 @@ public:
     // GC'nin sınıfına ve özelliklerine erişebilmesi için
     std::shared_ptr<CCubeClass> get_class() const { return klass; }
     const std::unordered_map<std::string, Value>& getProperties() const { return properties; }
+    std::unordered_map<std::string, Value>& getPropertiesMutable() { return properties; } // GC string birleştirmesi için
+
+    // Gc::trackObject bağlar, nesne izlenmeyi bırakınca koparılır
+    void setHeap(Gc* gc) { heap = gc; }
 };
 
 #endif // C_CUBE_INSTANCE_H
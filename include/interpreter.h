@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 #include <stdexcept>
+#include <unordered_map>
 
 // Proje bağımlılıkları
 #include "ast.h"            // AST düğümleri ve Visitor arayüzleri
@@ -22,6 +23,11 @@
 #include "module_loader.h"  // Modül yükleme mekanizması
 #include "utils.h"          // Yardımcı fonksiyonlar (örn. valueToString)
 #include "gc.h"             // Çöp toplayıcı (YENİ EKLEME)
+#include "builtin_functions.h" // Yerleşik fonksiyonlar ve modüller (clock, gc)
+#include "flat_ast.h"       // --exec=flat için düz AST
+#include "closure_compiler.h" // --exec=closure için kapanış derleyicisi
+#include "jit.h"            // --jit için makine kodu derleyicisi
+#include "trace_jit.h"      // --trace-loops için döngü izleri
 
 
 // Fonksiyon dönüşlerini işlemek için özel exception
@@ -33,8 +39,24 @@
  class ReturnException : public std::runtime_error { /* ... */ };
 
 
+class AotFunction; // aot_runtime.h: C++'a önceden derlenmiş gövde
+
+// Fonksiyon gövdelerinin ve programın nasıl yürütüleceği
+enum class ExecMode {
+    Tree, // AST üzerinde visitor ile (varsayılan)
+    Flat,    // Düz (structure-of-arrays) AST üzerinde indeks dolaşarak (bkz. flat_ast.h)
+    Closure  // AST'den bir kez derlenen C++ kapanış ağacıyla (bkz. closure_compiler.h)
+};
+
 class Interpreter : public ExprVisitor<Value>, public StmtVisitor<void> {
+    // Derlenmiş kapanışlar ortamlara ve işlem yardımcılarına doğrudan erişir
+    friend class ClosureCompiler;
+    // Önceden derlenmiş (--emit-cpp) modüllerin kodu da aynı yardımcıları kullanır
+    friend class AotRuntime;
+
 private:
+    // Ortamların ve nesnelerin ayrıldığı host ayırıcısı (ortamlardan önce kurulmalı)
+    Allocator& allocator;
     // Global ortam. Tüm programın genel değişkenlerini ve fonksiyonlarını tutar.
     std::shared_ptr<Environment> globals;
     // Mevcut yürütme ortamı. Fonksiyon çağrıları ve bloklar için değişir.
@@ -42,40 +64,77 @@ private:
     ErrorReporter& errorReporter;
     Gc& gc; // Çöp toplayıcıya referans (ZATEN VARDI)
     ModuleLoader& moduleLoader; // Modül yükleyiciye referans
+    ExecMode execMode = ExecMode::Tree;
+    uint32_t jitThreshold = 0; // Bu kadar çağrılan fonksiyon JIT ile derlenir (0: JIT kapalı)
+    uint32_t traceThreshold = 0; // Bu kadar yinelenen while döngüsünün izi kaydedilir (0: kapalı)
 
     // Resolver'ın ürettiği lokal değişken mesafeleri (eğer Resolver entegre edildiyse)
      std::unordered_map<const Expr*, int> locals;
 
-    // Interpreter'ın kendi yığınındaki geçici değerleri ve değişkenleri tutmak için
-    // Bu, GC'nin mark aşamasında taranması gereken ek köklerdir.
-    // Ancak bu, `Gc`'nin `Interpreter`'ı doğrudan sorgulamasını gerektirir,
-    // veya `Interpreter`'ın yığınındaki her şeyi `Gc`'ye bildirmesi gerekir ki bu da karmaşıktır.
-    // Şimdilik, `environment` ve `globals`'ı ana kökler olarak kabul edelim ve diğer geçici değerlerin
-    // kısa ömürlü olduğunu veya environment içinde bulunduğunu varsayalım.
-    // Gerçek bir üretim dilinde, burası daha karmaşık bir yığın tarama mekanizması gerektirebilir.
+    // GC kökleri: 'globals' ve 'environment' üyelerinin adresleri Gc'ye bağlıdır. C++ yığınında
+    // kalan çağıran ortamları (executeBlock ve benzerleri) ile değerlendirilmiş geçici değerler
+    // (callee, argümanlar, liste elemanları) kapsam boyunca GcStackRoot ile bildirilir.
 
     // Yardımcı metotlar
     Value evaluate(ExprPtr expr);
     void execute(StmtPtr stmt);
     bool isTruthy(const Value& value);
     bool isEqual(const Value& a, const Value& b);
-    void checkNumberOperand(const Token& op, const Value& operand);
-    void checkNumberOperands(const Token& op, const Value& left, const Value& right);
+    void checkNumberOperand(SourceLoc op, const Value& operand);
+    void checkNumberOperands(SourceLoc op, const Value& left, const Value& right);
+
+    // İşlem semantiği: ağaç ve düz yürütücüler aynı yardımcıları kullanır
+    Value unaryOp(TokenType op, SourceLoc loc, const Value& right);
+    Value binaryOp(TokenType op, SourceLoc loc, const Value& left, const Value& right);
+    Value callValue(const Value& callee, const std::vector<Value>& arguments, SourceLoc paren);
+    Value getProperty(const Value& object, const std::string& name, SourceLoc loc);
+    std::shared_ptr<CCubeInstance> instanceForSet(const Value& object, SourceLoc loc); // Değer hesaplanmadan önce denetlenir
+    Value indexValue(const Value& object, const Value& index, SourceLoc bracket);
+
+    // Düz AST yürütücüsü (interpreter_flat.cpp)
+    Value evaluateFlat(const FlatAst& flat, FlatAst::Index node);
+    void executeFlat(const FlatAst& flat, FlatAst::Index node);
+    void executeFlatBlock(const FlatAst& flat, FlatAst::Index begin, FlatAst::Index count,
+                          std::shared_ptr<Environment> newEnvironment);
+
+    // Kapanış arka ucu: derlenmiş bloğu yeni ortamda çalıştırır (executeBlock karşılığı)
+    void executeCompiledBlock(const CompiledBlock& block, std::shared_ptr<Environment> newEnvironment);
+
+    // İzleme JIT'i durumu, while düğümü başına (bkz. FunctionState)
+    struct LoopState {
+        std::weak_ptr<const WhileStmt> node;
+        uint32_t iterationCount = 0;             // Sıcaklık sayacı (eşikte durur)
+        std::shared_ptr<const LoopTrace> trace;  // Kaydedilmiş iz
+        uint8_t traceFailures = 0;               // Kaydedilemeyen ya da atılan iz sayısı
+        uint8_t unproductiveEntries = 0;         // Art arda hiç yineleme tamamlamadan çıkan iz girişleri
+    };
+    std::unordered_map<const WhileStmt*, LoopState> loopStates;
+    size_t loopStatesPruneAt = 64;
+    LoopState& loopState(const std::shared_ptr<WhileStmt>& loop);
+
+    // İzleme JIT'i: sıcak döngünün izini kaydeder ve yinelemeleri iz üzerinden yürütür
+    void runTracedLoop(WhileStmt& loop, LoopState& state);
 
     // Çalışma zamanı hatası fırlatır
     RuntimeException runtimeError(const Token& token, const std::string& message);
+    RuntimeException runtimeError(SourceLoc loc, const std::string& message); // Satır yalnızca burada çözülür
 
     // Ortam yönetimi için özel metotlar
+    std::shared_ptr<Environment> newEnvironment(std::shared_ptr<Environment> enclosing);
     void executeBlock(const std::vector<StmtPtr>& statements, std::shared_ptr<Environment> newEnvironment);
 
     // Değişken çözümlemesi (Şimdilik doğrudan ortamda arama yapar, Resolver yoksa)
     Value lookUpVariable(const Token& name);
+    Value lookUpVariable(const std::string& name, SourceLoc loc); // AST'den gelen interned isimler için
     // Veya eğer Resolver varsa ve `locals` map'ini kullanıyorsa:
      Value lookUpVariable(const Token& name, ExprPtr expr); // Token'dan çözümlenen depth ile
 
 public:
     // Constructor
+    // Ayırıcı verilmezse Gc'nin ayırıcısı kullanılır
     Interpreter(ErrorReporter& reporter, Gc& gc_instance, ModuleLoader& loader);
+    Interpreter(ErrorReporter& reporter, Gc& gc_instance, ModuleLoader& loader, Allocator& allocator);
+    ~Interpreter(); // GC'deki kök bağlantısını koparır
 
     // Programı yorumlamaya başlar
     void interpret(const std::vector<StmtPtr>& statements);
@@ -85,13 +144,53 @@ public:
     // Daha iyisi, Interpreter'ın GC'ye köklerini bildirmesidir.
     std::shared_ptr<Environment> getGlobalsEnvironment() const { return globals; }
     std::shared_ptr<Environment> getCurrentEnvironment() const { return environment; }
+    // Ortamı geçici olarak değiştiren dış kod (modül yükleyici) yığın köklerini buraya bildirir
+    Gc& getGc() const { return gc; }
+
+    // Ön-parse edilmiş (tembel) bir fonksiyonun gövdesini ilk çağrıdan önce çözümler
+    void ensureFunctionBody(FunStmt& declaration);
+
+    void setExecMode(ExecMode mode) { execMode = mode; }
+    ExecMode getExecMode() const { return execMode; }
+    void setJitThreshold(uint32_t threshold) { jitThreshold = threshold; }
+    uint32_t getJitThreshold() const { return jitThreshold; }
+    void setTraceThreshold(uint32_t threshold) { traceThreshold = threshold; }
+    uint32_t getTraceThreshold() const { return traceThreshold; }
+
+    // Yürütme arka uçlarının fonksiyon başına durumu. AST yalnızca programı tanımlar ve yeniden
+    // yüklemede ya da birden fazla yorumlayıcı arasında paylaşılabilir; bu yüzden sayaçlar ve
+    // derlenmiş gövdeler yorumlayıcının düğüm adresine göre tutulan yan tablosundadır. node,
+    // serbest kalan bir düğümün adresini alan yeni düğümün eski durumu devralmasını önler.
+    struct FunctionState {
+        std::weak_ptr<const FunStmt> node;
+        std::shared_ptr<const FlatAst> flatBody;           // --exec=flat: gövdenin düz kodlaması, ilk çağrıda kurulur
+        std::shared_ptr<const CompiledBlock> compiledBody; // --exec=closure: derlenmiş gövde, ilk çağrıda kurulur
+        uint32_t callCount = 0;                 // JIT sıcaklık sayacı (eşikte durur, bkz. CCubeFunction::call)
+        std::shared_ptr<const JitCode> jitCode; // --jit: eşiği aşınca derlenen makine kodu
+        bool jitRejected = false;               // Gövde JIT alt kümesinin dışında; bir daha denenmez
+        std::shared_ptr<const AotFunction> aotBody; // --emit-cpp ile derlenmiş modüllerde gövde (body boştur)
+    };
+    // Düğümün durumu; ilk sorguda oluşturulur. Referans, düğüm yaşadıkça geçerlidir.
+    FunctionState& functionState(const std::shared_ptr<FunStmt>& declaration);
+
+    // Fonksiyonu makine koduyla çağırmayı dener (gerekirse önce derler). false dönerse gövde JIT alt
+    // kümesinin dışındadır ya da kod kurtarma ile çıkmıştır; çağrı yorumlayıcıyla yürütülmelidir.
+    bool callJitted(FunStmt& declaration, FunctionState& state, const std::vector<Value>& arguments, Value& result);
+
+    // Fonksiyon gövdesini verilen ortamda seçili yürütme biçimiyle çalıştırır
+    // (gerekirse önce gövdeyi çözümler ve düzleştirir)
+    void executeFunctionBody(FunStmt& declaration, FunctionState& state, std::shared_ptr<Environment> functionEnvironment);
+    // Önceden derlenmiş gövdeyi verilen ortamda çalıştırır ve dönüş değerini verir
+    Value executeAotBody(const AotFunction& body, std::shared_ptr<Environment> functionEnvironment);
 
 
     // --- ExprVisitor Metodları (ifadeleri değerlendirme) ---
+    Value visitAssignExpr(std::shared_ptr<AssignExpr> expr) override;
     Value visitBinaryExpr(std::shared_ptr<BinaryExpr> expr) override;
     Value visitCallExpr(std::shared_ptr<CallExpr> expr) override;
     Value visitGetExpr(std::shared_ptr<GetExpr> expr) override;
     Value visitGroupingExpr(std::shared_ptr<GroupingExpr> expr) override;
+    Value visitIndexExpr(std::shared_ptr<IndexExpr> expr) override;
     Value visitLiteralExpr(std::shared_ptr<LiteralExpr> expr) override;
     Value visitLogicalExpr(std::shared_ptr<LogicalExpr> expr) override;
     Value visitSetExpr(std::shared_ptr<SetExpr> expr) override;
@@ -114,6 +213,10 @@ public:
     void visitMatchStmt(std::shared_ptr<MatchStmt> stmt) override;
 
     void printValue(const Value& value);
+
+private:
+    std::unordered_map<const FunStmt*, FunctionState> functionStates; // Bkz. FunctionState
+    size_t functionStatesPruneAt = 64;
 };
 
 #endif // C_CUBE_INTERPRETER_H
@@ -0,0 +1,65 @@
+#ifndef C_CUBE_JIT_H
+#define C_CUBE_JIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ast.h"   // Derlenen FunStmt
+#include "value.h" // Argümanlar ve dönüş değeri
+
+// Kopyala-yamala (copy-and-patch) temel JIT'i. Sıcak bir fonksiyonun gövdesi, önceden
+// kodlanmış x86-64 makine kodu şablonlarının (stencil) art arda kopyalanıp boşluklarının
+// (sabitler, slot ofsetleri, atlama mesafeleri) yamalanmasıyla makine koduna çevrilir. Kod
+// mmap ile ayrılan belleğe yazılır, ardından mprotect ile çalıştırılabilir (ve salt okunur) yapılır.
+//
+// Desteklenen alt küme sayısal ve yan etkisizdir: parametreler ve yerel değişkenler (sayı ya da
+// bool), sayı/bool literal'leri, aritmetik, karşılaştırma, eşitlik, '-', '!', and/or, var, atama,
+// blok, if, while ve return. Gövde kendi slotları dışında hiçbir şeye dokunmadığı için makine kodu
+// her an kurtarma (bailout) ile çıkıp çağrıyı yorumlayıcıya bırakabilir; yorumlayıcı aynı çağrıyı
+// baştan yürütür. Sıfıra bölme bu yolla yorumlayıcının hata mesajını üretir. Alt küme dışında bir
+// düğüm içeren fonksiyonlar hiç derlenmez ve yorumlayıcıda kalır.
+//
+// Yalnızca Linux x86-64'te etkindir; diğer platformlarda JitCompiler::compile her zaman nullptr döner.
+class JitCode {
+public:
+    // Sonuç türü derleme zamanında bilinir; makine kodu sonucu double olarak yazar
+    enum class ReturnType : uint8_t { Number, Bool };
+
+    // Makine kodunun imzası: slots parametreleri ve yerelleri tutar, dönüş değeri *result'a yazılır.
+    // Dönüş kodu: BAILOUT, RETURNED_VALUE veya RETURNED_NONE.
+    using Entry = int (*)(double* slots, double* result);
+    static constexpr int BAILOUT = 0;
+    static constexpr int RETURNED_VALUE = 1;
+    static constexpr int RETURNED_NONE = 2;
+
+    JitCode(void* memory, size_t mappedSize, size_t codeSize, size_t paramCount, size_t slotCount,
+            ReturnType returnType);
+    ~JitCode();
+    JitCode(const JitCode&) = delete;
+    JitCode& operator=(const JitCode&) = delete;
+
+    // Argümanların hepsi sayıysa makine kodunu çalıştırır. false dönerse (argüman türü uymadı ya da
+    // kurtarma oldu) çağrı yorumlayıcıyla yürütülmelidir.
+    bool run(const std::vector<Value>& arguments, Value& result) const;
+
+    size_t getCodeSize() const { return codeSize; }
+
+private:
+    void* memory;
+    size_t mappedSize;
+    size_t codeSize;
+    size_t paramCount;
+    size_t slotCount;
+    ReturnType returnType;
+};
+
+class JitCompiler {
+public:
+    // Gövdesi çözümlenmiş (bkz. Interpreter::ensureFunctionBody) bir fonksiyonu, parametrelerini
+    // sayı varsayarak derler. Gövde alt küme dışındaysa nullptr döner.
+    static std::shared_ptr<const JitCode> compile(const FunStmt& declaration);
+};
+
+#endif // C_CUBE_JIT_H
@@ -8,16 +8,22 @@
 #include "object.h" // Temel Object sınıfı
 #include "value.h"  // Liste elemanlarının değerleri için Value
 
+class Gc;
+
 class CCubeList : public Object {
 private:
     std::vector<Value> elements;
+    size_t pinCount = 0; // > 0 iken eleman tamponu native kodla paylaşılıyor, yeniden ayrılamaz
+    Gc* heap = nullptr;  // Büyüme bu Gc'ye bildirilir (heap sınırı için); izlenmiyorsa nullptr
 
 public:
     CCubeList(const std::vector<Value>& initialElements);
 
     // Liste elemanlarına erişim
     const std::vector<Value>& getElements() const { return elements; }
-    std::vector<Value>& getElementsMutable() { return elements; } // Değiştirilebilir erişim için
+    // Değiştirilebilir erişim için. Tampon adresini saklayacak native kod listeyi
+    // Gc::pin ya da ListBorrow ile sabitlemelidir.
+    std::vector<Value>& getElementsMutable() { return elements; }
 
     // Object arayüzünden
     virtual ObjectType getType() const override { return ObjectType::LIST; }
@@ -29,6 +35,14 @@ public:
     Value get_at(size_t index) const;
     void set_at(size_t index, Value val);
     size_t size() const;
+
+    // Sabitleme (Gc::pin üzerinden çağrılır)
+    void pin() { pinCount++; }
+    void unpin() { if (pinCount > 0) pinCount--; }
+    bool isPinned() const { return pinCount > 0; }
+
+    // Gc::trackObject bağlar, nesne izlenmeyi bırakınca koparılır
+    void setHeap(Gc* gc) { heap = gc; }
 };
 
 #endif // C_CUBE_LIST_H
@@ -8,12 +8,15 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>          // std::shared_ptr, std::unique_ptr
 #include <functional>      // std::function
+#include <deque>           // Kaynak metinlerin adresleri sabit kalmalı
 
 // İleri bildirimler
 class Interpreter;
-class Lexer;
+class ErrorReporter;
+class Scanner;
 class Parser;
 
 // --- ModuleReader Arayüzü ---
@@ -31,9 +34,35 @@ public:
 };
 
 // --- C-CUBE Modül Okuyucusu (.cube) ---
-// .cube uzantılı dosyaları okur, lexer ve parser kullanarak AST'ye dönüştürür.
+// .cube uzantılı dosyaları okur, scanner ve parser kullanarak AST'ye dönüştürür.
 class CubeModuleReader : public ModuleReader {
+private:
+    // Yüklenen modüllerin kaynak metinleri (token lexeme'leri bu tamponlara bakar)
+    std::deque<std::string> retainedSources;
+    // ModuleLoader::preloadImports'un önceden parse ettiği modüller (dosya yolu -> AST).
+    // İlk import'ta tüketilir; hatalı modüller buraya girmez, import anında yeniden parse edilip
+    // hataları her zamanki gibi raporlanır.
+    std::unordered_map<std::string, std::vector<StmtPtr>> preparsed;
+    static inline bool lazyFunctionBodies = false;
+
 public:
+    ~CubeModuleReader() override; // Tutulan kaynakların sourceMap() kayıtlarını siler
+
+    // Kaynağı AST'ye çevirir; önce .ccbc önbelleğine bakar. Üye durumuna dokunmadığı için
+    // farklı iş parçacıklarından aynı anda çağrılabilir. Tarama/parse hatası varsa false döner.
+    static bool parseSource(const std::string& filePath, const std::string& source,
+                            ErrorReporter& reporter, std::vector<StmtPtr>& ast);
+
+    // Modül fonksiyon gövdeleri tembel parse edilsin mi (bkz. Parser::setLazyFunctionBodies).
+    // Başlangıçta, modüller yüklenmeden önce ayarlanır.
+    static void setLazyFunctionBodies(bool enabled) { lazyFunctionBodies = enabled; }
+
+    // Kaynak metin için adresi modül yaşadıkça sabit kalan bir tampon ayırır
+    std::string& retainSource() { return retainedSources.emplace_back(); }
+    void addPreparsed(const std::string& filePath, std::vector<StmtPtr> ast) {
+        preparsed[filePath] = std::move(ast);
+    }
+
     ModulePtr readModule(const std::string& filePath,
                          const std::string& moduleName,
                          Interpreter& interpreter) override;
@@ -82,6 +111,9 @@ public:
 };
 
 
+// c-cube --emit-cpp ile C++'a derlenmiş modülün gövdesi (bkz. aot_runtime.h)
+using PrecompiledModule = void (*)(Interpreter&);
+
 // --- ModuleLoader: Çekirdek Yükleyici ---
 class ModuleLoader {
 private:
@@ -94,6 +126,9 @@ private:
     // Uzantıdan ModuleReader'a eşleme
     std::unordered_map<std::string, std::unique_ptr<ModuleReader>> readers;
 
+    // preloadImports'un daha önce ele aldığı modül dosyaları (aynı modül iki kez parse edilmesin)
+    std::unordered_set<std::string> preloadedFiles;
+
     // Yardımcı fonksiyon: Dosya yolunu uzantısına göre parçalar
     std::string getFileExtension(const std::string& filePath) const;
 
@@ -111,8 +146,18 @@ public:
     // `modulePath` "game.utils" gibi noktalı veya doğrudan "shader.glsl" gibi olabilir.
     ModulePtr loadModule(const std::string& modulePath);
 
+    // Programın import grafiğini geçişli olarak çıkarır ve bulunan .cube modüllerini yürütme
+    // başlamadan önce iş parçacıklarında tarar ve parse eder. Modüller yine import edildikleri
+    // anda ve aynı sırada çalıştırılır; burada yalnızca AST'leri hazırlanır. Tembel fonksiyon
+    // gövdelerindeki import'lar görülmez, onlar ilk çağrıda eskisi gibi sırayla yüklenir.
+    void preloadImports(const std::vector<StmtPtr>& program);
+
     // Dışarıdan yeni bir ModuleReader eklemek için (eğer dinamik uzantı eklemek istenirse)
     void registerModuleReader(const std::string& extension, std::unique_ptr<ModuleReader> reader);
+
+    // Programa derlenmiş bir modülü import adıyla kaydeder. Kayıt statik ilklendirme sırasında
+    // (main'den önce) yapılır; bu modüller arama yollarındaki dosyalardan önce çözümlenir.
+    static void registerPrecompiled(const std::string& modulePath, PrecompiledModule body);
 };
 
 #endif // C_CUBE_MODULE_LOADER_H
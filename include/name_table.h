@@ -0,0 +1,45 @@
+#ifndef C_CUBE_NAME_TABLE_H
+#define C_CUBE_NAME_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Interned tanımlayıcı. AST düğümleri ismin kopyası yerine bu 32 bitlik kimliği tutar;
+// aynı isim programın her yerinde aynı kimliği alır.
+using Name = uint32_t;
+
+// intern() iş parçacığı güvenlidir (modüller paralel parse edilir). spelling() yorumlayıcının
+// sıcak yolunda olduğundan kilit almaz: yazımlar sabit boyutlu bloklarda tutulur, bir blok
+// yayımlandıktan sonra hiç taşınmaz.
+class NameTable {
+public:
+    ~NameTable();
+
+    Name intern(std::string_view text);
+    // Dönen referans tablo yaşadıkça geçerlidir
+    const std::string& spelling(Name name) const {
+        return chunks[name >> CHUNK_BITS].load(std::memory_order_acquire)[name & (CHUNK_SIZE - 1)];
+    }
+    size_t size() const { return count.load(std::memory_order_acquire); }
+
+private:
+    static constexpr uint32_t CHUNK_BITS = 10;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static constexpr uint32_t MAX_CHUNKS = 4096; // En fazla 4M farklı isim
+
+    std::array<std::atomic<std::string*>, MAX_CHUNKS> chunks{};
+    std::atomic<uint32_t> count{0};
+    std::mutex mutex; // intern() ve ids için
+    std::unordered_map<std::string_view, Name> ids; // Anahtarlar bloklardaki string'lere bakar
+};
+
+// Süreç genelindeki isim tablosu
+NameTable& names();
+
+#endif // C_CUBE_NAME_TABLE_H
@@ -19,6 +19,9 @@ public:
         LIST,
         C_CUBE_MODULE,
         BOUND_METHOD,
+        NATIVE_FUNCTION, // C++ tarafında tanımlanan yerleşik fonksiyonlar (örn. gc modülü)
+        WEAK_REF,        // Hedefini canlı tutmayan referans
+        WEAK_MAP,        // Zayıf anahtarlı tablo (ephemeron)
         // Diğer obje tipleri buraya eklenebilir (örn. DICTIONARY, TUPLE vb.)
     };
 
@@ -38,7 +41,8 @@ public:
     bool isCallable() const {
         return getType() == ObjectType::FUNCTION ||
                getType() == ObjectType::CLASS ||
-               getType() == ObjectType::BOUND_METHOD;
+               getType() == ObjectType::BOUND_METHOD ||
+               getType() == ObjectType::NATIVE_FUNCTION;
     }
 };
 
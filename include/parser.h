@@ -4,19 +4,45 @@
 #include <vector>
 #include <string>
 #include <memory> // std::shared_ptr için
+#include <initializer_list> // match() için
+#include <cstdint>
 
 #include "token.h"        // Token sınıfı için
 #include "ast.h"          // AST düğümleri (Stmt, Expr) için
 #include "error_reporter.h" // Hata raporlama için
+#include "allocator.h"      // AST düğümleri host ayırıcısından ayrılır
+#include "token_source.h"   // Token'lar akıştan isteğe bağlı çekilir
 
 // İleri bildirimler (gerekirse)
  class Interpreter; // Parser, Interpreter'ı doğrudan kullanmaz
 
 class Parser {
 private:
-    const std::vector<Token>& tokens; // Lexer'dan gelen token'ların listesi
+    std::unique_ptr<VectorTokenSource> ownedSource; // Vector constructor'ı için (source'tan önce kurulmalı)
+    TokenSource& source;             // Token akışı (örn. Scanner)
     ErrorReporter& errorReporter;    // Hata raporlama sistemi
-    int current = 0;                 // Mevcut token'ın indeksi
+    Allocator& allocator;            // AST düğümleri için (AllocCategory::Ast)
+    bool lazyFunctionBodies = false; // true ise fonksiyon gövdeleri ön-parse edilir (bkz. skipFunctionBody)
+
+    // Küçük ileri okuma halkası: önceki token ve ileri okunan token'lar burada tutulur,
+    // böylece tüm token listesi hiçbir zaman bellekte bulunmaz. Dolum peek() içinde
+    // tembel yapıldığından mutable.
+    static constexpr size_t LOOKAHEAD_SLOTS = 4;
+    mutable std::vector<Token> ring;
+    mutable size_t head = 0;     // Sıradaki (henüz tüketilmemiş) token'ın yuvası
+    mutable size_t buffered = 0; // Halkada bekleyen ileri okunmuş token sayısı
+    void fill(size_t count) const; // En az count token ileri okunmuş olsun
+
+    // AST düğümü oluşturur (std::make_shared yerine; ayırma host ayırıcısından geçer)
+    template <typename T, typename... Args>
+    std::shared_ptr<T> node(Args&&... args) {
+        return allocateShared<T>(allocator, AllocCategory::Ast, std::forward<Args>(args)...);
+    }
+
+    // Token'ın düğümlerde saklanan sıkıştırılmış karşılıkları
+    static SourceLoc locate(const Token& token) { return sourceMap().locate(token); }
+    static Name intern(const Token& token) { return names().intern(token.lexeme); }
+    static std::vector<Name> internAll(const std::vector<Token>& tokens);
 
     // Hata kurtarma için özel exception
     struct ParseError : public std::runtime_error {
@@ -25,13 +51,14 @@ private:
 
     // Yardımcı Metodlar
     bool isAtEnd() const;          // Token akışının sonuna ulaşıldı mı?
-    Token advance();               // Sonraki token'ı tüketir ve döndürür
-    Token peek() const;            // Mevcut token'ı tüketmeden döndürür
-    Token previous() const;        // Tüketilen son token'ı döndürür
+    // Dönen referanslar halkaya aittir; birkaç advance() sonrasında üzerine yazılır, saklanacaksa kopyalanmalı.
+    const Token& advance();        // Sonraki token'ı tüketir ve döndürür
+    const Token& peek() const;     // Mevcut token'ı tüketmeden döndürür
+    const Token& previous() const; // Tüketilen son token'ı döndürür
 
     bool check(TokenType type) const; // Mevcut token'ın belirtilen türde olup olmadığını kontrol eder
-    bool match(const std::vector<TokenType>& types); // Mevcut token'ın türü, verilen türlerden biriyle eşleşirse true döndürür ve ilerler
-    Token consume(TokenType type, const std::string& message); // Belirtilen token türünü tüketir, aksi takdirde hata verir
+    bool match(std::initializer_list<TokenType> types); // Mevcut token'ın türü, verilen türlerden biriyle eşleşirse true döndürür ve ilerler
+    const Token& consume(TokenType type, const std::string& message); // Belirtilen token türünü tüketir, aksi takdirde hata verir
 
     ParseError error(const Token& token, const std::string& message); // Hata raporlar ve ParseError fırlatır
     void synchronize();            // Hata kurtarma mekanizması: Bir sonraki geçerli ifade başlangıcına atlar
@@ -45,6 +72,8 @@ private:
     StmtPtr varDeclaration();         // 'var' bildirimi
     StmtPtr classDeclaration();       // 'class' bildirimi
     StmtPtr funDeclaration(const std::string& kind); // 'fun' (fonksiyon/metot) bildirimi
+    // Ön-parse: '{' tüketildikten sonra gövdeyi eşleşen '}'a kadar AST kurmadan atlar
+    StmtPtr skipFunctionBody(const Token& name, std::vector<Token> parameters, const std::string& kind);
     StmtPtr statement();              // Genel bildirim
     StmtPtr ifStatement();            // 'if' bildirimi
     StmtPtr whileStatement();         // 'while' bildirimi
@@ -54,18 +83,52 @@ private:
     StmtPtr blockStatement();         // Süslü parantez içindeki blok
     StmtPtr expressionStatement();    // Sadece bir ifade olan bildirim
 
-    // İfade (Expression) Parsing Metodları (öncelik sırasına göre)
+    // İfade (Expression) Parsing Metodları: tablo güdümlü Pratt parser.
+    // Her token türü için bir ParseRule vardır: ifade başında görülünce prefix, bir ifadeden
+    // sonra görülünce infix fonksiyonu çağrılır. Yeni bir operatör eklemek tabloya bir satır
+    // eklemekten ibarettir (bkz. parser.cpp, buildRules).
+    enum class Precedence : uint8_t {
+        NONE,
+        ASSIGNMENT, // =
+        OR,         // or
+        AND,        // and
+        EQUALITY,   // == !=
+        COMPARISON, // < > <= >=
+        TERM,       // + -
+        FACTOR,     // * /
+        UNARY,      // ! -
+        CALL,       // . () []
+        PRIMARY
+    };
+    // Kural fonksiyonları tüketilmiş token'ın kopyasını alır (halka yuvası sonraki advance()'larda ezilir)
+    using PrefixFn = ExprPtr (Parser::*)(const Token& token);
+    using InfixFn = ExprPtr (Parser::*)(ExprPtr left, const Token& op);
+    struct ParseRule {
+        PrefixFn prefix = nullptr;
+        InfixFn infix = nullptr;
+        Precedence precedence = Precedence::NONE; // Infix kullanımın bağlanma gücü
+    };
+    static const ParseRule& getRule(TokenType type);
+
     ExprPtr expression();
-    ExprPtr assignment();             // Atama
-    ExprPtr logicalOr();              // Mantıksal OR
-    ExprPtr logicalAnd();             // Mantıksal AND
-    ExprPtr equality();               // Eşitlik (==, !=)
-    ExprPtr comparison();             // Karşılaştırma (>, >=, <, <=)
-    ExprPtr addition();               // Toplama/Çıkarma (+, -)
-    ExprPtr multiplication();         // Çarpma/Bölme (*, /)
-    ExprPtr unary();                  // Tekli operatörler (!, -)
-    ExprPtr call();                   // Fonksiyon çağrısı, metot çağrısı, dizin erişimi
-    ExprPtr primary();                // Temel ifadeler (literaller, parantezli ifadeler, tanımlayıcılar)
+    ExprPtr parsePrecedence(Precedence precedence); // En az verilen öncelikte bir ifade çözümler
+
+    // Prefix kuralları
+    ExprPtr literal(const Token& token);      // false, true, none, sayı, string
+    ExprPtr variable(const Token& token);     // Tanımlayıcı
+    ExprPtr thisExpr(const Token& token);     // this
+    ExprPtr superExpr(const Token& token);    // super.method
+    ExprPtr grouping(const Token& token);     // ( ifade )
+    ExprPtr listLiteral(const Token& token);  // [ ifade, ... ]
+    ExprPtr unary(const Token& token);        // Tekli operatörler (!, -)
+
+    // Infix kuralları
+    ExprPtr binary(ExprPtr left, const Token& op);   // Aritmetik, karşılaştırma, eşitlik
+    ExprPtr logical(ExprPtr left, const Token& op);  // and, or (kısa devre)
+    ExprPtr assign(ExprPtr left, const Token& op);   // Atama (sağdan birleşimli)
+    ExprPtr call(ExprPtr left, const Token& op);     // Fonksiyon/metot çağrısı
+    ExprPtr dot(ExprPtr left, const Token& op);      // Property erişimi
+    ExprPtr index(ExprPtr left, const Token& op);    // Dizin erişimi
 
     // Match statement'ı için özel yardımcı metodlar
     std::vector<MatchCase> parseMatchCases();
@@ -73,10 +136,33 @@ private:
     ExprPtr parsePattern(); // Match ifadesindeki desenleri çözümle
 
 public:
-    Parser(const std::vector<Token>& tokens, ErrorReporter& reporter);
+    // Akış modu: token'lar parse sırasında kaynaktan çekilir (tarama ve parse iç içe ilerler)
+    Parser(TokenSource& source, ErrorReporter& reporter, Allocator& allocator = defaultAllocator());
+    // Önceden taranmış token listesiyle
+    Parser(const std::vector<Token>& tokens, ErrorReporter& reporter, Allocator& allocator = defaultAllocator());
 
     // Ana parsing metodu: Token listesini alır ve bir AST döndürür
     std::vector<StmtPtr> parse();
+
+    // Bir üst düzey bildirimin kaynak aralığı: ilk token'ın başından son token'ın sonuna kadar.
+    // İşaretçiler token lexeme'lerinin baktığı tampona aittir.
+    struct StatementSpan {
+        const char* begin;
+        const char* end;
+    };
+    // parse() ile aynı; ek olarak her bildirimin aralığını spans'e yazar (artımlı parse için).
+    // Hatalı bildirimler atlandığı için spans yalnızca dönen bildirimlere karşılık gelir.
+    std::vector<StmtPtr> parse(std::vector<StatementSpan>& spans);
+
+    // Açıksa fonksiyon/metot gövdeleri yalnızca taranır; AST ilk çağrıda parseLazyBody ile kurulur.
+    // Taramada yalnızca süslü parantezler eşlenir, bu yüzden hiç çağrılmayan bir gövdedeki
+    // sözdizimi hatası raporlanmaz. Varsayılan kapalıdır (çalıştırıcıda --lazy-parse ile açılır).
+    // Token lexeme'leri tek bir kaynak tamponuna bakmalıdır (Scanner ya da onun token listesi).
+    void setLazyFunctionBodies(bool enabled) { lazyFunctionBodies = enabled; }
+
+    // Tembel bir fonksiyonun gövdesini çözümler (zaten çözümlenmişse bir şey yapmaz).
+    // Gövdedeki sözdizimi hataları basılır ve RuntimeException fırlatılır.
+    static void parseLazyBody(FunStmt& function, Allocator& allocator);
 };
 
 #endif // C_CUBE_PARSER_H
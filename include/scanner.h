@@ -2,39 +2,52 @@
 #define C_CUBE_SCANNER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <stdexcept> // std::runtime_error için
 
 #include "token.h"          // Token sınıfı ve TokenType enum'ı için
 #include "error_reporter.h" // Hata raporlama için
+#include "token_source.h"   // Parser'a akış olarak token sağlamak için
 
-// Scanner sınıfı, kaynak kodu token'lara ayırır.
-class Scanner {
+// Scanner sınıfı, kaynak kodu token'lara ayırır. Tek tokenizer'dır (ana program ve modüller).
+// Token lexeme'leri kaynak tamponuna referans verir; source, token'lardan ve onlardan
+// üretilen AST'den uzun yaşamalıdır.
+class Scanner : public TokenSource {
 public:
-    Scanner(const std::string& source, ErrorReporter& reporter);
+    // firstLine: kaynak daha büyük bir dosyanın parçasıysa (örn. tembel fonksiyon gövdesi) başlangıç satırı
+    Scanner(std::string_view source, ErrorReporter& reporter, int firstLine = 1);
 
     // Kaynak kodu tarar ve token listesini döndürür.
     std::vector<Token> scanTokens();
 
+    // Akış modu: bir sonraki token'ı isteğe bağlı tarar (tüm liste oluşturulmaz).
+    // Kaynak sonunda her çağrıda END_OF_FILE döner.
+    Token nextToken() override;
+
 private:
-    const std::string& source;
+    std::string_view source;
     ErrorReporter& errorReporter;
     std::vector<Token> tokens; // Oluşturulan token'lar bu vektöre eklenir.
 
     int start = 0;   // Şu anki token'ın başlangıç pozisyonu.
     int current = 0; // Kaynak kodundaki şu anki karakter pozisyonu.
     int line = 1;    // Şu anki satır numarası.
+    bool encodingChecked = false;
+    bool encodingValid = false;
+
+    // Kaynağın geçerli UTF-8 olduğunu bir kez doğrular, değilse hata raporlar
+    bool checkEncoding();
 
-    // Anahtar kelimelerin haritası (örn: "if", "else", "var" vb.)
-    static const std::unordered_map<std::string, TokenType> keywords;
+    // Anahtar kelime tanıma (ilk harf ve uzunluk üzerinden switch; hash tablosu yok)
+    static TokenType keywordType(std::string_view text);
 
     // Tek karakterli token'ları işler
     void scanToken();
 
     // Token'ı ekler
     void addToken(TokenType type);
-    void addToken(TokenType type, std::variant<std::monostate, std::string, double, bool> literal);
+    void addToken(TokenType type, std::variant<std::monostate, double, bool> literal);
 
     // İleri okuma yardımcıları
     bool isAtEnd() const;         // Kaynak kodunun sonuna ulaşıldı mı?
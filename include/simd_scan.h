@@ -0,0 +1,29 @@
+#ifndef C_CUBE_SIMD_SCAN_H
+#define C_CUBE_SIMD_SCAN_H
+
+#include <cstddef>
+
+// Scanner için vektörleştirilmiş tarama yardımcıları.
+// AVX2 (32 bayt) veya SSE2 (16 bayt) derleme zamanında seçilir; blok sığmayan kuyruk ve
+// SIMD desteği olmayan hedefler için skaler yol kullanılır. Tüm fonksiyonlar [pos, end)
+// aralığında çalışır ve durdukları konumu döndürür.
+namespace SimdScan {
+    // Boşlukları (' ', '\t', '\r', '\n') atlar; geçilen satır sonları kadar line artırılır
+    size_t skipWhitespace(const char* data, size_t pos, size_t end, int& line);
+
+    // İlk '\n' konumu ya da end (satır yorumlarının sonu için)
+    size_t findLineEnd(const char* data, size_t pos, size_t end);
+
+    // İlk '"' konumu ya da end; aradaki satır sonları kadar line artırılır
+    size_t findStringEnd(const char* data, size_t pos, size_t end, int& line);
+
+    // Tanımlayıcı karakterlerinin ([A-Za-z0-9_]) bittiği ilk konum
+    size_t identifierEnd(const char* data, size_t pos, size_t end);
+
+    // Geçerli UTF-8 ise size, değilse ilk geçersiz baytın konumunu döndürür.
+    // ASCII bloklar vektörel olarak geçilir; çok baytlı diziler skaler doğrulanır
+    // (aşırı uzun kodlamalar, vekil çiftler ve U+10FFFF üstü reddedilir).
+    size_t validateUtf8(const char* data, size_t size);
+}
+
+#endif // C_CUBE_SIMD_SCAN_H
@@ -0,0 +1,110 @@
+#ifndef C_CUBE_SOURCE_LOCATION_H
+#define C_CUBE_SOURCE_LOCATION_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+
+#include "token.h"
+
+// AST düğümlerinde Token kopyası yerine tutulan 32 bitlik kaynak konumu.
+// Kayıtlı bir kaynak tamponundaki konum, SourceMap'teki global ofset + 1 olarak saklanır (bit 31 = 0).
+// Kayıtsız kaynaklardan (elle oluşturulan token'lar) gelen konumlarda satır numarası doğrudan
+// saklanır (bit 31 = 1). Satır numarası yalnızca hata raporlanırken çözülür.
+struct SourceLoc {
+    static constexpr uint32_t LINE_FLAG = 0x80000000u;
+
+    uint32_t bits = 0; // 0: bilinmeyen konum
+
+    static SourceLoc fromOffset(uint32_t offset) { return SourceLoc{offset + 1}; }
+    // Negatif satır (örn. -1: elle oluşturulan, konumsuz token) bilinmeyen konum olur
+    static SourceLoc fromLine(int line) {
+        return line < 0 ? SourceLoc{} : SourceLoc{LINE_FLAG | (static_cast<uint32_t>(line) & ~LINE_FLAG)};
+    }
+
+    bool isValid() const { return bits != 0; }
+    bool isLine() const { return (bits & LINE_FLAG) != 0; }
+    uint32_t offset() const { return bits - 1; }
+    int line() const { return static_cast<int>(bits & ~LINE_FLAG); }
+};
+
+// Bir kaynak tamponunun satır başlangıç ofsetleri. Yalnızca hata raporlamada gerektiği için
+// ilk sorguda kurulur.
+class LineTable {
+public:
+    explicit LineTable(std::string_view text) : text(text) {}
+    int lineOf(uint32_t offset) const; // 1 tabanlı satır numarası
+
+private:
+    std::string_view text;
+    mutable std::vector<uint32_t> lineStarts;
+};
+
+// Kaynak tamponlarını tek bir 32 bitlik ofset uzayına yerleştirir: her tampon bir taban ofset
+// alır, bir token'ın konumu taban + tampon içindeki bayt konumudur.
+// Modüller paralel parse edildiği için (bkz. ModuleLoader::preloadImports) tüm metotlar
+// iş parçacığı güvenlidir.
+class SourceMap {
+public:
+    // Tamponu kaydeder. Tampon, ondan üretilen SourceLoc'lar çözülebildiği sürece yaşamalıdır.
+    // Aynı bellek yeniden kullanılırsa (REPL) en son kayıt geçerlidir. firstLine, tampon bir
+    // dosyanın ortasından alınmış bir parçaysa (artımlı parse) ilk satırın numarasıdır.
+    void addBuffer(std::string_view text, int firstLine = 1);
+    // Tampon serbest bırakılmadan önce kaydını siler (bkz. SourceBufferScope). Ofset aralığı yeniden
+    // kullanılmaz; o aralıktan kalan konumlar bilinmeyen satır (-1) olarak çözülür.
+    void removeBuffer(std::string_view text);
+    // Kayıtlı tamponun taban ofseti (AST önbelleği konumları tampona göreli saklar)
+    bool baseOf(std::string_view text, uint32_t& base) const;
+
+    // Token'ın lexeme'i kayıtlı bir tampondaysa ofset, değilse satır kodlaması döndürür
+    SourceLoc locate(const Token& token) const;
+    // p kayıtlı bir tampondaysa ofset, değilse verilen satırın kodlaması
+    SourceLoc locate(const char* p, int line) const;
+    int line(SourceLoc loc) const;
+
+    // from'un tamponunda from ve sonrasındaki konumların satırına delta ekler. Artımlı parse'ta
+    // düzenlemenin ardından yeniden kullanılan düğümler eski tampona bakmaya devam ettiği için
+    // kayan satır numaraları böyle düzeltilir.
+    void shiftLines(SourceLoc from, int delta);
+
+    // Hata raporlama için konumdan token üretir. lexeme bir görünümdür: istisnayla taşınacaksa
+    // kalıcı bir string'e (örn. names() tablosu) bakmalı ya da boş bırakılmalıdır.
+    Token token(SourceLoc loc, std::string_view lexeme = "", TokenType type = TokenType::IDENTIFIER) const;
+
+private:
+    struct Buffer {
+        std::string_view text;
+        uint32_t base;
+        LineTable lines;
+        int firstLine;
+        std::vector<std::pair<uint32_t, int>> lineShifts; // (tampon içi ofset, satır farkı)
+    };
+    std::vector<Buffer> buffers; // Taban ofsete göre artan sırada (eklenme sırası)
+    uint32_t nextBase = 0;
+    // locate/baseOf paylaşımlı, addBuffer ve satır tablosunu tembel kuran line() özel kilit alır
+    mutable std::shared_mutex mutex;
+};
+
+// Süreç genelindeki kaynak haritası
+SourceMap& sourceMap();
+
+// Kaynak tamponunu kapsam boyunca sourceMap()'e kaydeder. Tamponun sahibi (run(), REPL satırı)
+// kapsamdan çıkarken kayıt silinir; harita serbest kalmış belleğe bakan görünüm tutmaz.
+class SourceBufferScope {
+public:
+    explicit SourceBufferScope(std::string_view text, int firstLine = 1) : text(text) {
+        sourceMap().addBuffer(text, firstLine);
+    }
+    ~SourceBufferScope() { sourceMap().removeBuffer(text); }
+    SourceBufferScope(const SourceBufferScope&) = delete;
+    SourceBufferScope& operator=(const SourceBufferScope&) = delete;
+
+private:
+    std::string_view text;
+};
+
+#endif // C_CUBE_SOURCE_LOCATION_H
@@ -2,6 +2,7 @@
 #define C_CUBE_TOKEN_H
 
 #include <string>
+#include <string_view> // Lexeme'ler kaynak tamponuna referans verir
 #include <variant>   // std::variant için
 #include <monostate> // std::monostate için (none değeri)
 
@@ -34,22 +35,31 @@ enum class TokenType {
 class Token {
 public:
     TokenType type;
-    std::string lexeme; // Kaynak kodundaki orijinal metin (örn: "var", "foo", "123")
-    std::variant<std::monostate, std::string, double, bool> literal; // Literal değer (stringler, sayılar, bool'lar)
+    // Kaynak kodundaki orijinal metin (örn: "var", "foo", "123"). Kopya değil, kaynak tamponuna
+    // bakan bir görünümdür; kaynak metin token'lardan (ve AST'den) uzun yaşamalıdır.
+    // Elle oluşturulan token'larda string literal (statik ömürlü) kullanılmalıdır.
+    std::string_view lexeme;
+    // Literal değer (sayılar). String literal'leri burada kopyalanmaz: içerikleri lexeme'in
+    // tırnaklar arasındaki kısmıdır (bkz. stringContents) ve std::string'e parser'da çevrilir.
+    std::variant<std::monostate, double, bool> literal;
     int line; // Token'ın kaynak kodundaki satır numarası
 
     // Constructor
-    Token(TokenType type, std::string lexeme, std::variant<std::monostate, std::string, double, bool> literal, int line)
-        : type(type), lexeme(std::move(lexeme)), literal(std::move(literal)), line(line) {}
-    // `std::move` kullanarak string kopyalamalarını optimize ediyoruz.
+    Token(TokenType type, std::string_view lexeme, std::variant<std::monostate, double, bool> literal, int line)
+        : type(type), lexeme(lexeme), literal(literal), line(line) {}
+
+    // STRING token'ının tırnaklar arasındaki metni (kaynak tamponuna bakar)
+    std::string_view stringContents() const {
+        return lexeme.size() >= 2 ? lexeme.substr(1, lexeme.size() - 2) : std::string_view();
+    }
 
     // Debugging ve hata mesajları için string temsili
     std::string toString() const {
         std::string lit_str;
-        if (std::holds_alternative<std::monostate>(literal)) {
+        if (type == TokenType::STRING) {
+            lit_str = std::string(stringContents());
+        } else if (std::holds_alternative<std::monostate>(literal)) {
             lit_str = "none";
-        } else if (std::holds_alternative<std::string>(literal)) {
-            lit_str = std::get<std::string>(literal);
         } else if (std::holds_alternative<double>(literal)) {
             lit_str = std::to_string(std::get<double>(literal));
         } else if (std::holds_alternative<bool>(literal)) {
@@ -60,7 +70,7 @@ public:
         // Basitlik için burada sadece lexeme ve literal'ı kullanıyorum.
         // Daha eksiksiz bir `toString` için `token_type_to_string` gibi bir fonksiyon gerekebilir.
         return "Type: " + std::to_string(static_cast<int>(type)) +
-               ", Lexeme: '" + lexeme +
+               ", Lexeme: '" + std::string(lexeme) +
                "', Literal: '" + lit_str + "'";
     }
 };
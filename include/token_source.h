@@ -0,0 +1,31 @@
+#ifndef C_CUBE_TOKEN_SOURCE_H
+#define C_CUBE_TOKEN_SOURCE_H
+
+#include <vector>
+#include "token.h"
+
+// Parser'ın token çektiği akış arayüzü. Token'lar isteğe bağlı üretilir; akışın sonunda
+// nextToken her çağrıda END_OF_FILE döndürür.
+class TokenSource {
+public:
+    virtual ~TokenSource() = default;
+    virtual Token nextToken() = 0;
+};
+
+// Önceden üretilmiş bir token listesini akış olarak sunar (mevcut vector tabanlı kullanım için)
+class VectorTokenSource : public TokenSource {
+public:
+    explicit VectorTokenSource(const std::vector<Token>& tokens) : tokens(tokens) {}
+
+    Token nextToken() override {
+        if (index < tokens.size()) return tokens[index++];
+        int line = tokens.empty() ? 1 : tokens.back().line;
+        return Token(TokenType::END_OF_FILE, "", std::monostate{}, line);
+    }
+
+private:
+    const std::vector<Token>& tokens;
+    size_t index = 0;
+};
+
+#endif // C_CUBE_TOKEN_SOURCE_H
@@ -0,0 +1,101 @@
+#ifndef C_CUBE_TRACE_JIT_H
+#define C_CUBE_TRACE_JIT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ast.h"         // Kaydedilen WhileStmt
+#include "environment.h" // İz girişlerinin okunduğu ve yazıldığı ortamlar
+
+// Sıcak while döngüleri için izleme (tracing) JIT'i. Döngü eşik kadar yinelendikten sonra bir
+// yinelemesi kaydedilir: koşul ve gövde, değişkenlerin o anki değerleriyle yürütülerek izlenir ve
+// izlenen doğrusal yol tipli, SSA biçiminde bir ara koda (IR) yazılır. Dallanmalar (if, and/or)
+// alınan yönü doğrulayan muhafızlara dönüşür.
+//
+// Kayıt sırasında ve sonrasında yapılan iyileştirmeler:
+//  - Sabit yayılımı: işlenenleri sabit olan işlemler kayıtta hesaplanır, sabit koşullu muhafızlar atılır.
+//  - Kutusuz değerler: sayılar ve bool'lar Value yerine double yazmaçlarda tutulur.
+//  - Muhafızların öne alınması: değişkenlerin tür muhafızları bir kez, iz girişinde denetlenir;
+//    döngüde değişmeyen işlemler ve muhafızlar döngü öncesine (preamble) taşınır.
+//  - Ölü kod silme: sonucu kullanılmayan yan etkisiz işlemler atılır.
+//
+// İz makine kodu yerine bu özelleşmiş IR üzerinde yürütülür. İz kendi yazmaçları dışında hiçbir
+// şeye yazmadığı ve döngü değişkenlerini yalnızca yineleme sonunda güncellediği için bir muhafız
+// tutmadığında değişkenler yinelemenin başındaki değerleriyle ortama yazılır ve o yineleme
+// yorumlayıcıda baştan yürütülür. Desteklenen alt küme: sayı/bool değişkenleri ve literal'leri,
+// aritmetik, karşılaştırma, eşitlik, '-', '!', and/or, liste okuma (xs[i]), atama, blok içi var ve
+// if. Çağrılar, nesneler, string'ler, iç içe döngüler ve return içeren yollar kaydedilmez.
+class LoopTrace {
+public:
+    using Reg = uint16_t;
+
+    enum class Type : uint8_t { Number, Bool };
+
+    enum class Op : uint8_t {
+        ADD, SUB, MUL,
+        DIV,           // Bölen sıfırsa yan çıkış
+        NEGATE, NOT,
+        LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL,
+        LOAD_ELEMENT,  // dst = lists[b][a]; dizin geçersizse ya da eleman türü uymazsa yan çıkış
+        GUARD_TRUE,    // a doğru değilse yan çıkış
+        GUARD_FALSE,   // a doğruysa yan çıkış
+        EXIT_IF_FALSE, // Döngü koşulu: a yanlışsa döngü normal biter
+        MOVE           // dst = a (yineleme sonunda döngü değişkenlerinin güncellenmesi)
+    };
+
+    struct Instr {
+        Op op;
+        Type type; // LOAD_ELEMENT: beklenen eleman türü
+        Reg dst;
+        Reg a;
+        Reg b;
+    };
+
+    // Değişkenin bulunduğu ortam: döngünün yürütüldüğü ortam ya da globals
+    // (aradaki ortamlarda aynı isim bulunmamalıdır; girişte denetlenir)
+    enum class Location : uint8_t { Local, Global };
+
+    // İzin okuduğu sayı/bool değişkeni. written ise çıkışta ortama geri yazılır.
+    struct Input {
+        std::string name;
+        Location location;
+        Type type;
+        Reg reg;
+        bool written;
+    };
+
+    // İzin okuduğu liste değişkeni (iz içinde atanamaz)
+    struct ListInput {
+        std::string name;
+        Location location;
+    };
+
+    enum class Exit {
+        NotEntered, // Giriş muhafızları tutmadı; döngü yorumlayıcıda sürer
+        LoopDone,   // Döngü koşulu yanlış oldu
+        SideExit    // Bir muhafız tutmadı; yarım kalan yineleme yorumlayıcıda baştan yürütülür
+    };
+
+    std::vector<Input> inputs;
+    std::vector<ListInput> lists;
+    std::vector<double> registers; // Başlangıç yazmaç dosyası (sabitler önceden yüklü)
+    std::vector<Instr> preamble;   // Döngü girişinde bir kez yürütülen, döngüde değişmeyen kod
+    std::vector<Instr> loop;       // Her yinelemede yürütülen kod
+    bool recordedAtGlobalScope = false;
+
+    // İzi verilen ortamda yürütür; iterations tamamlanan yineleme sayısını döndürür.
+    // Her çıkışta döngü değişkenleri ortama geri yazılır.
+    Exit run(Environment& environment, Environment& globals, uint64_t& iterations) const;
+};
+
+class TraceRecorder {
+public:
+    // Döngünün bir yinelemesini environment'taki değerlerle kaydeder. Yol alt küme dışındaysa ya da
+    // döngü bu yinelemede bitiyorsa nullptr döner. Kayıt ortamı değiştirmez.
+    static std::shared_ptr<const LoopTrace> record(const WhileStmt& loop, Environment& environment,
+                                                   Environment& globals);
+};
+
+#endif // C_CUBE_TRACE_JIT_H
@@ -14,13 +14,52 @@ class Object;
 // Tüm GC tarafından yönetilen nesneler bu tipte tutulacaktır.
 using ObjPtr = std::shared_ptr<Object>;
 
+// CubeString: string değerlerinin değişmez, paylaşılan içeriği.
+// Value kopyaları aynı tamponu paylaşır; ayrı ayrı üretilmiş eşit içerikler
+// tam koleksiyonda Gc::internStrings tarafından tek tampona birleştirilir.
+class CubeString {
+public:
+    using Payload = std::shared_ptr<const std::string>;
+
+    CubeString() : payload(std::make_shared<const std::string>()) {}
+    CubeString(std::string text) : payload(std::make_shared<const std::string>(std::move(text))) {}
+    CubeString(const char* text) : CubeString(std::string(text)) {}
+
+    const std::string& str() const { return *payload; }
+    operator const std::string&() const { return *payload; }
+    bool empty() const { return payload->empty(); }
+    size_t size() const { return payload->size(); }
+
+    const Payload& getPayload() const { return payload; }
+    // İçerik aynıysa kendi tamponunu bırakıp verilen tamponu paylaşır
+    bool share(const Payload& canonical) {
+        if (canonical == payload || *canonical != *payload) return false;
+        payload = canonical;
+        return true;
+    }
+    bool sharesStorageWith(const CubeString& other) const { return payload == other.payload; }
+
+    friend bool operator==(const CubeString& a, const CubeString& b) {
+        return a.payload == b.payload || *a.payload == *b.payload;
+    }
+    friend bool operator!=(const CubeString& a, const CubeString& b) { return !(a == b); }
+    friend bool operator<(const CubeString& a, const CubeString& b) { return *a.payload < *b.payload; }
+    friend bool operator>(const CubeString& a, const CubeString& b) { return *a.payload > *b.payload; }
+    friend bool operator<=(const CubeString& a, const CubeString& b) { return *a.payload <= *b.payload; }
+    friend bool operator>=(const CubeString& a, const CubeString& b) { return *a.payload >= *b.payload; }
+    friend std::ostream& operator<<(std::ostream& os, const CubeString& s) { return os << *s.payload; }
+
+private:
+    Payload payload; // Hiçbir zaman null değildir
+};
+
 // Value: C-CUBE dilindeki farklı değer tiplerini tutan bir varyant.
 // ObjPtr'ı da içerecek şekilde güncellendi.
 using Value = std::variant<
     std::monostate,   // Karşılığı 'none'
     bool,             // Boolean değerler
     double,           // Sayısal değerler
-    std::string,      // String değerler
+    CubeString,       // String değerler (paylaşılan, değişmez içerik)
     ObjPtr            // Çöp toplayıcı tarafından yönetilen objeler (Function, Class, Instance, List, Module, BoundMethod vb.)
 >;
 
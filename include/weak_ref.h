@@ -0,0 +1,62 @@
+#ifndef C_CUBE_WEAK_REF_H
+#define C_CUBE_WEAK_REF_H
+
+#include <string>
+#include <memory> // std::weak_ptr için
+#include <unordered_map>
+#include <vector>
+
+#include "object.h" // Temel Object sınıfı
+#include "value.h"  // Tablo değerleri için Value
+
+// Hedefini canlı tutmayan referans. Hedef bir koleksiyonda ölü bulunursa GC tarafından temizlenir.
+class CCubeWeakRef : public Object {
+private:
+    std::weak_ptr<Object> target;
+
+public:
+    explicit CCubeWeakRef(ObjPtr target);
+
+    ObjPtr get() const { return target.lock(); } // Hedef öldüyse nullptr
+    bool isAlive() const { return !target.expired(); }
+    void clear() { target.reset(); }
+
+    virtual ObjectType getType() const override { return ObjectType::WEAK_REF; }
+    virtual std::string toString() const override;
+    virtual size_t getSize() const override;
+};
+
+// Zayıf anahtarlı tablo (ephemeron). Anahtarlar nesne kimliğiyle eşleşir ve canlı tutulmaz;
+// bir değer yalnızca anahtarı canlıysa canlı tutulur. Anahtarı ölen girdiler GC tarafından silinir.
+class CCubeWeakMap : public Object {
+public:
+    struct Entry {
+        std::weak_ptr<Object> key;
+        Value value;
+    };
+
+private:
+    std::unordered_map<const Object*, Entry> entries;
+
+    // Anahtarın girdisini bulur; anahtarı çoktan ölmüş girdiyi silip end() döndürür
+    std::unordered_map<const Object*, Entry>::iterator findLive(const ObjPtr& key);
+
+public:
+    CCubeWeakMap() = default;
+
+    Value get(const ObjPtr& key);
+    void set(const ObjPtr& key, Value value);
+    bool has(const ObjPtr& key);
+    bool remove(const ObjPtr& key);
+    size_t size() const { return entries.size(); }
+
+    // GC erişimi (ephemeron işaretleme ve ölü anahtar temizliği için)
+    std::unordered_map<const Object*, Entry>& getEntriesMutable() { return entries; }
+    const std::unordered_map<const Object*, Entry>& getEntries() const { return entries; }
+
+    virtual ObjectType getType() const override { return ObjectType::WEAK_MAP; }
+    virtual std::string toString() const override;
+    virtual size_t getSize() const override;
+};
+
+#endif // C_CUBE_WEAK_REF_H
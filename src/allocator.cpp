@@ -0,0 +1,48 @@
+#include "allocator.h"
+#include <new> // std::align_val_t için
+#ifdef __GLIBC__
+#include <malloc.h> // malloc_trim için
+#endif
+
+const char* allocCategoryName(AllocCategory category) {
+    switch (category) {
+        case AllocCategory::Object: return "object";
+        case AllocCategory::Ast: return "ast";
+        case AllocCategory::Token: return "token";
+        case AllocCategory::Environment: return "environment";
+        case AllocCategory::Collector: return "collector";
+        case AllocCategory::Other: return "other";
+        default: return "unknown";
+    }
+}
+
+void* DefaultAllocator::allocate(std::size_t size, std::size_t alignment, AllocCategory category) {
+    void* ptr = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? ::operator new(size, std::align_val_t(alignment))
+        : ::operator new(size);
+    inUse[static_cast<std::size_t>(category)].fetch_add(size, std::memory_order_relaxed);
+    return ptr;
+}
+
+void DefaultAllocator::deallocate(void* ptr, std::size_t size, std::size_t alignment, AllocCategory category) {
+    if (ptr == nullptr) return;
+    inUse[static_cast<std::size_t>(category)].fetch_sub(size, std::memory_order_relaxed);
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(ptr, std::align_val_t(alignment));
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+void DefaultAllocator::trim(std::size_t retainBytes) {
+#ifdef __GLIBC__
+    malloc_trim(retainBytes);
+#else
+    (void)retainBytes; // Diğer platformlarda malloc boş sayfaları kendisi yönetir
+#endif
+}
+
+DefaultAllocator& defaultAllocator() {
+    static DefaultAllocator instance;
+    return instance;
+}
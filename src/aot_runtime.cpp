@@ -0,0 +1,76 @@
+#include "aot_runtime.h"
+#include "module_loader.h" // Derlenmiş modüllerin kaydı
+
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+// function() ile kurulan düğümlerin gövdeleri. Düğümler üretilen kodda fonksiyon içi statiktir,
+// süreç boyunca yaşar ve birden fazla yorumlayıcı tarafından yürütülebilir.
+std::unordered_map<const FunStmt*, std::shared_ptr<const AotFunction>>& aotBodies() {
+    static std::unordered_map<const FunStmt*, std::shared_ptr<const AotFunction>> bodies;
+    return bodies;
+}
+} // namespace
+
+AotRuntime::Registration::Registration(const char* moduleName, ModuleBody body) {
+    ModuleLoader::registerPrecompiled(moduleName, body);
+}
+
+ModulePtr AotRuntime::loadModule(Interpreter& interpreter, const std::string& moduleName, ModuleBody body) {
+    // Modül ortamı .cube modüllerindeki gibi globals'ın altındadır (built-in'lere erişebilmeli)
+    std::shared_ptr<Environment> moduleEnv = allocateShared<Environment>(interpreter.globals->getAllocator(),
+                                                                         AllocCategory::Environment, interpreter.globals);
+    ModulePtr loadedModule = std::make_shared<Module>(std::vector<StmtPtr>{}, moduleEnv);
+
+    std::shared_ptr<Environment> originalEnv = interpreter.environment;
+    GcStackRoot callerRoot(interpreter.gc, originalEnv.get());
+    interpreter.environment = moduleEnv;
+    try {
+        // Hatalar Interpreter::interpret'teki gibi raporlanır; modül yine de yüklenmiş sayılır
+        try {
+            body(interpreter);
+        } catch (const RuntimeException& e) {
+            interpreter.errorReporter.runtimeError(e);
+        } catch (const ReturnException&) {
+            interpreter.errorReporter.runtimeError(
+                RuntimeException(Token(TokenType::RETURN, "return", std::monostate{}, -1), "Top-level return."));
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Runtime Error in module '" << moduleName << "': " << e.what() << std::endl;
+        interpreter.environment = originalEnv;
+        return nullptr;
+    }
+    interpreter.environment = originalEnv;
+    return loadedModule;
+}
+
+std::shared_ptr<FunStmt> AotRuntime::function(const char* name, SourceLoc loc,
+                                              std::initializer_list<const char*> params, AotFunction::Body body) {
+    std::vector<Name> paramNames;
+    paramNames.reserve(params.size());
+    for (const char* param : params) paramNames.push_back(names().intern(param));
+    auto declaration = std::make_shared<FunStmt>(names().intern(name), loc, std::move(paramNames), std::vector<StmtPtr>{});
+    aotBodies()[declaration.get()] = std::make_shared<const AotFunction>(body);
+    return declaration;
+}
+
+std::shared_ptr<const AotFunction> AotRuntime::bodyOf(const FunStmt& declaration) {
+    auto found = aotBodies().find(&declaration);
+    return found != aotBodies().end() ? found->second : nullptr;
+}
+
+StmtPtr AotRuntime::classDeclaration(const char* name, SourceLoc loc, const char* superclass, SourceLoc superclassLoc,
+                                     std::vector<std::shared_ptr<FunStmt>> methods) {
+    ExprPtr superclassExpr = nullptr;
+    if (superclass != nullptr) superclassExpr = std::make_shared<VariableExpr>(names().intern(superclass), superclassLoc);
+    return std::make_shared<ClassStmt>(names().intern(name), loc, std::move(superclassExpr), std::move(methods));
+}
+
+StmtPtr AotRuntime::import(const char* moduleName, SourceLoc loc, const char* alias) {
+    return std::make_shared<ImportStmt>(names().intern(moduleName), loc, alias);
+}
+
+ExprPtr AotRuntime::super(SourceLoc keyword, const char* method, SourceLoc methodLoc) {
+    return std::make_shared<SuperExpr>(keyword, names().intern(method), methodLoc);
+}
@@ -0,0 +1,501 @@
+#include "ast_cache.h"
+#include "source_location.h"
+#include "name_table.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <filesystem>
+#include <random>
+
+#ifdef _WIN32
+#include <process.h>
+#define C_CUBE_GETPID _getpid
+#else
+#include <unistd.h>
+#define C_CUBE_GETPID getpid
+#endif
+
+// Derleme sırasında verilen sürüm (Makefile: VERSION, varsayılanı git describe)
+#ifndef C_CUBE_VERSION
+#define C_CUBE_VERSION "dev"
+#endif
+
+namespace AstCache {
+
+namespace {
+
+// Derleyici sürümü: biçim sürümüyle (FORMAT_VERSION) birlikte önbellek anahtarının sürüm kısmı.
+// Derleme zamanı damgası içermez; aynı kaynaktan yapılan derlemeler birbirinin önbelleğini okur.
+const char* const COMPILER_VERSION = "c-cube " C_CUBE_VERSION;
+const char MAGIC[4] = {'C', 'C', 'B', 'C'};
+
+// Düğüm etiketleri (0: boş işaretçi)
+enum Tag : uint8_t {
+    TAG_NULL = 0,
+    // İfadeler
+    TAG_ASSIGN, TAG_BINARY, TAG_CALL, TAG_GET, TAG_GROUPING, TAG_INDEX, TAG_LITERAL,
+    TAG_LOGICAL, TAG_SET, TAG_SUPER, TAG_THIS, TAG_UNARY, TAG_VARIABLE, TAG_LIST_LITERAL,
+    // Bildirimler
+    TAG_BLOCK, TAG_CLASS, TAG_EXPR_STMT, TAG_FUN, TAG_LAZY_FUN, TAG_IF, TAG_IMPORT,
+    TAG_RETURN, TAG_VAR, TAG_WHILE, TAG_MATCH
+};
+
+// Literal türleri
+enum LiteralKind : uint8_t { LIT_NONE, LIT_FALSE, LIT_TRUE, LIT_NUMBER, LIT_STRING };
+
+struct CacheFormatError {};
+
+bool acceptLazyBodies = false; // bkz. setAcceptLazyBodies
+
+// --- Yazıcı ---
+
+class AstWriter : public ExprVisitor<void>, public StmtVisitor<void> {
+public:
+    AstWriter(std::string_view source, uint32_t base) : source(source), base(base) {}
+
+    std::string out;                 // Bildirim listesi
+    std::vector<Name> nameOrder;     // Yerel isim indeksi -> Name
+    bool ok = true;                  // Kaynak dışına taşan tembel gövde vb. durumlarda false
+
+    void u8(uint8_t value) { out.push_back(static_cast<char>(value)); }
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            u8(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        u8(static_cast<uint8_t>(value));
+    }
+    void str(std::string_view text) {
+        varint(text.size());
+        out.append(text.data(), text.size());
+    }
+    void name(Name id) {
+        auto it = localNames.find(id);
+        if (it == localNames.end()) {
+            it = localNames.emplace(id, static_cast<uint32_t>(nameOrder.size())).first;
+            nameOrder.push_back(id);
+        }
+        varint(it->second);
+    }
+    // 0: bilinmeyen, (göreli ofset + 1) << 1: tampon içi, satır << 1 | 1: satır kodlaması
+    void loc(SourceLoc value) {
+        if (!value.isValid()) { varint(0); return; }
+        if (value.isLine()) { varint((static_cast<uint64_t>(value.line()) << 1) | 1); return; }
+        uint32_t offset = value.offset();
+        if (offset < base || offset - base > source.size()) { ok = false; varint(0); return; }
+        varint(static_cast<uint64_t>(offset - base + 1) << 1);
+    }
+
+    void expr(const ExprPtr& node) {
+        if (node == nullptr) { u8(TAG_NULL); return; }
+        node->accept(static_cast<ExprVisitor<void>&>(*this));
+    }
+    void stmt(const StmtPtr& node) {
+        if (node == nullptr) { u8(TAG_NULL); return; }
+        node->accept(static_cast<StmtVisitor<void>&>(*this));
+    }
+    void stmts(const std::vector<StmtPtr>& nodes) {
+        varint(nodes.size());
+        for (const StmtPtr& node : nodes) stmt(node);
+    }
+    void exprs(const std::vector<ExprPtr>& nodes) {
+        varint(nodes.size());
+        for (const ExprPtr& node : nodes) expr(node);
+    }
+
+    void visitAssignExpr(std::shared_ptr<AssignExpr> e) override { u8(TAG_ASSIGN); name(e->name); loc(e->loc); expr(e->value); }
+    void visitBinaryExpr(std::shared_ptr<BinaryExpr> e) override {
+        u8(TAG_BINARY); u8(static_cast<uint8_t>(e->op)); loc(e->loc); expr(e->left); expr(e->right);
+    }
+    void visitCallExpr(std::shared_ptr<CallExpr> e) override { u8(TAG_CALL); loc(e->paren); expr(e->callee); exprs(e->arguments); }
+    void visitGetExpr(std::shared_ptr<GetExpr> e) override { u8(TAG_GET); name(e->name); loc(e->loc); expr(e->object); }
+    void visitGroupingExpr(std::shared_ptr<GroupingExpr> e) override { u8(TAG_GROUPING); expr(e->expression); }
+    void visitIndexExpr(std::shared_ptr<IndexExpr> e) override { u8(TAG_INDEX); loc(e->bracket); expr(e->object); expr(e->index); }
+    void visitLiteralExpr(std::shared_ptr<LiteralExpr> e) override {
+        u8(TAG_LITERAL);
+        if (std::holds_alternative<bool>(e->value)) {
+            u8(std::get<bool>(e->value) ? LIT_TRUE : LIT_FALSE);
+        } else if (std::holds_alternative<double>(e->value)) {
+            u8(LIT_NUMBER);
+            double number = std::get<double>(e->value);
+            char bytes[sizeof(double)];
+            std::memcpy(bytes, &number, sizeof(double));
+            out.append(bytes, sizeof(double));
+        } else if (std::holds_alternative<std::string>(e->value)) {
+            u8(LIT_STRING);
+            str(std::get<std::string>(e->value));
+        } else {
+            u8(LIT_NONE);
+        }
+    }
+    void visitLogicalExpr(std::shared_ptr<LogicalExpr> e) override {
+        u8(TAG_LOGICAL); u8(static_cast<uint8_t>(e->op)); loc(e->loc); expr(e->left); expr(e->right);
+    }
+    void visitSetExpr(std::shared_ptr<SetExpr> e) override { u8(TAG_SET); name(e->name); loc(e->loc); expr(e->object); expr(e->value); }
+    void visitSuperExpr(std::shared_ptr<SuperExpr> e) override { u8(TAG_SUPER); loc(e->keyword); name(e->method); loc(e->methodLoc); }
+    void visitThisExpr(std::shared_ptr<ThisExpr> e) override { u8(TAG_THIS); loc(e->keyword); }
+    void visitUnaryExpr(std::shared_ptr<UnaryExpr> e) override { u8(TAG_UNARY); u8(static_cast<uint8_t>(e->op)); loc(e->loc); expr(e->right); }
+    void visitVariableExpr(std::shared_ptr<VariableExpr> e) override { u8(TAG_VARIABLE); name(e->name); loc(e->loc); }
+    void visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> e) override { u8(TAG_LIST_LITERAL); exprs(e->elements); }
+
+    void visitBlockStmt(std::shared_ptr<BlockStmt> s) override { u8(TAG_BLOCK); stmts(s->statements); }
+    void visitClassStmt(std::shared_ptr<ClassStmt> s) override {
+        u8(TAG_CLASS); name(s->name); loc(s->loc); expr(s->superclass);
+        varint(s->methods.size());
+        for (const auto& method : s->methods) stmt(method);
+    }
+    void visitExprStmt(std::shared_ptr<ExprStmt> s) override { u8(TAG_EXPR_STMT); expr(s->expression); }
+    void visitFunStmt(std::shared_ptr<FunStmt> s) override {
+        u8(s->bodyParsed ? TAG_FUN : TAG_LAZY_FUN);
+        name(s->name); loc(s->loc);
+        varint(s->params.size());
+        for (Name param : s->params) name(param);
+        if (s->bodyParsed) {
+            stmts(s->body);
+            return;
+        }
+        // Tembel gövde: kaynak aralığı ve serbest isimler (gövde yüklemeden sonra da ilk çağrıda parse edilir)
+        const char* begin = s->bodySource.data();
+        if (begin < source.data() || begin + s->bodySource.size() > source.data() + source.size()) {
+            ok = false;
+            return;
+        }
+        varint(static_cast<uint64_t>(begin - source.data()));
+        varint(s->bodySource.size());
+        varint(static_cast<uint64_t>(s->bodyLine));
+        varint(s->freeNames.size());
+        for (const std::string& freeName : s->freeNames) name(names().intern(freeName));
+    }
+    void visitIfStmt(std::shared_ptr<IfStmt> s) override { u8(TAG_IF); expr(s->condition); stmt(s->thenBranch); stmt(s->elseBranch); }
+    void visitImportStmt(std::shared_ptr<ImportStmt> s) override { u8(TAG_IMPORT); name(s->moduleName); loc(s->loc); str(s->alias); }
+    void visitReturnStmt(std::shared_ptr<ReturnStmt> s) override { u8(TAG_RETURN); loc(s->keyword); expr(s->value); }
+    void visitVarStmt(std::shared_ptr<VarStmt> s) override { u8(TAG_VAR); name(s->name); loc(s->loc); expr(s->initializer); }
+    void visitWhileStmt(std::shared_ptr<WhileStmt> s) override { u8(TAG_WHILE); expr(s->condition); stmt(s->body); }
+    void visitMatchStmt(std::shared_ptr<MatchStmt> s) override {
+        u8(TAG_MATCH); expr(s->subject);
+        varint(s->cases.size());
+        for (const MatchCase& matchCase : s->cases) {
+            expr(matchCase.pattern);
+            stmt(matchCase.body);
+        }
+    }
+
+private:
+    std::string_view source;
+    uint32_t base;
+    std::unordered_map<Name, uint32_t> localNames;
+};
+
+// --- Okuyucu ---
+
+class AstReader {
+public:
+    AstReader(std::string_view data, std::string_view source, uint32_t base, Allocator& allocator)
+        : pos(data.data()), end(data.data() + data.size()), source(source), base(base), allocator(allocator) {}
+
+    const char* pos;
+    const char* end;
+    std::vector<Name> nameTable; // Yerel isim indeksi -> Name
+
+    uint8_t u8() {
+        if (pos >= end) throw CacheFormatError();
+        return static_cast<uint8_t>(*pos++);
+    }
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = u8();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        throw CacheFormatError();
+    }
+    // Eleman sayısı: her eleman en az bir bayt tuttuğundan kalan bayttan büyük olamaz.
+    // Bozuk bir sayının dev bir vector ayırmasına yol açmaması için kapsayıcılar buradan boyutlanır.
+    uint64_t count() {
+        uint64_t value = varint();
+        if (value > static_cast<uint64_t>(end - pos)) throw CacheFormatError();
+        return value;
+    }
+    std::string_view str() {
+        uint64_t length = varint();
+        if (length > static_cast<uint64_t>(end - pos)) throw CacheFormatError();
+        std::string_view text(pos, length);
+        pos += length;
+        return text;
+    }
+    Name name() {
+        uint64_t index = varint();
+        if (index >= nameTable.size()) throw CacheFormatError();
+        return nameTable[index];
+    }
+    SourceLoc loc() {
+        uint64_t value = varint();
+        if (value == 0) return SourceLoc{};
+        if (value & 1) return SourceLoc::fromLine(static_cast<int>(value >> 1));
+        uint64_t relative = (value >> 1) - 1;
+        if (relative > source.size()) throw CacheFormatError();
+        return SourceLoc::fromOffset(base + static_cast<uint32_t>(relative));
+    }
+    TokenType tokenType() {
+        uint8_t value = u8();
+        if (value > static_cast<uint8_t>(TokenType::END_OF_FILE)) throw CacheFormatError();
+        return static_cast<TokenType>(value);
+    }
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> node(Args&&... args) {
+        return allocateShared<T>(allocator, AllocCategory::Ast, std::forward<Args>(args)...);
+    }
+
+    std::vector<ExprPtr> exprs() {
+        std::vector<ExprPtr> nodes(count());
+        for (ExprPtr& node : nodes) node = expr();
+        return nodes;
+    }
+    std::vector<StmtPtr> stmts() {
+        std::vector<StmtPtr> nodes(count());
+        for (StmtPtr& node : nodes) node = stmt();
+        return nodes;
+    }
+
+    ExprPtr expr() {
+        switch (u8()) {
+            case TAG_NULL: return nullptr;
+            case TAG_ASSIGN: { Name n = name(); SourceLoc l = loc(); return node<AssignExpr>(n, l, expr()); }
+            case TAG_BINARY: {
+                TokenType op = tokenType(); SourceLoc l = loc();
+                ExprPtr left = expr(); ExprPtr right = expr();
+                return node<BinaryExpr>(left, op, l, right);
+            }
+            case TAG_CALL: { SourceLoc paren = loc(); ExprPtr callee = expr(); return node<CallExpr>(callee, paren, exprs()); }
+            case TAG_GET: { Name n = name(); SourceLoc l = loc(); return node<GetExpr>(expr(), n, l); }
+            case TAG_GROUPING: return node<GroupingExpr>(expr());
+            case TAG_INDEX: { SourceLoc bracket = loc(); ExprPtr object = expr(); return node<IndexExpr>(object, bracket, expr()); }
+            case TAG_LITERAL: {
+                switch (u8()) {
+                    case LIT_NONE: return node<LiteralExpr>(std::monostate{});
+                    case LIT_FALSE: return node<LiteralExpr>(false);
+                    case LIT_TRUE: return node<LiteralExpr>(true);
+                    case LIT_NUMBER: {
+                        if (end - pos < static_cast<std::ptrdiff_t>(sizeof(double))) throw CacheFormatError();
+                        double number;
+                        std::memcpy(&number, pos, sizeof(double));
+                        pos += sizeof(double);
+                        return node<LiteralExpr>(number);
+                    }
+                    case LIT_STRING: return node<LiteralExpr>(std::string(str()));
+                    default: throw CacheFormatError();
+                }
+            }
+            case TAG_LOGICAL: {
+                TokenType op = tokenType(); SourceLoc l = loc();
+                ExprPtr left = expr(); ExprPtr right = expr();
+                return node<LogicalExpr>(left, op, l, right);
+            }
+            case TAG_SET: { Name n = name(); SourceLoc l = loc(); ExprPtr object = expr(); return node<SetExpr>(object, n, l, expr()); }
+            case TAG_SUPER: { SourceLoc keyword = loc(); Name method = name(); return node<SuperExpr>(keyword, method, loc()); }
+            case TAG_THIS: return node<ThisExpr>(loc());
+            case TAG_UNARY: { TokenType op = tokenType(); SourceLoc l = loc(); return node<UnaryExpr>(op, l, expr()); }
+            case TAG_VARIABLE: { Name n = name(); return node<VariableExpr>(n, loc()); }
+            case TAG_LIST_LITERAL: return node<ListLiteralExpr>(exprs());
+            default: throw CacheFormatError();
+        }
+    }
+
+    StmtPtr stmt() {
+        uint8_t tag = u8();
+        switch (tag) {
+            case TAG_NULL: return nullptr;
+            case TAG_BLOCK: return node<BlockStmt>(stmts());
+            case TAG_CLASS: {
+                Name n = name(); SourceLoc l = loc(); ExprPtr superclass = expr();
+                std::vector<std::shared_ptr<FunStmt>> methods(count());
+                for (auto& method : methods) {
+                    method = std::dynamic_pointer_cast<FunStmt>(stmt());
+                    if (method == nullptr) throw CacheFormatError();
+                }
+                return node<ClassStmt>(n, l, superclass, methods);
+            }
+            case TAG_EXPR_STMT: return node<ExprStmt>(expr());
+            case TAG_FUN:
+            case TAG_LAZY_FUN: {
+                Name n = name(); SourceLoc l = loc();
+                std::vector<Name> params(count());
+                for (Name& param : params) param = name();
+                if (tag == TAG_FUN) return node<FunStmt>(n, l, params, stmts());
+                if (!acceptLazyBodies) throw CacheFormatError(); // Gövde denetlenmemiş; yeniden parse et
+
+                uint64_t offset = varint();
+                uint64_t length = varint();
+                if (offset > source.size() || length > source.size() - offset) throw CacheFormatError();
+                int bodyLine = static_cast<int>(varint());
+                std::vector<std::string> freeNames(count());
+                for (std::string& freeName : freeNames) freeName = names().spelling(name());
+                return node<FunStmt>(n, l, params, source.substr(offset, length), bodyLine, std::move(freeNames));
+            }
+            case TAG_IF: {
+                ExprPtr condition = expr(); StmtPtr thenBranch = stmt();
+                return node<IfStmt>(condition, thenBranch, stmt());
+            }
+            case TAG_IMPORT: { Name n = name(); SourceLoc l = loc(); return node<ImportStmt>(n, l, std::string(str())); }
+            case TAG_RETURN: { SourceLoc keyword = loc(); return node<ReturnStmt>(keyword, expr()); }
+            case TAG_VAR: { Name n = name(); SourceLoc l = loc(); return node<VarStmt>(n, l, expr()); }
+            case TAG_WHILE: { ExprPtr condition = expr(); return node<WhileStmt>(condition, stmt()); }
+            case TAG_MATCH: {
+                ExprPtr subject = expr();
+                std::vector<MatchCase> cases;
+                uint64_t caseCount = count();
+                for (uint64_t i = 0; i < caseCount; ++i) {
+                    ExprPtr pattern = expr();
+                    cases.emplace_back(pattern, stmt());
+                }
+                return node<MatchStmt>(subject, cases);
+            }
+            default: throw CacheFormatError();
+        }
+    }
+
+private:
+    std::string_view source;
+    uint32_t base;
+    Allocator& allocator;
+};
+
+void appendU32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void appendU64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+uint64_t readFixed(const char*& pos, const char* end, int bytes) {
+    if (end - pos < bytes) throw CacheFormatError();
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(static_cast<uint8_t>(pos[i])) << (8 * i);
+    pos += bytes;
+    return value;
+}
+
+bool cacheEnabled = true;
+
+} // namespace
+
+void setEnabled(bool enabled) { cacheEnabled = enabled; }
+bool isEnabled() { return cacheEnabled; }
+void setAcceptLazyBodies(bool accept) { acceptLazyBodies = accept; }
+
+uint64_t hashSource(std::string_view source) {
+    uint64_t hash = 14695981039346656037ull; // FNV-1a 64 offset basis
+    for (char c : source) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string cachePathFor(const std::string& sourcePath) {
+    std::filesystem::path path(sourcePath);
+    const char* cacheDir = std::getenv("C_CUBE_CACHE_DIR");
+    if (cacheDir == nullptr || *cacheDir == '\0') {
+        return path.replace_extension(".ccbc").string();
+    }
+    // Ortak dizinde farklı klasörlerdeki aynı isimli dosyalar çakışmasın diye mutlak yolun özeti eklenir
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    std::ostringstream name;
+    name << path.stem().string() << '-' << std::hex << hashSource(absolute.string()) << ".ccbc";
+    return (std::filesystem::path(cacheDir) / name.str()).string();
+}
+
+bool store(const std::string& cachePath, std::string_view source, const std::vector<StmtPtr>& program) {
+    if (!cacheEnabled) return false;
+    uint32_t base = 0;
+    if (!sourceMap().baseOf(source, base)) return false;
+
+    AstWriter writer(source, base);
+    writer.stmts(program);
+    if (!writer.ok) return false;
+
+    std::string file(MAGIC, sizeof(MAGIC));
+    appendU32(file, FORMAT_VERSION);
+    file += COMPILER_VERSION;
+    file.push_back('\0');
+    appendU64(file, hashSource(source));
+    appendU64(file, source.size());
+
+    // İsim tablosu gövdeden önce gelir ki okuyucu isimleri tek geçişte intern edebilsin
+    AstWriter nameTable(source, base);
+    nameTable.varint(writer.nameOrder.size());
+    for (Name id : writer.nameOrder) nameTable.str(names().spelling(id));
+    file += nameTable.out;
+    file += writer.out;
+
+    // Yarım yazılmış dosya okunmasın diye geçici dosyaya yazıp yeniden adlandır. Aynı betiği
+    // derleyen süreçler birbirinin geçici dosyasını ezmesin diye ad süreç kimliği ve rastgele ek taşır.
+    std::ostringstream tempName;
+    tempName << cachePath << '.' << C_CUBE_GETPID() << '-' << std::hex << std::random_device{}() << ".tmp";
+    std::string tempPath = tempName.str();
+    {
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        if (!output) return false;
+        output.write(file.data(), static_cast<std::streamsize>(file.size()));
+        if (!output) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool load(const std::string& cachePath, std::string_view source, Allocator& allocator,
+          std::vector<StmtPtr>& program) {
+    if (!cacheEnabled) return false;
+    uint32_t base = 0;
+    if (!sourceMap().baseOf(source, base)) return false;
+
+    std::ifstream input(cachePath, std::ios::binary);
+    if (!input) return false;
+    std::string file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    try {
+        const char* pos = file.data();
+        const char* end = file.data() + file.size();
+        if (end - pos < static_cast<std::ptrdiff_t>(sizeof(MAGIC)) || std::memcmp(pos, MAGIC, sizeof(MAGIC)) != 0) return false;
+        pos += sizeof(MAGIC);
+        if (readFixed(pos, end, 4) != FORMAT_VERSION) return false;
+
+        size_t versionLength = std::strlen(COMPILER_VERSION);
+        if (static_cast<size_t>(end - pos) < versionLength + 1 ||
+            std::memcmp(pos, COMPILER_VERSION, versionLength + 1) != 0) return false;
+        pos += versionLength + 1;
+
+        if (readFixed(pos, end, 8) != hashSource(source)) return false;
+        if (readFixed(pos, end, 8) != source.size()) return false;
+
+        AstReader reader(std::string_view(pos, end - pos), source, base, allocator);
+        uint64_t nameCount = reader.count();
+        reader.nameTable.reserve(nameCount);
+        for (uint64_t i = 0; i < nameCount; ++i) reader.nameTable.push_back(names().intern(reader.str()));
+
+        std::vector<StmtPtr> loaded = reader.stmts();
+        if (reader.pos != reader.end) return false; // Fazla bayt: bozuk dosya
+        program = std::move(loaded);
+        return true;
+    } catch (const CacheFormatError&) {
+        return false;
+    } catch (const std::exception&) {
+        // Bozuk dosyadan kalan ayırma/uzunluk hataları (bad_alloc, length_error): kaynak yeniden parse edilir
+        return false;
+    }
+}
+
+} // namespace AstCache
@@ -8,7 +8,8 @@ BoundMethod::BoundMethod(std::shared_ptr<CCubeInstance> instance, std::shared_pt
 Value BoundMethod::call(Interpreter& interpreter, const std::vector<Value>& arguments) {
     return function->call(interpreter, arguments, instance);
 }
-    std::shared_ptr<Environment> method_environment = std::make_shared<Environment>(function->getClosure());
+    std::shared_ptr<Environment> method_environment = allocateShared<Environment>(
+        function->getClosure()->getAllocator(), AllocCategory::Environment, function->getClosure());
 
     // 'this' anahtar kelimesini bu yeni ortama tanımla.
     // 'instance' zaten bir ObjPtr olduğu için doğrudan atanabilir.
@@ -5,6 +5,10 @@
 #include <vector>
 #include <string>
 #include <chrono>        // clock fonksiyonu için
+#include "environment.h"   // Global ve modül ortamları için
+#include "gc.h"            // gc modülü çöp toplayıcıyı kontrol eder
+#include "c_cube_module.h" // gc modülü bir CCubeModule'dür
+#include "error_reporter.h" // RuntimeException için
 
 // BuiltinPrint implementasyonu
 
@@ -24,8 +28,8 @@ ValuePtr BuiltinPrint::call(Interpreter& interpreter, const std::vector<ValuePtr
     // Şimdilik Value variantına doğrudan erişelim (eksik tip desteği olabilir)
     ValuePtr arg = arguments[0];
     if (arg) {
-        if (std::holds_alternative<std::string>(*arg)) {
-            std::cout << std::get<std::string>(*arg);
+        if (std::holds_alternative<CubeString>(*arg)) {
+            std::cout << std::get<CubeString>(*arg);
         } else if (std::holds_alternative<double>(*arg)) {
             // Sayıları farklı formatlarda yazdırabilirsiniz
             std::cout << std::get<double>(*arg);
@@ -72,3 +76,175 @@ ValuePtr BuiltinClock::call(Interpreter& interpreter, const std::vector<ValuePtr
 }
 
 // Ek built-in fonksiyonların implementasyonları buraya eklenecektir.
+
+// --- Yerleşik modüller ---
+
+namespace {
+    // Native fonksiyon hataları için token (kaynak konumu yok, satır -1).
+    // Lexeme kopyalanmadığından name statik ömürlü olmalıdır (string literal).
+    Token nativeToken(const char* name) {
+        return Token(TokenType::IDENTIFIER, name, std::monostate{}, -1);
+    }
+
+    double expectNumber(const std::vector<Value>& arguments, size_t index, const char* fnName) {
+        if (!std::holds_alternative<double>(arguments[index])) {
+            throw RuntimeException(nativeToken(fnName), "'" + std::string(fnName) + "' argümanı bir sayı olmalıdır.");
+        }
+        return std::get<double>(arguments[index]);
+    }
+
+    ObjPtr expectObject(const std::vector<Value>& arguments, size_t index, const char* fnName) {
+        if (!std::holds_alternative<ObjPtr>(arguments[index]) || std::get<ObjPtr>(arguments[index]) == nullptr) {
+            throw RuntimeException(nativeToken(fnName), "'" + std::string(fnName) + "' argümanı bir nesne olmalıdır.");
+        }
+        return std::get<ObjPtr>(arguments[index]);
+    }
+
+    template <typename T>
+    std::shared_ptr<T> expectObjectOfType(const std::vector<Value>& arguments, size_t index,
+                                          Object::ObjectType type, const char* fnName,
+                                          const std::string& typeName) {
+        ObjPtr obj = expectObject(arguments, index, fnName);
+        if (obj->getType() != type) {
+            throw RuntimeException(nativeToken(fnName), "'" + std::string(fnName) + "' argümanı bir " + typeName + " olmalıdır.");
+        }
+        return std::static_pointer_cast<T>(obj);
+    }
+
+    std::shared_ptr<CCubeWeakRef> expectWeakRef(const std::vector<Value>& arguments, size_t index, const char* fnName) {
+        return expectObjectOfType<CCubeWeakRef>(arguments, index, Object::ObjectType::WEAK_REF, fnName, "weakref");
+    }
+
+    std::shared_ptr<CCubeWeakMap> expectWeakMap(const std::vector<Value>& arguments, size_t index, const char* fnName) {
+        return expectObjectOfType<CCubeWeakMap>(arguments, index, Object::ObjectType::WEAK_MAP, fnName, "weakmap");
+    }
+
+    // Native fonksiyonlar da diğer nesneler gibi Gc'nin ayırıcısından (Object kategorisi) ayrılır;
+    // izlenmezler, tanımlandıkları ortam yaşadıkça yaşarlar.
+    void defineNative(Gc& gc, const std::shared_ptr<Environment>& env, const std::string& name,
+                      size_t arity, NativeFunction::Body body) {
+        env->define(name, std::static_pointer_cast<Object>(gc.make<NativeFunction>(name, arity, std::move(body))));
+    }
+}
+
+ObjPtr BuiltinFunctions::makeGcModule(Gc& gc) {
+    std::shared_ptr<Environment> env = allocateShared<Environment>(gc.getAllocator(), AllocCategory::Environment, gc.getAllocator());
+
+    // gc.collect(full): full true ise tam, değilse genç nesil koleksiyonu
+    defineNative(gc, env, "collect", 1, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        bool full = std::holds_alternative<bool>(args[0]) && std::get<bool>(args[0]);
+        gc.collectGarbage(full);
+        return std::monostate{};
+    });
+
+    // gc.step(budget): iş kredisi ekler, koleksiyon yapıldıysa true döner
+    defineNative(gc, env, "step", 1, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        double budget = expectNumber(args, 0, "gc.step");
+        return gc.step(budget > 0 ? static_cast<size_t>(budget) : 0);
+    });
+
+    // gc.idle(ms): karede kalan boş süreyi bildirir, iş yapıldıysa true döner
+    defineNative(gc, env, "idle", 1, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        double ms = expectNumber(args, 0, "gc.idle");
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double, std::milli>(ms > 0 ? ms : 0));
+        return gc.notifyIdle(deadline);
+    });
+
+    // gc.pause() / gc.resume(): kritik bölümlerde otomatik koleksiyonu ertele
+    defineNative(gc, env, "pause", 0, [&gc](Interpreter&, const std::vector<Value>&) -> Value {
+        gc.pause();
+        return std::monostate{};
+    });
+    defineNative(gc, env, "resume", 0, [&gc](Interpreter&, const std::vector<Value>&) -> Value {
+        gc.resume();
+        return std::monostate{};
+    });
+
+    // gc.stats(): [ayrılan bayt, genç nesne sayısı, yaşlı nesne sayısı,
+    //              genç koleksiyon sayısı, tam koleksiyon sayısı, duraklatıldı mı]
+    defineNative(gc, env, "stats", 0, [&gc](Interpreter&, const std::vector<Value>&) -> Value {
+        std::vector<Value> stats = {
+            static_cast<double>(gc.getTotalAllocatedBytes()),
+            static_cast<double>(gc.youngGeneration.size()),
+            static_cast<double>(gc.oldGeneration.size()),
+            static_cast<double>(gc.youngGenCollections),
+            static_cast<double>(gc.fullCollections),
+            gc.isPaused()
+        };
+        return gc.createList(stats);
+    });
+
+    // gc.shared(a, b): iki string aynı tamponu paylaşıyorsa true (tam koleksiyon eşitleri birleştirir)
+    defineNative(gc, env, "shared", 2, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        const CubeString* a = std::get_if<CubeString>(&args[0]);
+        const CubeString* b = std::get_if<CubeString>(&args[1]);
+        return a != nullptr && b != nullptr && a->sharesStorageWith(*b);
+    });
+
+    // Ayarlanabilir parametreler
+    defineNative(gc, env, "setNurserySize", 1, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        double size = expectNumber(args, 0, "gc.setNurserySize");
+        gc.setNurserySize(size > 0 ? static_cast<size_t>(size) : 1);
+        return std::monostate{};
+    });
+    defineNative(gc, env, "setPromotionThreshold", 1, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        gc.setPromotionThreshold(static_cast<int>(expectNumber(args, 0, "gc.setPromotionThreshold")));
+        return std::monostate{};
+    });
+
+    return gc.createObject(gc.make<CCubeModule>("gc", env));
+}
+
+ObjPtr BuiltinFunctions::makeWeakModule(Gc& gc) {
+    std::shared_ptr<Environment> env = allocateShared<Environment>(gc.getAllocator(), AllocCategory::Environment, gc.getAllocator());
+
+    // weak.ref(obj): nesneyi canlı tutmayan bir referans oluşturur
+    defineNative(gc, env, "ref", 1, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        return gc.createWeakRef(expectObject(args, 0, "weak.ref"));
+    });
+    // weak.get(ref): hedef nesne ya da hedef öldüyse none
+    defineNative(gc, env, "get", 1, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        ObjPtr target = expectWeakRef(args, 0, "weak.get")->get();
+        return target != nullptr ? Value(target) : Value(std::monostate{});
+    });
+    defineNative(gc, env, "alive", 1, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        return expectWeakRef(args, 0, "weak.alive")->isAlive();
+    });
+
+    // weak.map(): anahtarları canlı tutmayan tablo
+    defineNative(gc, env, "map", 0, [&gc](Interpreter&, const std::vector<Value>&) -> Value {
+        return gc.createWeakMap();
+    });
+    defineNative(gc, env, "set", 3, [&gc](Interpreter&, const std::vector<Value>& args) -> Value {
+        std::shared_ptr<CCubeWeakMap> map = expectWeakMap(args, 0, "weak.set");
+        gc.rememberStore(map.get(), args[2]);
+        map->set(expectObject(args, 1, "weak.set"), args[2]);
+        return std::monostate{};
+    });
+    defineNative(gc, env, "lookup", 2, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        return expectWeakMap(args, 0, "weak.lookup")->get(expectObject(args, 1, "weak.lookup"));
+    });
+    defineNative(gc, env, "has", 2, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        return expectWeakMap(args, 0, "weak.has")->has(expectObject(args, 1, "weak.has"));
+    });
+    defineNative(gc, env, "remove", 2, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        return expectWeakMap(args, 0, "weak.remove")->remove(expectObject(args, 1, "weak.remove"));
+    });
+    defineNative(gc, env, "size", 1, [](Interpreter&, const std::vector<Value>& args) -> Value {
+        return static_cast<double>(expectWeakMap(args, 0, "weak.size")->size());
+    });
+
+    return gc.createObject(gc.make<CCubeModule>("weak", env));
+}
+
+void BuiltinFunctions::defineBuiltins(std::shared_ptr<Environment> globals, Gc& gc) {
+    defineNative(gc, globals, "clock", 0, [](Interpreter&, const std::vector<Value>&) -> Value {
+        auto duration = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+    });
+
+    globals->define("gc", makeGcModule(gc));
+    globals->define("weak", makeWeakModule(gc));
+}
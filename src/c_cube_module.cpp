@@ -6,10 +6,14 @@ CCubeModule::CCubeModule(const std::string& name, std::shared_ptr<Environment> e
     : name(name), moduleEnvironment(env) {}
 
 Value CCubeModule::getMember(const Token& name) {
-    if (moduleEnvironment->contains(name.lexeme)) {
-        return moduleEnvironment->get(name);
+    return getMember(std::string(name.lexeme), SourceLoc::fromLine(name.line));
+}
+
+Value CCubeModule::getMember(const std::string& name, SourceLoc loc) {
+    if (moduleEnvironment->contains(name)) {
+        return moduleEnvironment->get(name, loc);
     }
-    throw RuntimeException(name, "Modül '" + this->name + "' içinde '" + name.lexeme + "' adlı üye bulunamadı.");
+    throw RuntimeException(sourceMap().token(loc), "Modül '" + this->name + "' içinde '" + name + "' adlı üye bulunamadı.");
 }
 
 std::string CCubeModule::toString() const {
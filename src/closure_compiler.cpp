@@ -0,0 +1,347 @@
+#include "closure_compiler.h"
+#include "interpreter.h"
+
+namespace {
+
+bool isNumber(const Value& value) { return std::holds_alternative<double>(value); }
+
+} // namespace
+
+// Her iki işleneni de sayı olması gereken operatörler. Operatör derleme zamanında seçildiği
+// için kapanışta switch yoktur; sabit bir işlenenin denetimi de derlemede yapılmıştır.
+template <typename Op>
+CompiledExpr ClosureCompiler::numericBinary(CompiledExpr left, CompiledExpr right, const Value* leftConst,
+                                            const Value* rightConst, SourceLoc loc, Op op) {
+    if (rightConst != nullptr && isNumber(*rightConst)) {
+        double r = std::get<double>(*rightConst);
+        Value rightValue = *rightConst;
+        return [left = std::move(left), r, rightValue, loc, op](Interpreter& in) -> Value {
+            Value l = left(in);
+            if (!isNumber(l)) in.checkNumberOperands(loc, l, rightValue);
+            return op(std::get<double>(l), r);
+        };
+    }
+    if (leftConst != nullptr && isNumber(*leftConst)) {
+        double l = std::get<double>(*leftConst);
+        Value leftValue = *leftConst;
+        return [l, leftValue, right = std::move(right), loc, op](Interpreter& in) -> Value {
+            Value r = right(in);
+            if (!isNumber(r)) in.checkNumberOperands(loc, leftValue, r);
+            return op(l, std::get<double>(r));
+        };
+    }
+    return [left = std::move(left), right = std::move(right), loc, op](Interpreter& in) -> Value {
+        Value l = left(in);
+        Value r = right(in);
+        if (!isNumber(l) || !isNumber(r)) in.checkNumberOperands(loc, l, r);
+        return op(std::get<double>(l), std::get<double>(r));
+    };
+}
+
+std::shared_ptr<const CompiledBlock> ClosureCompiler::compile(const std::vector<StmtPtr>& statements) {
+    ClosureCompiler compiler;
+    return compiler.block(statements);
+}
+
+CompiledExpr ClosureCompiler::expr(const ExprPtr& node) {
+    return node->accept(static_cast<ExprVisitor<CompiledExpr>&>(*this));
+}
+
+CompiledStmt ClosureCompiler::stmt(const StmtPtr& node) {
+    return node->accept(static_cast<StmtVisitor<CompiledStmt>&>(*this));
+}
+
+std::shared_ptr<const CompiledBlock> ClosureCompiler::block(const std::vector<StmtPtr>& statements) {
+    auto compiled = std::make_shared<CompiledBlock>();
+    compiled->statements.reserve(statements.size());
+    for (const auto& statement : statements) compiled->statements.push_back(stmt(statement));
+    return compiled;
+}
+
+CompiledStmt ClosureCompiler::tree(StmtPtr node) {
+    return [node = std::move(node)](Interpreter& in) { in.execute(node); };
+}
+
+const Value* ClosureCompiler::constantOf(const ExprPtr& node) const {
+    auto it = constants.find(node.get());
+    return it == constants.end() ? nullptr : &it->second;
+}
+
+CompiledExpr ClosureCompiler::constant(const ExprPtr& node, Value value) {
+    constants[node.get()] = value;
+    return [value](Interpreter&) -> Value { return value; };
+}
+
+// --- İfadeler ---
+
+CompiledExpr ClosureCompiler::visitAssignExpr(std::shared_ptr<AssignExpr> node) {
+    const std::string* name = &names().spelling(node->name);
+    return [value = expr(node->value), name, loc = node->loc](Interpreter& in) -> Value {
+        Value result = value(in);
+        in.environment->assign(*name, result, loc);
+        return result;
+    };
+}
+
+CompiledExpr ClosureCompiler::visitBinaryExpr(std::shared_ptr<BinaryExpr> node) {
+    CompiledExpr left = expr(node->left);
+    CompiledExpr right = expr(node->right);
+    const Value* leftConst = constantOf(node->left);
+    const Value* rightConst = constantOf(node->right);
+    const SourceLoc loc = node->loc;
+
+    // İki sayı sabiti: sonuç derlemede hesaplanır (sıfıra bölme çalışma zamanı hatası olarak kalır)
+    if (leftConst && rightConst && isNumber(*leftConst) && isNumber(*rightConst)) {
+        double l = std::get<double>(*leftConst);
+        double r = std::get<double>(*rightConst);
+        switch (node->op) {
+            case TokenType::PLUS: return constant(node, l + r);
+            case TokenType::MINUS: return constant(node, l - r);
+            case TokenType::STAR: return constant(node, l * r);
+            case TokenType::SLASH: if (r != 0.0) return constant(node, l / r); break;
+            case TokenType::GREATER: return constant(node, l > r);
+            case TokenType::GREATER_EQUAL: return constant(node, l >= r);
+            case TokenType::LESS: return constant(node, l < r);
+            case TokenType::LESS_EQUAL: return constant(node, l <= r);
+            case TokenType::EQUAL_EQUAL: return constant(node, l == r);
+            case TokenType::BANG_EQUAL: return constant(node, l != r);
+            default: break;
+        }
+    }
+
+    switch (node->op) {
+        case TokenType::MINUS:
+            return numericBinary(std::move(left), std::move(right), leftConst, rightConst, loc,
+                                 [](double l, double r) { return Value(l - r); });
+        case TokenType::STAR:
+            return numericBinary(std::move(left), std::move(right), leftConst, rightConst, loc,
+                                 [](double l, double r) { return Value(l * r); });
+        case TokenType::GREATER:
+            return numericBinary(std::move(left), std::move(right), leftConst, rightConst, loc,
+                                 [](double l, double r) { return Value(l > r); });
+        case TokenType::GREATER_EQUAL:
+            return numericBinary(std::move(left), std::move(right), leftConst, rightConst, loc,
+                                 [](double l, double r) { return Value(l >= r); });
+        case TokenType::LESS:
+            return numericBinary(std::move(left), std::move(right), leftConst, rightConst, loc,
+                                 [](double l, double r) { return Value(l < r); });
+        case TokenType::LESS_EQUAL:
+            return numericBinary(std::move(left), std::move(right), leftConst, rightConst, loc,
+                                 [](double l, double r) { return Value(l <= r); });
+        case TokenType::PLUS:
+            // Sayı sabiti olan bir işlenen string toplamayı dışarıda bırakır
+            if ((leftConst && isNumber(*leftConst)) || (rightConst && isNumber(*rightConst))) {
+                return [left = std::move(left), right = std::move(right), loc](Interpreter& in) -> Value {
+                    Value l = left(in);
+                    Value r = right(in);
+                    if (isNumber(l) && isNumber(r)) return std::get<double>(l) + std::get<double>(r);
+                    return in.binaryOp(TokenType::PLUS, loc, l, r); // Hata mesajı ağaç yürütücüsüyle aynı
+                };
+            }
+            break;
+        case TokenType::EQUAL_EQUAL:
+            return [left = std::move(left), right = std::move(right)](Interpreter& in) -> Value {
+                Value l = left(in);
+                Value r = right(in);
+                return in.isEqual(l, r);
+            };
+        case TokenType::BANG_EQUAL:
+            return [left = std::move(left), right = std::move(right)](Interpreter& in) -> Value {
+                Value l = left(in);
+                Value r = right(in);
+                return !in.isEqual(l, r);
+            };
+        default:
+            break;
+    }
+
+    // Bölme (sıfır denetimi) ve türü bilinmeyen toplama genel yoldan
+    return [left = std::move(left), right = std::move(right), op = node->op, loc](Interpreter& in) -> Value {
+        Value l = left(in);
+        Value r = right(in);
+        return in.binaryOp(op, loc, l, r);
+    };
+}
+
+CompiledExpr ClosureCompiler::visitCallExpr(std::shared_ptr<CallExpr> node) {
+    CompiledExpr callee = expr(node->callee);
+    std::vector<CompiledExpr> arguments;
+    arguments.reserve(node->arguments.size());
+    for (const auto& argument : node->arguments) arguments.push_back(expr(argument));
+
+    return [callee = std::move(callee), arguments = std::move(arguments), paren = node->paren](Interpreter& in) -> Value {
+        Value function = callee(in);
+        GcStackRoot calleeRoot(in.gc, function);
+        std::vector<Value> values;
+        GcStackRoot argumentRoots(in.gc, values);
+        values.reserve(arguments.size());
+        for (const auto& argument : arguments) values.push_back(argument(in));
+        return in.callValue(function, values, paren);
+    };
+}
+
+CompiledExpr ClosureCompiler::visitGetExpr(std::shared_ptr<GetExpr> node) {
+    const std::string* name = &names().spelling(node->name);
+    return [object = expr(node->object), name, loc = node->loc](Interpreter& in) -> Value {
+        return in.getProperty(object(in), *name, loc);
+    };
+}
+
+CompiledExpr ClosureCompiler::visitGroupingExpr(std::shared_ptr<GroupingExpr> node) {
+    CompiledExpr inner = expr(node->expression);
+    if (const Value* value = constantOf(node->expression)) constants[node.get()] = *value;
+    return inner; // Parantezlerin çalışma zamanında karşılığı yok
+}
+
+CompiledExpr ClosureCompiler::visitIndexExpr(std::shared_ptr<IndexExpr> node) {
+    return [object = expr(node->object), index = expr(node->index), bracket = node->bracket](Interpreter& in) -> Value {
+        Value list = object(in);
+        GcStackRoot listRoot(in.gc, list);
+        Value position = index(in);
+        return in.indexValue(list, position, bracket);
+    };
+}
+
+CompiledExpr ClosureCompiler::visitLiteralExpr(std::shared_ptr<LiteralExpr> node) {
+    return constant(node, std::visit([](const auto& value) -> Value { return value; }, node->value));
+}
+
+CompiledExpr ClosureCompiler::visitLogicalExpr(std::shared_ptr<LogicalExpr> node) {
+    CompiledExpr left = expr(node->left);
+    CompiledExpr right = expr(node->right);
+    if (node->op == TokenType::OR) {
+        return [left = std::move(left), right = std::move(right)](Interpreter& in) -> Value {
+            Value l = left(in);
+            if (in.isTruthy(l)) return l;
+            return right(in);
+        };
+    }
+    return [left = std::move(left), right = std::move(right)](Interpreter& in) -> Value {
+        Value l = left(in);
+        if (!in.isTruthy(l)) return l;
+        return right(in);
+    };
+}
+
+CompiledExpr ClosureCompiler::visitSetExpr(std::shared_ptr<SetExpr> node) {
+    const std::string* name = &names().spelling(node->name);
+    return [object = expr(node->object), value = expr(node->value), name, loc = node->loc](Interpreter& in) -> Value {
+        Value target = object(in);
+        GcStackRoot targetRoot(in.gc, target);
+        std::shared_ptr<CCubeInstance> instance = in.instanceForSet(target, loc);
+        Value result = value(in);
+        instance->set(*name, result);
+        return result;
+    };
+}
+
+CompiledExpr ClosureCompiler::visitSuperExpr(std::shared_ptr<SuperExpr> node) {
+    return [node](Interpreter& in) -> Value { return in.visitSuperExpr(node); };
+}
+
+CompiledExpr ClosureCompiler::visitThisExpr(std::shared_ptr<ThisExpr> node) {
+    return [loc = node->keyword](Interpreter& in) -> Value {
+        static const std::string thisName = "this";
+        return in.lookUpVariable(thisName, loc);
+    };
+}
+
+CompiledExpr ClosureCompiler::visitUnaryExpr(std::shared_ptr<UnaryExpr> node) {
+    CompiledExpr right = expr(node->right);
+    const Value* rightConst = constantOf(node->right);
+    if (node->op == TokenType::MINUS) {
+        if (rightConst && isNumber(*rightConst)) return constant(node, -std::get<double>(*rightConst));
+        return [right = std::move(right), loc = node->loc](Interpreter& in) -> Value {
+            Value r = right(in);
+            if (!isNumber(r)) in.checkNumberOperand(loc, r);
+            return -std::get<double>(r);
+        };
+    }
+    if (node->op == TokenType::BANG) {
+        return [right = std::move(right)](Interpreter& in) -> Value { return !in.isTruthy(right(in)); };
+    }
+    return [right = std::move(right), op = node->op, loc = node->loc](Interpreter& in) -> Value {
+        return in.unaryOp(op, loc, right(in));
+    };
+}
+
+CompiledExpr ClosureCompiler::visitVariableExpr(std::shared_ptr<VariableExpr> node) {
+    const std::string* name = &names().spelling(node->name);
+    return [name, loc = node->loc](Interpreter& in) -> Value { return in.lookUpVariable(*name, loc); };
+}
+
+CompiledExpr ClosureCompiler::visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> node) {
+    std::vector<CompiledExpr> elements;
+    elements.reserve(node->elements.size());
+    for (const auto& element : node->elements) elements.push_back(expr(element));
+    return [elements = std::move(elements)](Interpreter& in) -> Value {
+        std::vector<Value> values;
+        GcStackRoot elementRoots(in.gc, values);
+        values.reserve(elements.size());
+        for (const auto& element : elements) values.push_back(element(in));
+        return in.gc.createList(values);
+    };
+}
+
+// --- Bildirimler ---
+
+CompiledStmt ClosureCompiler::visitBlockStmt(std::shared_ptr<BlockStmt> node) {
+    return [body = block(node->statements)](Interpreter& in) {
+        in.executeCompiledBlock(*body, in.newEnvironment(in.environment));
+    };
+}
+
+CompiledStmt ClosureCompiler::visitClassStmt(std::shared_ptr<ClassStmt> node) { return tree(node); }
+
+CompiledStmt ClosureCompiler::visitExprStmt(std::shared_ptr<ExprStmt> node) {
+    return [expression = expr(node->expression)](Interpreter& in) { expression(in); };
+}
+
+// Fonksiyon nesnesi kendi FunStmt'ini tutar; gövdesi ilk çağrıda ayrıca derlenir
+CompiledStmt ClosureCompiler::visitFunStmt(std::shared_ptr<FunStmt> node) { return tree(node); }
+
+CompiledStmt ClosureCompiler::visitIfStmt(std::shared_ptr<IfStmt> node) {
+    CompiledExpr condition = expr(node->condition);
+    CompiledStmt thenBranch = stmt(node->thenBranch);
+    if (node->elseBranch == nullptr) {
+        return [condition = std::move(condition), thenBranch = std::move(thenBranch)](Interpreter& in) {
+            if (in.isTruthy(condition(in))) thenBranch(in);
+        };
+    }
+    return [condition = std::move(condition), thenBranch = std::move(thenBranch),
+            elseBranch = stmt(node->elseBranch)](Interpreter& in) {
+        if (in.isTruthy(condition(in))) {
+            thenBranch(in);
+        } else {
+            elseBranch(in);
+        }
+    };
+}
+
+CompiledStmt ClosureCompiler::visitImportStmt(std::shared_ptr<ImportStmt> node) { return tree(node); }
+
+CompiledStmt ClosureCompiler::visitReturnStmt(std::shared_ptr<ReturnStmt> node) {
+    if (node->value == nullptr) {
+        return [](Interpreter&) { throw ReturnException(std::monostate{}); };
+    }
+    return [value = expr(node->value)](Interpreter& in) { throw ReturnException(value(in)); };
+}
+
+CompiledStmt ClosureCompiler::visitVarStmt(std::shared_ptr<VarStmt> node) {
+    const std::string* name = &names().spelling(node->name);
+    if (node->initializer == nullptr) {
+        return [name](Interpreter& in) { in.environment->define(*name, std::monostate{}); };
+    }
+    return [initializer = expr(node->initializer), name](Interpreter& in) {
+        Value value = initializer(in);
+        in.environment->define(*name, value);
+    };
+}
+
+CompiledStmt ClosureCompiler::visitWhileStmt(std::shared_ptr<WhileStmt> node) {
+    return [condition = expr(node->condition), body = stmt(node->body)](Interpreter& in) {
+        while (in.isTruthy(condition(in))) body(in);
+    };
+}
+
+CompiledStmt ClosureCompiler::visitMatchStmt(std::shared_ptr<MatchStmt> node) { return tree(node); }
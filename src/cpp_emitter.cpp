@@ -0,0 +1,453 @@
+#include "cpp_emitter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+const char* tokenTypeName(TokenType type) {
+    switch (type) {
+        case TokenType::MINUS: return "TokenType::MINUS";
+        case TokenType::PLUS: return "TokenType::PLUS";
+        case TokenType::SLASH: return "TokenType::SLASH";
+        case TokenType::STAR: return "TokenType::STAR";
+        case TokenType::BANG: return "TokenType::BANG";
+        case TokenType::BANG_EQUAL: return "TokenType::BANG_EQUAL";
+        case TokenType::EQUAL_EQUAL: return "TokenType::EQUAL_EQUAL";
+        case TokenType::GREATER: return "TokenType::GREATER";
+        case TokenType::GREATER_EQUAL: return "TokenType::GREATER_EQUAL";
+        case TokenType::LESS: return "TokenType::LESS";
+        case TokenType::LESS_EQUAL: return "TokenType::LESS_EQUAL";
+        default: throw std::runtime_error("--emit-cpp: desteklenmeyen operatör.");
+    }
+}
+
+} // namespace
+
+std::string CppEmitter::emit(const std::vector<StmtPtr>& program, const std::string& moduleName,
+                             const std::string& sourcePath) {
+    CppEmitter emitter;
+    emitter.functions.push_back(std::make_unique<Function>());
+    emitter.current().signature = "// Modülün üst düzey bildirimleri\nvoid moduleBody(Interpreter& in)";
+    emitter.current().returnsValue = false;
+    emitter.statements(program);
+
+    std::ostringstream out;
+    out << "// " << sourcePath << " dosyasından c-cube --emit-cpp ile üretildi; elle düzenlemeyin.\n"
+        << "// Ana programla birlikte derlendiğinde '" << moduleName << "' modülü olarak kaydolur.\n"
+        << "#include \"aot_runtime.h\"\n\nnamespace {\n\n";
+    for (const auto& definition : emitter.constantDefinitions) out << definition << "\n";
+    if (!emitter.constantDefinitions.empty()) out << "\n";
+    for (const auto& definition : emitter.finished) out << definition << "\n";
+    const Function& body = *emitter.functions.back();
+    out << body.signature << " {\n" << body.code.str() << "}\n\n"
+        << "const AotRuntime::Registration registration(" << quote(moduleName) << ", &moduleBody);\n\n"
+        << "} // namespace\n";
+    return out.str();
+}
+
+// --- Yazım yardımcıları ---
+
+std::string CppEmitter::expr(const ExprPtr& node) {
+    return node->accept(static_cast<ExprVisitor<std::string>&>(*this));
+}
+
+void CppEmitter::stmt(const StmtPtr& node) {
+    node->accept(static_cast<StmtVisitor<void>&>(*this));
+}
+
+void CppEmitter::statements(const std::vector<StmtPtr>& body) {
+    for (const auto& statement : body) stmt(statement);
+}
+
+void CppEmitter::scopedBody(const StmtPtr& node) {
+    if (auto block = std::dynamic_pointer_cast<BlockStmt>(node)) {
+        scope();
+        statements(block->statements);
+        return;
+    }
+    stmt(node);
+}
+
+std::string CppEmitter::function(const std::string& comment, const std::vector<StmtPtr>& body) {
+    std::string cppName = "f" + std::to_string(functionCount++);
+    functions.push_back(std::make_unique<Function>());
+    current().signature = "// " + comment + "\nValue " + cppName + "(Interpreter& in)";
+    statements(body);
+    if (body.empty() || !std::dynamic_pointer_cast<ReturnStmt>(body.back())) line("return Value();");
+
+    std::unique_ptr<Function> done = std::move(functions.back());
+    functions.pop_back();
+    finished.push_back(done->signature + " {\n" + done->code.str() + "}\n");
+    return cppName;
+}
+
+std::string CppEmitter::functionDescriptor(const FunStmt& declaration) {
+    if (!declaration.bodyParsed) {
+        throw std::runtime_error("--emit-cpp: fonksiyon gövdesi çözümlenmemiş (AST --eager-parse ile parse edilmeli).");
+    }
+    const std::string& functionName = names().spelling(declaration.name);
+    std::string body = function("fun " + functionName, declaration.body);
+
+    std::string params;
+    for (size_t i = 0; i < declaration.params.size(); ++i) {
+        if (i > 0) params += ", ";
+        params += quote(names().spelling(declaration.params[i]));
+    }
+    return "AotRuntime::function(" + quote(functionName) + ", " + at(declaration.loc) + ", {" + params + "}, &" +
+           body + ")";
+}
+
+void CppEmitter::line(const std::string& text) {
+    current().code << std::string(current().indent * 4, ' ') << text << "\n";
+}
+
+void CppEmitter::open(const std::string& text) {
+    line(text.empty() ? "{" : text + " {");
+    ++current().indent;
+}
+
+void CppEmitter::close(const std::string& text) {
+    --current().indent;
+    line(text);
+    if (text.back() == '{') ++current().indent;
+}
+
+std::string CppEmitter::temp() {
+    return "t" + std::to_string(current().temps++);
+}
+
+void CppEmitter::scope() {
+    line("AotRuntime::Scope scope" + std::to_string(current().temps++) + "(in);");
+}
+
+// Geçici değişkendeki ara sonucu sonraki işlenenler değerlendirilirken GC kökü yapar
+// (literal'ler nesne tutmaz ve adlandırılmış değildir, atlanır)
+void CppEmitter::root(const std::string& value) {
+    if (value.empty() || value[0] != 't') return;
+    line("AotRuntime::Root root" + std::to_string(current().temps++) + "(in, " + value + ");");
+}
+
+std::string CppEmitter::descriptor() {
+    return "d" + std::to_string(descriptorCount++);
+}
+
+std::string CppEmitter::name(Name name) {
+    return constant(names().spelling(name));
+}
+
+std::string CppEmitter::constant(const std::string& text) {
+    auto it = constants.find(text);
+    if (it != constants.end()) return it->second;
+    std::string cppName = "k" + std::to_string(constantDefinitions.size());
+    constantDefinitions.push_back("const std::string " + cppName + "(" + quote(text) + ", " +
+                                  std::to_string(text.size()) + ");");
+    constants.emplace(text, cppName);
+    return cppName;
+}
+
+std::string CppEmitter::at(SourceLoc loc) {
+    if (!loc.isValid()) return "SourceLoc{}";
+    return "AotRuntime::at(" + std::to_string(sourceMap().line(loc)) + ")";
+}
+
+// ASCII dışı ve kontrol baytları sekizlik kaçışla yazılır (en fazla üç hane, ardından gelen
+// rakamlarla karışmaz)
+std::string CppEmitter::quote(const std::string& text) {
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            case '\r': out += "\\r"; break;
+            case '?': out += "\\?"; break; // Trigraph'lara karşı
+            default:
+                if (c < 0x20 || c >= 0x7f) {
+                    char escaped[5];
+                    std::snprintf(escaped, sizeof(escaped), "\\%03o", c);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    return out + "\"";
+}
+
+// Tam sayılar okunaklı, diğerleri kayıpsız (onaltılık kayan nokta) yazılır
+std::string CppEmitter::number(double value) {
+    if (std::isnan(value)) return "std::numeric_limits<double>::quiet_NaN()";
+    if (std::isinf(value)) return value > 0 ? "std::numeric_limits<double>::infinity()"
+                                            : "-std::numeric_limits<double>::infinity()";
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        return std::to_string(static_cast<long long>(value)) + ".0";
+    }
+    std::ostringstream out;
+    out << std::hexfloat << value;
+    return out.str();
+}
+
+// --- İfadeler ---
+
+std::string CppEmitter::visitAssignExpr(std::shared_ptr<AssignExpr> node) {
+    std::string value = expr(node->value);
+    line("AotRuntime::assign(in, " + name(node->name) + ", " + value + ", " + at(node->loc) + ");");
+    return value;
+}
+
+std::string CppEmitter::visitBinaryExpr(std::shared_ptr<BinaryExpr> node) {
+    std::string left = expr(node->left);
+    std::string right = expr(node->right);
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::binary(in, " + tokenTypeName(node->op) + ", " + at(node->loc) + ", " +
+         left + ", " + right + ");");
+    return result;
+}
+
+std::string CppEmitter::visitCallExpr(std::shared_ptr<CallExpr> node) {
+    std::string callee = expr(node->callee);
+    root(callee);
+    std::string arguments;
+    for (size_t i = 0; i < node->arguments.size(); ++i) {
+        if (i > 0) arguments += ", ";
+        std::string argument = expr(node->arguments[i]);
+        if (i + 1 < node->arguments.size()) root(argument); // Sonuncudan sonra ayırma yok
+        arguments += argument;
+    }
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::call(in, " + callee + ", {" + arguments + "}, " + at(node->paren) + ");");
+    return result;
+}
+
+std::string CppEmitter::visitGetExpr(std::shared_ptr<GetExpr> node) {
+    std::string object = expr(node->object);
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::getProperty(in, " + object + ", " + name(node->name) + ", " +
+         at(node->loc) + ");");
+    return result;
+}
+
+std::string CppEmitter::visitGroupingExpr(std::shared_ptr<GroupingExpr> node) {
+    return expr(node->expression);
+}
+
+std::string CppEmitter::visitIndexExpr(std::shared_ptr<IndexExpr> node) {
+    std::string object = expr(node->object);
+    root(object);
+    std::string index = expr(node->index);
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::index(in, " + object + ", " + index + ", " + at(node->bracket) + ");");
+    return result;
+}
+
+// Literal'ler yan etkisiz olduğu için geçici değişkene yazılmaz, kullanıldıkları yerde kurulur
+std::string CppEmitter::visitLiteralExpr(std::shared_ptr<LiteralExpr> node) {
+    return std::visit([this](const auto& value) -> std::string {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            return value ? "Value(true)" : "Value(false)";
+        } else if constexpr (std::is_same_v<T, double>) {
+            return "Value(" + number(value) + ")";
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return "Value(" + constant(value) + ")";
+        } else {
+            return "Value()";
+        }
+    }, node->value);
+}
+
+std::string CppEmitter::visitLogicalExpr(std::shared_ptr<LogicalExpr> node) {
+    std::string left = expr(node->left);
+    std::string result = temp();
+    line("Value " + result + " = " + left + ";");
+    // or: sol doğruysa, and: sol yanlışsa sağ taraf hiç değerlendirilmez
+    open(std::string("if (") + (node->op == TokenType::OR ? "!" : "") + "AotRuntime::truthy(in, " + result + "))");
+    std::string right = expr(node->right);
+    line(result + " = " + right + ";");
+    close();
+    return result;
+}
+
+std::string CppEmitter::visitSetExpr(std::shared_ptr<SetExpr> node) {
+    std::string object = expr(node->object);
+    root(object);
+    std::string instance = temp();
+    // Nesne, değer hesaplanmadan önce denetlenir (yorumlayıcıdaki sıra)
+    line("std::shared_ptr<CCubeInstance> " + instance + " = AotRuntime::instanceForSet(in, " + object + ", " +
+         at(node->loc) + ");");
+    std::string value = expr(node->value);
+    line(instance + "->set(" + name(node->name) + ", " + value + ");");
+    return value;
+}
+
+std::string CppEmitter::visitSuperExpr(std::shared_ptr<SuperExpr> node) {
+    std::string superExpr = descriptor();
+    line("static const ExprPtr " + superExpr + " = AotRuntime::super(" + at(node->keyword) + ", " +
+         quote(names().spelling(node->method)) + ", " + at(node->methodLoc) + ");");
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::evaluate(in, " + superExpr + ");");
+    return result;
+}
+
+std::string CppEmitter::visitThisExpr(std::shared_ptr<ThisExpr> node) {
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::get(in, " + constant("this") + ", " + at(node->keyword) + ");");
+    return result;
+}
+
+std::string CppEmitter::visitUnaryExpr(std::shared_ptr<UnaryExpr> node) {
+    std::string right = expr(node->right);
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::unary(in, " + tokenTypeName(node->op) + ", " + at(node->loc) + ", " +
+         right + ");");
+    return result;
+}
+
+std::string CppEmitter::visitVariableExpr(std::shared_ptr<VariableExpr> node) {
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::get(in, " + name(node->name) + ", " + at(node->loc) + ");");
+    return result;
+}
+
+std::string CppEmitter::visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> node) {
+    std::string elements;
+    for (size_t i = 0; i < node->elements.size(); ++i) {
+        if (i > 0) elements += ", ";
+        std::string element = expr(node->elements[i]);
+        if (i + 1 < node->elements.size()) root(element);
+        elements += element;
+    }
+    std::string result = temp();
+    line("Value " + result + " = AotRuntime::list(in, {" + elements + "});");
+    return result;
+}
+
+// --- Bildirimler ---
+
+void CppEmitter::visitBlockStmt(std::shared_ptr<BlockStmt> node) {
+    open("");
+    scopedBody(node);
+    close();
+}
+
+void CppEmitter::visitClassStmt(std::shared_ptr<ClassStmt> node) {
+    std::string superclass = "nullptr";
+    std::string superclassLoc = "SourceLoc{}";
+    if (node->superclass != nullptr) {
+        auto variable = std::dynamic_pointer_cast<VariableExpr>(node->superclass);
+        if (!variable) throw std::runtime_error("--emit-cpp: üst sınıf bir isim olmalıdır.");
+        superclass = quote(names().spelling(variable->name));
+        superclassLoc = at(variable->loc);
+    }
+
+    // Metot gövdeleri önce yazılır; sınıf düğümü ilk yürütmede kurulur
+    std::vector<std::string> methods;
+    for (const auto& method : node->methods) methods.push_back(functionDescriptor(*method));
+
+    std::string classStmt = descriptor();
+    std::string header = "static const StmtPtr " + classStmt + " = AotRuntime::classDeclaration(" +
+                         quote(names().spelling(node->name)) + ", " + at(node->loc) + ", " + superclass + ", " +
+                         superclassLoc + ", {";
+    if (methods.empty()) {
+        line(header + "});");
+    } else {
+        line(header);
+        current().indent += 2;
+        for (size_t i = 0; i < methods.size(); ++i) line(methods[i] + (i + 1 < methods.size() ? "," : "});"));
+        current().indent -= 2;
+    }
+    line("AotRuntime::execute(in, " + classStmt + ");");
+}
+
+void CppEmitter::visitExprStmt(std::shared_ptr<ExprStmt> node) {
+    expr(node->expression);
+}
+
+void CppEmitter::visitFunStmt(std::shared_ptr<FunStmt> node) {
+    std::string declaration = functionDescriptor(*node);
+    std::string funStmt = descriptor();
+    line("static const std::shared_ptr<FunStmt> " + funStmt + " = " + declaration + ";");
+    line("AotRuntime::execute(in, " + funStmt + ");");
+}
+
+void CppEmitter::visitIfStmt(std::shared_ptr<IfStmt> node) {
+    std::string condition = expr(node->condition);
+    open("if (AotRuntime::truthy(in, " + condition + "))");
+    scopedBody(node->thenBranch);
+    if (node->elseBranch != nullptr) {
+        close("} else {");
+        scopedBody(node->elseBranch);
+    }
+    close();
+}
+
+void CppEmitter::visitImportStmt(std::shared_ptr<ImportStmt> node) {
+    std::string importStmt = descriptor();
+    line("static const StmtPtr " + importStmt + " = AotRuntime::import(" + quote(names().spelling(node->moduleName)) +
+         ", " + at(node->loc) + ", " + quote(node->alias) + ");");
+    line("AotRuntime::execute(in, " + importStmt + ");");
+}
+
+// Fonksiyonlarda return C++ dönüşüdür (açık kapsamlar yıkıcılarıyla kapanır). Modül gövdesinde
+// yorumlayıcıdaki gibi ReturnException fırlatılır.
+void CppEmitter::visitReturnStmt(std::shared_ptr<ReturnStmt> node) {
+    std::string value = node->value != nullptr ? expr(node->value) : "Value()";
+    if (current().returnsValue) {
+        line("return " + value + ";");
+    } else {
+        line("throw ReturnException(" + value + ");");
+    }
+}
+
+void CppEmitter::visitVarStmt(std::shared_ptr<VarStmt> node) {
+    std::string value = node->initializer != nullptr ? expr(node->initializer) : "Value()";
+    line("AotRuntime::define(in, " + name(node->name) + ", " + value + ");");
+}
+
+void CppEmitter::visitWhileStmt(std::shared_ptr<WhileStmt> node) {
+    open("while (true)");
+    std::string condition = expr(node->condition);
+    line("if (!AotRuntime::truthy(in, " + condition + ")) break;");
+    scopedBody(node->body);
+    close();
+}
+
+// Durumlar sırayla denenir; eşleşen durumun gövdesinden sonra do/while'dan çıkılır. Yorumlayıcıda
+// olduğu gibi default ve değişken desenleri her zaman eşleştiği için sonraki durumlar yazılmaz;
+// diğer desen türleri hiç eşleşmez.
+void CppEmitter::visitMatchStmt(std::shared_ptr<MatchStmt> node) {
+    std::string subject = expr(node->subject);
+    open("do");
+    for (const auto& matchCase : node->cases) {
+        if (matchCase.pattern == nullptr) { // default
+            stmt(matchCase.body);
+            break;
+        }
+        if (std::dynamic_pointer_cast<LiteralExpr>(matchCase.pattern)) {
+            std::string pattern = expr(matchCase.pattern);
+            open("if (AotRuntime::equal(in, " + subject + ", " + pattern + "))");
+            stmt(matchCase.body);
+            line("break;");
+            close();
+        } else if (auto variable = std::dynamic_pointer_cast<VariableExpr>(matchCase.pattern)) {
+            if (auto block = std::dynamic_pointer_cast<BlockStmt>(matchCase.body)) {
+                // Desen değişkeni ve gövdenin bildirimleri aynı ortamdadır
+                open("");
+                scope();
+                line("AotRuntime::define(in, " + name(variable->name) + ", " + subject + ");");
+                statements(block->statements);
+                close();
+            } else {
+                stmt(matchCase.body);
+                line("throw AotRuntime::error(in, " + at(variable->loc) + ", " +
+                     quote("Match case body'si bir blok olmalıdır.") + ");");
+            }
+            break;
+        }
+    }
+    close("} while (false);");
+}
@@ -1,39 +1,51 @@
 #include "environment.h"
 
 // Constructor
-Environment::Environment() : enclosing(nullptr) {}
+Environment::Environment(Allocator& allocator)
+    : enclosing(nullptr), allocator(&allocator),
+      values(0, std::hash<std::string>(), std::equal_to<std::string>(),
+             ValueMap::allocator_type(allocator, AllocCategory::Environment)) {}
 
 // Constructor for nested environments
 Environment::Environment(std::shared_ptr<Environment> enclosing)
-    : enclosing(enclosing) {}
+    : enclosing(enclosing), allocator(enclosing != nullptr ? &enclosing->getAllocator() : &defaultAllocator()),
+      values(0, std::hash<std::string>(), std::equal_to<std::string>(),
+             ValueMap::allocator_type(*allocator, AllocCategory::Environment)) {}
 
 // Defines a new variable in the current environment
 void Environment::define(const std::string& name, Value value) {
+    if (writeBarrier != nullptr) noteStore(value);
     values[name] = value;
 }
 
 // Assigns a value to an existing variable, searching up the scope chain
 void Environment::assign(const Token& name, Value value) {
-    if (values.count(name.lexeme)) {
-        values[name.lexeme] = value;
-        return;
-    }
-    if (enclosing != nullptr) {
-        enclosing->assign(name, value);
-        return;
+    assign(std::string(name.lexeme), std::move(value), SourceLoc::fromLine(name.line));
+}
+
+void Environment::assign(const std::string& name, Value value, SourceLoc loc) {
+    for (Environment* env = this; env != nullptr; env = env->enclosing.get()) {
+        auto it = env->values.find(name);
+        if (it != env->values.end()) {
+            if (writeBarrier != nullptr) env->noteStore(value);
+            it->second = std::move(value);
+            return;
+        }
     }
-    throw RuntimeException(name, "Tanımlanmamış değişken '" + name.lexeme + "'.");
+    throw RuntimeException(sourceMap().token(loc), "Tanımlanmamış değişken '" + name + "'.");
 }
 
 // Retrieves the value of a variable, searching up the scope chain
 Value Environment::get(const Token& name) {
-    if (values.count(name.lexeme)) {
-        return values.at(name.lexeme);
-    }
-    if (enclosing != nullptr) {
-        return enclosing->get(name);
+    return get(std::string(name.lexeme), SourceLoc::fromLine(name.line));
+}
+
+Value Environment::get(const std::string& name, SourceLoc loc) {
+    for (Environment* env = this; env != nullptr; env = env->enclosing.get()) {
+        auto it = env->values.find(name);
+        if (it != env->values.end()) return it->second;
     }
-    throw RuntimeException(name, "Tanımlanmamış değişken '" + name.lexeme + "'.");
+    throw RuntimeException(sourceMap().token(loc), "Tanımlanmamış değişken '" + name + "'.");
 }
 
 // Helper method to find an ancestor environment at a given distance
@@ -56,7 +68,9 @@ Value Environment::getAt(int distance, const std::string& name) {
 
 // Assigns a value to a variable at a specific scope distance
 void Environment::assignAt(int distance, const Token& name, Value value) {
-    ancestor(distance)->values[name.lexeme] = value;
+    std::shared_ptr<Environment> target = ancestor(distance);
+    if (writeBarrier != nullptr) target->noteStore(value);
+    target->values[std::string(name.lexeme)] = value;
 }
 
 // Checks if the current environment contains a variable
@@ -64,6 +78,10 @@ bool Environment::contains(const std::string& name) const {
     return values.count(name);
 }
 
+void Environment::noteStore(const Value& value) {
+    if (std::holds_alternative<ObjPtr>(value)) rememberEnvironmentStore(*writeBarrier, this, value);
+}
+
 // Returns the enclosing environment
 std::shared_ptr<Environment> Environment::getEnclosing() const {
     return enclosing;
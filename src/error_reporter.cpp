@@ -18,7 +18,7 @@ void ErrorReporter::error(const Token& token, const std::string& message) {
     if (token.type == TokenType::EOF_TOKEN) {
         report(token.line, " sonunda", message); // Dosya sonunda hata
     } else {
-        report(token.line, " '" + token.lexeme + "' üzerinde", message); // Belirli bir token üzerinde hata
+        report(token.line, " '" + std::string(token.lexeme) + "' üzerinde", message); // Belirli bir token üzerinde hata
     }
 }
 
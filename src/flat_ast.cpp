@@ -0,0 +1,151 @@
+#include "flat_ast.h"
+
+namespace {
+
+using Index = FlatAst::Index;
+using Kind = FlatAst::Kind;
+
+// Ağacı dolaşıp düğümleri FlatAst dizilerine ekler; her visit eklenen düğümün indeksini döndürür
+class FlatLowering : public ExprVisitor<Index>, public StmtVisitor<Index> {
+public:
+    explicit FlatLowering(FlatAst& flat) : flat(flat) {}
+
+    Index expr(const ExprPtr& node) {
+        if (node == nullptr) return FlatAst::NONE;
+        return node->accept(static_cast<ExprVisitor<Index>&>(*this));
+    }
+    Index stmt(const StmtPtr& node) {
+        if (node == nullptr) return FlatAst::NONE;
+        return node->accept(static_cast<StmtVisitor<Index>&>(*this));
+    }
+
+    // Çocuklar önce düzleştirilir (kendi listelerini ekleyebilirler), sonra indeksleri ardışık yazılır
+    template <typename Ptr, typename Lower>
+    Index list(const std::vector<Ptr>& nodes, Lower lower) {
+        std::vector<Index> children;
+        children.reserve(nodes.size());
+        for (const auto& node : nodes) children.push_back(lower(node));
+        Index begin = static_cast<Index>(flat.lists.size());
+        flat.lists.insert(flat.lists.end(), children.begin(), children.end());
+        return begin;
+    }
+    Index stmtList(const std::vector<StmtPtr>& nodes) {
+        return list(nodes, [this](const StmtPtr& node) { return stmt(node); });
+    }
+    Index exprList(const std::vector<ExprPtr>& nodes) {
+        return list(nodes, [this](const ExprPtr& node) { return expr(node); });
+    }
+
+    Index count(size_t size) const { return static_cast<Index>(size); }
+    Index op(TokenType type) const { return static_cast<Index>(type); }
+
+    // --- İfadeler ---
+    Index visitAssignExpr(std::shared_ptr<AssignExpr> node) override {
+        Index value = expr(node->value);
+        return flat.add(Kind::ASSIGN, node->name, value, 0, node->loc);
+    }
+    Index visitBinaryExpr(std::shared_ptr<BinaryExpr> node) override {
+        Index left = expr(node->left);
+        Index right = expr(node->right);
+        return flat.add(Kind::BINARY, op(node->op), left, right, node->loc);
+    }
+    Index visitCallExpr(std::shared_ptr<CallExpr> node) override {
+        Index callee = expr(node->callee);
+        Index args = exprList(node->arguments);
+        return flat.add(Kind::CALL, callee, args, count(node->arguments.size()), node->paren);
+    }
+    Index visitGetExpr(std::shared_ptr<GetExpr> node) override {
+        Index object = expr(node->object);
+        return flat.add(Kind::GET, object, node->name, 0, node->loc);
+    }
+    Index visitGroupingExpr(std::shared_ptr<GroupingExpr> node) override {
+        return expr(node->expression); // Parantezlerin çalışma zamanında karşılığı yok
+    }
+    Index visitIndexExpr(std::shared_ptr<IndexExpr> node) override {
+        Index object = expr(node->object);
+        Index index = expr(node->index);
+        return flat.add(Kind::INDEX, object, index, 0, node->bracket);
+    }
+    Index visitLiteralExpr(std::shared_ptr<LiteralExpr> node) override {
+        flat.constants.push_back(std::visit([](const auto& value) -> Value { return value; }, node->value));
+        return flat.add(Kind::LITERAL, count(flat.constants.size() - 1));
+    }
+    Index visitLogicalExpr(std::shared_ptr<LogicalExpr> node) override {
+        Index left = expr(node->left);
+        Index right = expr(node->right);
+        return flat.add(Kind::LOGICAL, op(node->op), left, right, node->loc);
+    }
+    Index visitSetExpr(std::shared_ptr<SetExpr> node) override {
+        Index object = expr(node->object);
+        Index value = expr(node->value);
+        return flat.add(Kind::SET, object, node->name, value, node->loc);
+    }
+    Index visitSuperExpr(std::shared_ptr<SuperExpr> node) override {
+        flat.treeExprs.push_back(node);
+        return flat.add(Kind::TREE_EXPR, count(flat.treeExprs.size() - 1));
+    }
+    Index visitThisExpr(std::shared_ptr<ThisExpr> node) override {
+        return flat.add(Kind::THIS, 0, 0, 0, node->keyword);
+    }
+    Index visitUnaryExpr(std::shared_ptr<UnaryExpr> node) override {
+        Index right = expr(node->right);
+        return flat.add(Kind::UNARY, op(node->op), right, 0, node->loc);
+    }
+    Index visitVariableExpr(std::shared_ptr<VariableExpr> node) override {
+        return flat.add(Kind::VARIABLE, node->name, 0, 0, node->loc);
+    }
+    Index visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> node) override {
+        Index elements = exprList(node->elements);
+        return flat.add(Kind::LIST, 0, elements, count(node->elements.size()));
+    }
+
+    // --- Bildirimler ---
+    Index visitBlockStmt(std::shared_ptr<BlockStmt> node) override {
+        Index statements = stmtList(node->statements);
+        return flat.add(Kind::BLOCK, 0, statements, count(node->statements.size()));
+    }
+    Index visitClassStmt(std::shared_ptr<ClassStmt> node) override { return tree(node); }
+    Index visitExprStmt(std::shared_ptr<ExprStmt> node) override {
+        return flat.add(Kind::EXPR_STMT, expr(node->expression));
+    }
+    Index visitFunStmt(std::shared_ptr<FunStmt> node) override { return tree(node); }
+    Index visitIfStmt(std::shared_ptr<IfStmt> node) override {
+        Index condition = expr(node->condition);
+        Index thenBranch = stmt(node->thenBranch);
+        Index elseBranch = stmt(node->elseBranch);
+        return flat.add(Kind::IF, condition, thenBranch, elseBranch);
+    }
+    Index visitImportStmt(std::shared_ptr<ImportStmt> node) override { return tree(node); }
+    Index visitReturnStmt(std::shared_ptr<ReturnStmt> node) override {
+        return flat.add(Kind::RETURN, expr(node->value), 0, 0, node->keyword);
+    }
+    Index visitVarStmt(std::shared_ptr<VarStmt> node) override {
+        Index initializer = expr(node->initializer);
+        return flat.add(Kind::VAR, node->name, initializer, 0, node->loc);
+    }
+    Index visitWhileStmt(std::shared_ptr<WhileStmt> node) override {
+        Index condition = expr(node->condition);
+        Index body = stmt(node->body);
+        return flat.add(Kind::WHILE, condition, body);
+    }
+    Index visitMatchStmt(std::shared_ptr<MatchStmt> node) override { return tree(node); }
+
+private:
+    // Fonksiyon ve sınıf bildirimleri CCubeFunction'a kendi FunStmt'lerini verir; ağaçta kalırlar
+    Index tree(StmtPtr node) {
+        flat.treeStmts.push_back(std::move(node));
+        return flat.add(Kind::TREE_STMT, count(flat.treeStmts.size() - 1));
+    }
+
+    FlatAst& flat;
+};
+
+} // namespace
+
+FlatAst FlatAst::lower(const std::vector<StmtPtr>& statements) {
+    FlatAst flat;
+    FlatLowering lowering(flat);
+    flat.rootBegin = lowering.stmtList(statements);
+    flat.rootCount = static_cast<Index>(statements.size());
+    return flat;
+}
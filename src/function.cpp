@@ -2,6 +2,7 @@
 #include "interpreter.h" // Interpreter sınıfını kullanıyoruz
 #include "environment.h" // Environment sınıfını kullanıyoruz
 #include "ast.h"       // AST düğümlerini kullanıyoruz (BlockStmt)
+#include "aot_runtime.h" // Önceden derlenmiş (--emit-cpp) gövdeler
 #include "value.h"     // ValuePtr kullanıyoruz
 #include <iostream>    // Hata ayıklama için
 
@@ -19,17 +20,36 @@ struct ReturnException : public std::runtime_error {
 
 // Fonksiyonu çağırma metodunun implementasyonu
 Value CCubeFunction::call(Interpreter& interpreter, const std::vector<Value>& arguments, std::shared_ptr<CCubeInstance> this_instance) {
-    std::shared_ptr<Environment> function_environment = std::make_shared<Environment>(closure);
+    // Sıcaklık sayacı: eşiğe ulaşan fonksiyonlar makine koduna derlenir (bkz. jit.h). Metotlar ve
+    // kurucular 'this' kullanabildiği için yorumlayıcıda kalır.
+    Interpreter::FunctionState& state = interpreter.functionState(declaration);
+    const uint32_t jitThreshold = interpreter.getJitThreshold();
+    if (jitThreshold != 0 && this_instance == nullptr && !isInitializer && state.aotBody == nullptr) {
+        if (state.callCount < jitThreshold) ++state.callCount;
+        Value result;
+        if (state.callCount >= jitThreshold && interpreter.callJitted(*declaration, state, arguments, result)) {
+            return result;
+        }
+    }
+    std::shared_ptr<Environment> function_environment =
+        allocateShared<Environment>(closure->getAllocator(), AllocCategory::Environment, closure);
     if (this_instance != nullptr) {
         function_environment->define("this", this_instance);
     }
     // Parametreleri yeni ortama tanımla
     for (size_t i = 0; i < declaration->params.size(); ++i) {
-        function_environment->define(declaration->params[i].lexeme, arguments[i]);
+        function_environment->define(names().spelling(declaration->params[i]), arguments[i]);
     }
     // ... (geri kalan fonksiyon gövdesini yürütme)
+    // Gövdesi C++'a derlenmiş fonksiyonlarda return istisna fırlatmaz, değer doğrudan döner
+    if (state.aotBody != nullptr) {
+        Value result = interpreter.executeAotBody(*state.aotBody, function_environment);
+        if (isInitializer) return this_instance; // Kurucular her zaman instance'ı döndürür
+        return result;
+    }
+    // Ön-parse edilmiş gövdenin AST'si (ve --exec=flat ise düz kodlaması) ilk çağrıda kurulur
     try {
-        interpreter.executeBlock(declaration->body->statements, function_environment);
+        interpreter.executeFunctionBody(*declaration, state, function_environment);
     } catch (const ReturnException& result) {
         if (isInitializer) return this_instance; // Kurucular her zaman instance'ı döndürür
         return result.value;
@@ -50,7 +70,7 @@ Value CCubeFunction::call(Interpreter& interpreter, const std::vector<Value>& ar
     for (size_t i = 0; i < parameters.size(); ++i) {
         // Parametre adı: parameters[i].lexeme
         // Argüman değeri: arguments[i]
-        environment->define(parameters[i].lexeme, arguments[i]);
+        environment->define(std::string(parameters[i].lexeme), arguments[i]);
     }
 
     // 3. Fonksiyon gövdesini çalıştır (genellikle bir BlockStmt)
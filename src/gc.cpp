@@ -1,77 +1,146 @@
 #include "gc.h"
 #include <iostream>
 #include <cassert> // Debug için
+#include <limits>  // Tutamaç etiketinin üst sınırı
+#include <new>     // Meta veri için yerinde new
+#include <string_view> // String birleştirme tablosunun anahtarı
+#include <unordered_map>
 
 // Constructor
-Gc::Gc() : youngGenCapacity(1024), oldGenCapacity(1024 * 10), youngGenCollections(0), bytesAllocated(0) {}
+Gc::Gc(Allocator& allocator) : allocator(allocator), youngGenCapacity(1024), oldGenCapacity(1024 * 10), youngGenCollections(0), bytesAllocated(0) {}
 
 // Yıkıcı: Kalan tüm nesneleri ve meta verilerini temizle
 Gc::~Gc() {
-    collectGarbage(true); // Tam bir koleksiyon yap
+    inFrame = false; // Açık kare kapanmadı
+    collectGarbage(true); // Tam bir koleksiyon yap (süren boşta döngüsü de biter)
+    if (Environment::writeBarrier == this) Environment::writeBarrier = nullptr;
     cleanupMetadata();    // Tüm meta verilerini temizle
 }
 
-// Yeni C-CUBE objeleri oluşturmak için genel fabrika metodları
-// Bu metodlar, oluşturulan nesnelerin genç nesle eklendiğinden emin olur.
-ObjPtr Gc::createObject(std::shared_ptr<CCubeFunction> func) {
-    ObjPtr obj = std::static_pointer_cast<Object>(func);
-    GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0); // Genç nesle ekle
-    youngGeneration.insert(obj);
+// Yeni oluşturulan nesneyi genç nesle kaydeder. Tüm fabrika metodlarının ortak yolu.
+ObjPtr Gc::trackObject(ObjPtr obj, size_t size) {
+    allocationCount++;
+    // Koleksiyonlar yeni nesne kaydedilmeden önce yapılır: henüz hiçbir köke bağlanmamış
+    // yeni nesnenin kendi ayırmasını tetikleyen koleksiyonda süpürülmemesi için.
+    if (stressInterval > 0 && allocationCount % stressInterval == 0 && !isPaused()) {
+        collectGarbage(stressFullCollections); // Stres modu: her N. ayırmada zorla
+    } else if (youngGeneration.size() >= youngGenCapacity) { // Basitçe obje sayısıyla kontrol
+        // Eğer genç nesil kapasitesini aştıysak, genç nesil koleksiyonu tetikle
+        if (isPaused()) {
+            collectionPending = true; // Kritik bölüm bitince (resume) toplanacak
+        } else {
+            collectGarbage(false); // Sadece genç nesil koleksiyonu
+        }
+    }
+
+    // Sığmazsa nesne kaydedilmez; çağıranın shared_ptr'ı bırakıldığında serbest kalır.
+    enforceHardLimit(size);
+
+    GcObjectMetadata* metadata;
+    if (inFrame) {
+        // Kare arenası: kare sonunda kaçmayanlar toplu bırakılır (bkz. endFrame)
+        metadata = newMetadata(obj, 2, size);
+        frameObjects.push_back(obj);
+    } else {
+        metadata = newMetadata(obj, 0, size); // Genç nesle ekle
+        youngGeneration.insert(obj);
+    }
     objectMetadata[obj] = metadata;
-    bytesAllocated += sizeof(CCubeFunction); // Rough size, actual size might vary
-    // Eğer genç nesil kapasitesini aştıysak, genç nesil koleksiyonu tetikle
-    if (youngGeneration.size() >= youngGenCapacity) { // Basitçe obje sayısıyla kontrol
-        collectGarbage(false); // Sadece genç nesil koleksiyonu
+    // Boşta artımlı döngü sürerken ayrılan nesneler canlı sayılır; işaretleme sürüyorsa
+    // oluşturulurken aldıkları referanslar da taransın diye gri listeye girerler
+    if (idlePhase == IdlePhase::Mark) {
+        shadeIdle(obj);
+    } else if (idlePhase == IdlePhase::Sweep) {
+        metadata->marked = true;
     }
+    bytesAllocated += size; // Rough size, actual size might vary
+    attachGrowthHook(obj, this);
+
+    notifySoftLimit();
     return obj;
 }
 
-ObjPtr Gc::createObject(std::shared_ptr<CCubeClass> klass) {
-    ObjPtr obj = std::static_pointer_cast<Object>(klass);
-    GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0); // Genç nesle ekle
-    youngGeneration.insert(obj);
-    objectMetadata[obj] = metadata;
-    bytesAllocated += sizeof(CCubeClass);
-    if (youngGeneration.size() >= youngGenCapacity) {
-        collectGarbage(false);
+Gc::GcObjectMetadata* Gc::newMetadata(ObjPtr obj, int generation, size_t size) {
+    void* memory = allocator.allocate(sizeof(GcObjectMetadata), alignof(GcObjectMetadata), AllocCategory::Collector);
+    return new (memory) GcObjectMetadata(std::move(obj), generation, size);
+}
+
+void Gc::deleteMetadata(GcObjectMetadata* metadata) {
+    metadata->~GcObjectMetadata();
+    allocator.deallocate(metadata, sizeof(GcObjectMetadata), alignof(GcObjectMetadata), AllocCategory::Collector);
+}
+
+// Sert heap sınırı: önce acil tam koleksiyon, yine sığmıyorsa çalışma zamanı hatası.
+// Acil koleksiyon pause() durumunu dikkate almaz; aksi halde süreç bellek dışı kalabilir.
+void Gc::enforceHardLimit(size_t pendingBytes) {
+    if (maxHeapBytes == 0 || bytesAllocated + pendingBytes <= maxHeapBytes) return;
+    emergencyCollections++;
+    collectGarbage(true);
+    if (bytesAllocated + pendingBytes > maxHeapBytes) {
+        throw GcHeapLimitError(bytesAllocated + pendingBytes, maxHeapBytes);
     }
-    return obj;
 }
 
-ObjPtr Gc::createObject(std::shared_ptr<CCubeInstance> instance) {
-    ObjPtr obj = std::static_pointer_cast<Object>(instance);
-    GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0); // Genç nesle ekle
-    youngGeneration.insert(obj);
-    objectMetadata[obj] = metadata;
-    bytesAllocated += sizeof(CCubeInstance);
-    if (youngGeneration.size() >= youngGenCapacity) {
-        collectGarbage(false);
+// Yumuşak sınır: host'a haber ver (ör. seviye verisini boşaltması veya uyarı basması için)
+void Gc::notifySoftLimit() {
+    if (softHeapLimitBytes > 0 && bytesAllocated > softHeapLimitBytes && !softLimitNotified) {
+        softLimitNotified = true;
+        if (softLimitCallback) softLimitCallback(*this, bytesAllocated);
     }
-    return obj;
 }
 
-ObjPtr Gc::createObject(std::shared_ptr<CCubeModule> module) {
-    ObjPtr obj = std::static_pointer_cast<Object>(module);
-    GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0); // Genç nesle ekle
-    youngGeneration.insert(obj);
-    objectMetadata[obj] = metadata;
-    bytesAllocated += sizeof(CCubeModule);
-    if (youngGeneration.size() >= youngGenCapacity) {
-        collectGarbage(false);
+void Gc::attachGrowthHook(const ObjPtr& obj, Gc* gc) {
+    if (obj->getType() == Object::ObjectType::LIST) {
+        static_cast<CCubeList*>(obj.get())->setHeap(gc);
+    } else if (obj->getType() == Object::ObjectType::INSTANCE) {
+        static_cast<CCubeInstance*>(obj.get())->setHeap(gc);
     }
-    return obj;
 }
 
-ObjPtr Gc::createObject(std::shared_ptr<BoundMethod> boundMethod) {
-    ObjPtr obj = std::static_pointer_cast<Object>(boundMethod);
-    GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0); // Genç nesle ekle
-    youngGeneration.insert(obj);
-    objectMetadata[obj] = metadata;
-    bytesAllocated += sizeof(BoundMethod);
-    if (youngGeneration.size() >= youngGenCapacity) {
-        collectGarbage(false);
+size_t Gc::payloadBytes(const Value& value) {
+    const CubeString* str = std::get_if<CubeString>(&value);
+    return str != nullptr ? str->size() : 0;
+}
+
+// Büyüme ayırmadaki boyutla aynı kayda işlenir; böylece sweep nesnenin güncel boyutunu düşer.
+// Nesne zaten değişmiştir, bu yüzden sınır aşılsa da kayıt geri alınmaz.
+void Gc::chargeGrowth(const Object* obj, std::ptrdiff_t delta) {
+    // Harita ObjPtr ile anahtarlıdır; sahipsiz (aliasing) bir işaretçi aramaya yeter
+    auto it = objectMetadata.find(ObjPtr(ObjPtr(), const_cast<Object*>(obj)));
+    if (it == objectMetadata.end() || delta == 0) return;
+    GcObjectMetadata* metadata = it->second;
+    if (delta < 0) {
+        size_t shrink = std::min(metadata->size, static_cast<size_t>(-delta));
+        metadata->size -= shrink;
+        bytesAllocated -= std::min(bytesAllocated, shrink);
+        return;
     }
-    return obj;
+    metadata->size += static_cast<size_t>(delta);
+    bytesAllocated += static_cast<size_t>(delta);
+    enforceHardLimit(0);
+    notifySoftLimit();
+}
+
+// Yeni C-CUBE objeleri oluşturmak için genel fabrika metodları
+// Bu metodlar, oluşturulan nesnelerin genç nesle eklendiğinden emin olur.
+ObjPtr Gc::createObject(std::shared_ptr<CCubeFunction> func) {
+    return trackObject(std::static_pointer_cast<Object>(func), sizeof(CCubeFunction));
+}
+
+ObjPtr Gc::createObject(std::shared_ptr<CCubeClass> klass) {
+    return trackObject(std::static_pointer_cast<Object>(klass), sizeof(CCubeClass));
+}
+
+ObjPtr Gc::createObject(std::shared_ptr<CCubeInstance> instance) {
+    return trackObject(std::static_pointer_cast<Object>(instance), sizeof(CCubeInstance));
+}
+
+ObjPtr Gc::createObject(std::shared_ptr<CCubeModule> module) {
+    return trackObject(std::static_pointer_cast<Object>(module), sizeof(CCubeModule));
+}
+
+ObjPtr Gc::createObject(std::shared_ptr<BoundMethod> boundMethod) {
+    return trackObject(std::static_pointer_cast<Object>(boundMethod), sizeof(BoundMethod));
 }
 
 ObjPtr Gc::createString(const std::string& str) {
@@ -80,14 +149,7 @@ ObjPtr Gc::createString(const std::string& str) {
     // Şimdilik, stringleri Value'nun doğrudan parçası olarak varsayıyoruz, bu yüzden GC'ye ihtiyaç duymayabilirler.
     // Eğer stringler de ObjPtr ise:
      ObjPtr obj = std::make_shared<CCubeString>(str); // Veya benzeri
-     GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0);
-     youngGeneration.insert(obj);
-     objectMetadata[obj] = metadata;
-     bytesAllocated += str.length(); // + sizeof(CCubeString)
-     if (youngGeneration.size() >= youngGenCapacity) {
-         collectGarbage(false);
-     }
-     return obj;
+     return trackObject(obj, str.length()); // + sizeof(CCubeString)
     // Geçici olarak nullptr döndürelim veya hata fırlatalım
     // Stringler şu anda Value içinde doğrudan tutulduğu için bu metot muhtemelen kullanılmayacak.
     throw std::runtime_error("Stringler şimdilik doğrudan Value içinde yönetiliyor, ObjPtr olarak değil.");
@@ -95,16 +157,18 @@ ObjPtr Gc::createString(const std::string& str) {
 
 
 ObjPtr Gc::createList(const std::vector<Value>& elements) {
-    std::shared_ptr<CCubeList> list_obj = std::make_shared<CCubeList>(elements);
-    ObjPtr obj = std::static_pointer_cast<Object>(list_obj);
-    GcObjectMetadata* metadata = new GcObjectMetadata(obj, 0); // Genç nesle ekle
-    youngGeneration.insert(obj);
-    objectMetadata[obj] = metadata;
-    bytesAllocated += sizeof(CCubeList) + elements.size() * sizeof(Value); // Rough size
-    if (youngGeneration.size() >= youngGenCapacity) {
-        collectGarbage(false);
-    }
-    return obj;
+    std::shared_ptr<CCubeList> list_obj = make<CCubeList>(elements);
+    size_t size = sizeof(CCubeList) + elements.size() * sizeof(Value); // Rough size
+    for (const Value& element : elements) size += payloadBytes(element); // Sonraki büyüme hesabıyla aynı ölçü
+    return trackObject(std::static_pointer_cast<Object>(list_obj), size);
+}
+
+ObjPtr Gc::createWeakRef(ObjPtr target) {
+    return trackObject(std::static_pointer_cast<Object>(make<CCubeWeakRef>(target)), sizeof(CCubeWeakRef));
+}
+
+ObjPtr Gc::createWeakMap() {
+    return trackObject(std::static_pointer_cast<Object>(make<CCubeWeakMap>()), sizeof(CCubeWeakMap));
 }
 
 // Kökleri ekleme (Interpreter yığını, global değişkenler, vb.)
@@ -144,30 +208,31 @@ void Gc::removeRoot(ObjPtr obj) {
 void Gc::collectGarbage(bool full_collection) {
      std::cout << "GC Başladı (" << (full_collection ? "Tam Koleksiyon" : "Genç Nesil") << ")..." << std::endl;
      printStats();
+    // Boşta artımlı döngü: süpürme aşamasındaki işaretler kesindir, kalan süpürme bitirilir.
+    // İşaretleme aşamasındaysa bu koleksiyon işaretleri baştan kuracağından döngü bırakılır.
+    if (idlePhase == IdlePhase::Sweep) {
+        finishIdleCycle();
+    } else if (idlePhase == IdlePhase::Mark) {
+        idleGrayObjects.clear();
+        idleSweepQueue.clear();
+        idleScannedEnvironments.clear();
+        idlePhase = IdlePhase::None;
+        updateWriteBarrier();
+    }
+    auto collectionStart = std::chrono::steady_clock::now();
+    size_t collectionWork = full_collection ? objectMetadata.size() : youngGeneration.size();
+    size_t bytesBeforeCollection = bytesAllocated;
 
     // 1. Mark Aşaması
     resetMarks(); // Tüm nesnelerin marklarını sıfırla
+    markRoots();
 
-    // Tüm kökleri işaretle
-    for (Value* root_val : roots) {
-        markValue(*root_val);
+    // Kare arenasındaki nesneler endFrame'e kadar canlı tutulur; referans verdikleri genç ve yaşlı
+    // nesneler de kare ortasındaki koleksiyonlarda süpürülmemeli
+    for (const ObjPtr& obj : frameObjects) {
+        markObject(obj);
     }
 
-    // Ek kökler: Global ortam, interpreter'ın mevcut ortamı, sınıf metotları vb.
-    // Environment'ın kendisi de kök olmalı (globals ve current environment)
-    // Interpreter'daki globals ve current environment'ı buraya manuel olarak eklemeliyiz.
-    // Veya Interpreter'ın Gc ile olan ilişkisini güçlendirmeliyiz.
-    // Şimdilik, Interpreter'ın global ve mevcut ortamlarını burada varsayalım.
-    // Interpreter'ın ortamlarını buraya root olarak eklemenin en iyi yolu, Interpreter'ın
-    // `current` ve `globals` ortamlarını `Gc::addRoot` metoduna iletmek olacaktır.
-    // Geçici olarak, Interpreter'daki environment'ları burada doğrudan marklamaya çalışalım:
-    
-    if (interpreter_globals != nullptr) markMap(interpreter_globals->getValues());
-    if (interpreter_environment != nullptr) markMap(interpreter_environment->getValues());
-    
-    // Bu, Gc sınıfının Interpreter'a bağımlı olmasına neden olur, bu iyi bir tasarım değildir.
-    // En iyi yol, Interpreter'ın tüm kökleri Gc'ye sağlamasıdır.
-
     // Sadece genç nesil koleksiyonu ise, yaşlı nesildeki nesnelerden genç nesile yapılan referansları da işaretle
     if (!full_collection) {
         for (const auto& entry : objectMetadata) {
@@ -181,6 +246,11 @@ void Gc::collectGarbage(bool full_collection) {
     }
 
 
+    // Zayıf tablolar: değerler yalnızca anahtarları canlıysa işaretlenir
+    markEphemerons(full_collection);
+    // İşaretleme bitti; ölecek hedeflere işaret eden zayıf referansları temizle
+    clearDeadWeakReferences(full_collection);
+
     // 2. Sweep Aşaması
     // Terfi işlemi sweep'ten önce olmalı
     if (!full_collection) { // Sadece genç nesil koleksiyonu ise terfi et
@@ -193,18 +263,620 @@ void Gc::collectGarbage(bool full_collection) {
         sweep(0); // Genç nesli temizle
         sweep(1); // Yaşlı nesli temizle
         youngGenCollections = 0; // Tam koleksiyondan sonra genç nesil koleksiyon sayacını sıfırla
+        fullCollections++;
+        if (stringInternEnabled) internStrings();
+        oldGenSizeAtLastFull = oldGeneration.size();
+        if (heapTrimEnabled) trimHeap(bytesBeforeCollection - std::min(bytesBeforeCollection, bytesAllocated));
+        recordCollectionCost(true, collectionStart, collectionWork);
     } else {
         sweep(0); // Sadece genç nesli temizle
+        recordCollectionCost(false, collectionStart, collectionWork); // İç içe tam koleksiyon hariç
         // Eğer genç nesil koleksiyonu belirli bir eşiğe ulaştıysa, tam koleksiyon tetikle
-        if (youngGenCollections >= 5) { // Örneğin 5 genç nesil koleksiyonu sonra
+        if (youngGenCollections >= fullCollectionInterval) {
             collectGarbage(true);
         }
     }
+    collectionPending = false;
+    if (softLimitNotified && bytesAllocated <= softHeapLimitBytes) {
+        softLimitNotified = false; // Kullanım sınırın altına indi; bir sonraki aşımda yine haber ver
+    }
+
+    if (verifyHeap) verify();
 
      std::cout << "GC Bitti. Kalan Nesneler: Genç=" << youngGeneration.size() << ", Yaşlı=" << oldGeneration.size() << std::endl;
      printStats();
 }
 
+// String birleştirme.
+// Sweep'ten sonra yalnızca canlı değerler kalır; her içerik için ilk görülen tampon kanonik olur,
+// eşit içerikli diğer değerler ona bağlanır. Değerin yeri değişmediğinden ortam yuvalarına ve liste
+// elemanlarına tutulan işaretçiler geçerli kalır. Son sahibini kaybeden tampon hemen serbest kalır.
+void Gc::internStrings() {
+    lastStringInternShared = 0;
+    lastStringInternBytes = 0;
+
+    using Table = std::unordered_map<std::string_view, CubeString::Payload, std::hash<std::string_view>,
+                                     std::equal_to<std::string_view>,
+                                     StlAllocator<std::pair<const std::string_view, CubeString::Payload>>>;
+    Table table(0, std::hash<std::string_view>(), std::equal_to<std::string_view>(),
+                collectorAllocator<std::pair<const std::string_view, CubeString::Payload>>());
+
+    auto visit = [&](Value& value) {
+        CubeString* str = std::get_if<CubeString>(&value);
+        if (str == nullptr) return;
+        const CubeString::Payload& payload = str->getPayload();
+        auto [it, inserted] = table.try_emplace(std::string_view(*payload), payload);
+        if (inserted) return;
+        size_t freed = payload.use_count() == 1 ? sizeof(std::string) + payload->capacity() : 0;
+        if (str->share(it->second)) {
+            lastStringInternShared++;
+            lastStringInternBytes += freed;
+        }
+    };
+
+    std::unordered_set<const Environment*> visitedEnvironments;
+    auto visitEnvironment = [&](Environment* env) {
+        for (; env != nullptr && visitedEnvironments.insert(env).second; env = env->getEnclosing().get()) {
+            for (auto& pair : env->getValuesMutable()) visit(pair.second);
+        }
+    };
+
+    if (interpreter_globals != nullptr) visitEnvironment(interpreter_globals->get());
+    if (interpreter_environment != nullptr) visitEnvironment(interpreter_environment->get());
+    for (const Environment* env : environmentRoots) visitEnvironment(const_cast<Environment*>(env));
+
+    for (const auto& [obj, metadata] : objectMetadata) {
+        // Sabitlenmiş nesnelerin elemanları native kod tarafından okunuyor olabilir; dokunma
+        if (metadata->pinCount > 0) continue;
+        switch (obj->getType()) {
+            case Object::ObjectType::LIST:
+                for (Value& element : std::static_pointer_cast<CCubeList>(obj)->getElementsMutable()) visit(element);
+                break;
+            case Object::ObjectType::INSTANCE:
+                for (auto& property : std::static_pointer_cast<CCubeInstance>(obj)->getPropertiesMutable()) {
+                    visit(property.second);
+                }
+                break;
+            case Object::ObjectType::WEAK_MAP:
+                for (auto& pair : std::static_pointer_cast<CCubeWeakMap>(obj)->getEntriesMutable()) {
+                    visit(pair.second.value);
+                }
+                break;
+            case Object::ObjectType::FUNCTION:
+                visitEnvironment(std::static_pointer_cast<CCubeFunction>(obj)->getClosure().get());
+                break;
+            case Object::ObjectType::C_CUBE_MODULE:
+                visitEnvironment(std::static_pointer_cast<CCubeModule>(obj)->getEnvironment().get());
+                break;
+            default:
+                break;
+        }
+    }
+    stringInternReclaimedBytes += lastStringInternBytes;
+    stringInternRuns++;
+}
+
+GcHandle Gc::handleOf(const ObjPtr& obj) {
+    auto it = objectMetadata.find(obj);
+    if (it == objectMetadata.end()) return GcHandle{};
+    GcObjectMetadata* metadata = it->second;
+    if (!metadata->handle.isNull()) return metadata->handle;
+
+    uint32_t index;
+    if (!freeHandleSlots.empty()) {
+        index = freeHandleSlots.back();
+        freeHandleSlots.pop_back();
+    } else {
+        if (handleSlots.size() > GcHandle::INDEX_MASK) return GcHandle{}; // Tablo dolu
+        index = static_cast<uint32_t>(handleSlots.size());
+        handleSlots.push_back(HandleSlot{});
+    }
+    HandleSlot& slot = handleSlots[index];
+    slot.metadata = metadata;
+    metadata->handle.bits = (static_cast<uint32_t>(slot.tag) << GcHandle::INDEX_BITS) | index;
+    return metadata->handle;
+}
+
+ObjPtr Gc::resolveHandle(GcHandle handle) const {
+    if (handle.isNull() || handle.index() >= handleSlots.size()) return nullptr;
+    const HandleSlot& slot = handleSlots[handle.index()];
+    if (slot.metadata == nullptr || slot.tag != handle.tag()) return nullptr; // Nesne ölmüş
+    // Boşta döngünün süpürmesini bekleyen nesne ölüdür; tutamaç onu yeniden erişilebilir yapmamalı
+    if (idlePhase == IdlePhase::Sweep && !slot.metadata->marked) return nullptr;
+    return slot.metadata->object;
+}
+
+void Gc::releaseHandle(GcObjectMetadata* metadata) {
+    if (metadata->handle.isNull()) return;
+    HandleSlot& slot = handleSlots[metadata->handle.index()];
+    slot.metadata = nullptr;
+    // Eski tutamaçlar bu yuvaya gelecek nesneye çözülmesin. Etiket 8 bittir: son değerine
+    // ulaşan yuva yeniden kullanılmaz, aksi halde 256 kullanım sonra eski bir tutamaç yeni nesneye
+    // çözülürdü (ABA). Emekli yuvalar 24-bit indeks alanından düşülür; tablo dolunca handleOf null döner.
+    if (slot.tag == std::numeric_limits<uint8_t>::max()) {
+        retiredHandleSlots++;
+    } else {
+        slot.tag++;
+        freeHandleSlots.push_back(metadata->handle.index());
+    }
+    metadata->handle = GcHandle{};
+}
+
+void Gc::pin(const ObjPtr& obj) {
+    if (obj == nullptr) return;
+    auto it = objectMetadata.find(obj);
+    if (it != objectMetadata.end()) it->second->pinCount++;
+    if (obj->getType() == Object::ObjectType::LIST) {
+        std::static_pointer_cast<CCubeList>(obj)->pin(); // Eleman tamponu da yerinde kalmalı
+    }
+}
+
+void Gc::unpin(const ObjPtr& obj) {
+    if (obj == nullptr) return;
+    auto it = objectMetadata.find(obj);
+    if (it != objectMetadata.end() && it->second->pinCount > 0) it->second->pinCount--;
+    if (obj->getType() == Object::ObjectType::LIST) {
+        std::static_pointer_cast<CCubeList>(obj)->unpin();
+    }
+}
+
+bool Gc::isPinned(const ObjPtr& obj) const {
+    auto it = objectMetadata.find(obj);
+    return it != objectMetadata.end() && it->second->pinCount > 0;
+}
+
+size_t Gc::pinnedObjectCount() const {
+    size_t count = 0;
+    for (const auto& entry : objectMetadata) {
+        if (entry.second->pinCount > 0) count++;
+    }
+    return count;
+}
+
+// Kare arenasını başlatır
+void Gc::beginFrame() {
+    inFrame = true;
+    updateWriteBarrier();
+}
+
+void Gc::updateWriteBarrier() {
+    if (inFrame || idlePhase == IdlePhase::Mark) {
+        Environment::writeBarrier = this;
+    } else if (Environment::writeBarrier == this) {
+        Environment::writeBarrier = nullptr;
+    }
+}
+
+void rememberEnvironmentStore(Gc& gc, const Environment* env, const Value& value) {
+    gc.rememberStore(env, value);
+}
+
+void Gc::rememberStore(const Environment* env, const Value& value) {
+    if (idlePhase == IdlePhase::Mark) shadeIdle(value);
+    if (!inFrame) return;
+    auto [it, inserted] = frameEnvironmentStores.try_emplace(env);
+    // Yeni kayıt ya da karede ölmüş bir ortamın adresini alan yeni ortam
+    if (inserted || it->second.expired()) it->second = env->weak_from_this();
+}
+
+// Kaçış kökleri: kare boyunca nesne yazılmış, hâlâ yaşayan ortamlar ve arena dışı nesneler,
+// yığın kökleri ve sabitlenmiş arena nesneleri. Karede yazılmamış bir ortam ya da nesne arena
+// nesnesine referans veremez. İşaretleme arena dışı nesnelere inmez.
+void Gc::markFrameEscapes() {
+    std::vector<ObjPtr> worklist;
+    auto reach = [&](const ObjPtr& obj) {
+        if (obj == nullptr) return;
+        auto it = objectMetadata.find(obj);
+        if (it == objectMetadata.end() || it->second->generation != 2 || it->second->marked) return;
+        it->second->marked = true;
+        worklist.push_back(obj);
+    };
+    auto reachValue = [&](const Value& value) {
+        if (const ObjPtr* obj = std::get_if<ObjPtr>(&value)) reach(*obj);
+    };
+    // Arena kapanışlarının zincirleri globals'ta birleşir; her ortam bir kez taranır
+    std::unordered_set<const Environment*> scannedEnvironments;
+    auto reachEnvironmentChain = [&](const Environment* env) {
+        for (; env != nullptr && scannedEnvironments.insert(env).second; env = env->getEnclosing().get()) {
+            for (const auto& pair : env->getValues()) reachValue(pair.second);
+        }
+    };
+
+    for (const ObjPtr& obj : frameObjects) {
+        GcObjectMetadata* metadata = objectMetadata[obj];
+        metadata->marked = false;
+    }
+    for (const ObjPtr& obj : frameObjects) {
+        if (objectMetadata[obj]->pinCount > 0) reach(obj);
+    }
+    for (Value* root : roots) reachValue(*root);
+    for (const Value* value : temporaryRoots) reachValue(*value);
+    for (const std::vector<Value>* values : temporaryVectorRoots) {
+        for (const Value& value : *values) reachValue(value);
+    }
+    for (const auto& [address, env] : frameEnvironmentStores) {
+        if (std::shared_ptr<const Environment> live = env.lock()) {
+            for (const auto& pair : live->getValues()) reachValue(pair.second);
+        }
+    }
+    for (const Object* container : frameObjectStores) {
+        // Sahipsiz (aliasing) anahtar: yalnızca hâlâ izlenen nesneler bulunur
+        auto it = objectMetadata.find(ObjPtr(ObjPtr(), const_cast<Object*>(container)));
+        if (it == objectMetadata.end() || it->second->generation == 2) continue; // Arena içi yazma
+        traceReferences(it->first, reach);
+    }
+
+    while (!worklist.empty()) {
+        ObjPtr obj = std::move(worklist.back());
+        worklist.pop_back();
+        if (obj->getType() == Object::ObjectType::FUNCTION) {
+            reachEnvironmentChain(std::static_pointer_cast<CCubeFunction>(obj)->getClosure().get());
+        } else if (obj->getType() == Object::ObjectType::C_CUBE_MODULE) {
+            reachEnvironmentChain(std::static_pointer_cast<CCubeModule>(obj)->getEnvironment().get());
+        } else {
+            traceReferences(obj, reach);
+        }
+    }
+}
+
+// Kare sonu: arenadan kaçan nesneleri bulur (bkz. markFrameEscapes). Heap'in geri kalanının
+// işaretlerine dokunulmaz, süpürülmez ve nesil sayaçları değişmez.
+void Gc::endFrame() {
+    if (!inFrame) return;
+    inFrame = false;
+    updateWriteBarrier();
+
+    lastFrameReclaimed = 0;
+    lastFramePromoted = 0;
+    if (!frameObjects.empty()) markFrameEscapes();
+    frameEnvironmentStores.clear();
+    frameObjectStores.clear();
+    if (frameObjects.empty()) return;
+
+    for (size_t i = frameObjects.size(); i-- > 0;) {
+        ObjPtr& obj = frameObjects[i];
+        auto it = objectMetadata.find(obj);
+        if (it == objectMetadata.end()) continue;
+        if (!it->second->marked) { // Sabitlenmiş nesneler markFrameEscapes'te işaretlenir
+            attachGrowthHook(obj, nullptr);
+            bytesAllocated -= std::min(bytesAllocated, it->second->size);
+            releaseHandle(it->second);
+            deleteMetadata(it->second); // metadata->object referansını bırakır
+            objectMetadata.erase(it); // Harita anahtarını bırakır
+            obj.reset();              // Başka sahibi yoksa nesne burada yıkılır
+            lastFrameReclaimed++;
+        }
+    }
+
+    // Hayatta kalanlar normal heap'e (genç nesil) terfi eder
+    for (ObjPtr& obj : frameObjects) {
+        if (obj == nullptr) continue;
+        GcObjectMetadata* metadata = objectMetadata[obj];
+        metadata->generation = 0;
+        metadata->age = 0;
+        youngGeneration.insert(obj);
+        lastFramePromoted++;
+    }
+    frameObjects.clear();
+
+    // Terfi edenler genç nesil kapasitesini doldurduysa normal koleksiyon kuralları geçerli
+    if (youngGeneration.size() >= youngGenCapacity) {
+        if (isPaused()) {
+            collectionPending = true;
+        } else {
+            collectGarbage(false);
+        }
+    }
+}
+
+// Artımlı ilerleme: biriken kredi genç neslin boyutunu karşıladığında genç nesil koleksiyonu yapar.
+// Script tarafı her karede küçük bir bütçe vererek koleksiyonları kendi zamanlamasına yayabilir.
+bool Gc::step(size_t budget) {
+    stepCredit += budget;
+    if (youngGeneration.empty() || stepCredit < youngGeneration.size()) {
+        return false;
+    }
+    stepCredit -= youngGeneration.size();
+    collectGarbage(false);
+    return true;
+}
+
+void Gc::trimHeap(size_t freedBytes) {
+    // Az bellek boşaldıysa kırpmaya değmez; bir sonraki ayırmalar aynı sayfaları kullanır
+    if (freedBytes <= heapTrimRetainBytes) return;
+
+    // GC'nin kendi kapsayıcıları en yüksek doluluk kadar yer tutmaya devam eder
+    youngGeneration.rehash(0);
+    oldGeneration.rehash(0);
+    objectMetadata.rehash(0);
+    if (frameObjects.empty()) GcVector<ObjPtr>(frameObjects.get_allocator()).swap(frameObjects); // Kare içindeyse dokunma
+    if (!verifyHeap) GcVector<std::weak_ptr<Object>>(sweptObjects.get_allocator()).swap(sweptObjects);
+    freeHandleSlots.shrink_to_fit();
+
+    allocator.trim(heapTrimRetainBytes);
+    heapTrims++;
+}
+
+void Gc::recordCollectionCost(bool full_collection, std::chrono::steady_clock::time_point start, size_t objects) {
+    if (objects == 0) return;
+    double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    double& estimate = full_collection ? fullNsPerObject : minorNsPerObject;
+    const double alpha = 0.25; // Yeni ölçümün ağırlığı
+    estimate = (1.0 - alpha) * estimate + alpha * (elapsedNs / static_cast<double>(objects));
+}
+
+double Gc::estimateCollectionNs(bool full_collection) const {
+    return full_collection ? fullNsPerObject * static_cast<double>(objectMetadata.size())
+                           : minorNsPerObject * static_cast<double>(youngGeneration.size());
+}
+
+// Boşta zaman: çağrı başına en fazla bir genç nesil koleksiyonu, ardından tam koleksiyon ya da
+// süren artımlı tam koleksiyonun bir dilimi
+bool Gc::notifyIdle(std::chrono::steady_clock::time_point deadline) {
+    if (isPaused()) return false;
+    auto remainingNs = [deadline]() {
+        return std::chrono::duration<double, std::nano>(deadline - std::chrono::steady_clock::now()).count();
+    };
+    if (remainingNs() <= 0) return false;
+    if (idlePhase != IdlePhase::None) {
+        idleSlices++;
+        advanceIdleCycle(deadline);
+        return true;
+    }
+    bool didWork = false;
+
+    size_t minorThreshold = std::max<size_t>(1, static_cast<size_t>(youngGenCapacity * idleNurseryFraction));
+    if (youngGeneration.size() >= minorThreshold && estimateCollectionNs(false) <= remainingNs()) {
+        collectGarbage(false);
+        idleMinorCollections++;
+        didWork = true;
+    }
+
+    // Tam koleksiyon vadesi: bir sonraki genç koleksiyon tam koleksiyonu tetikleyecekse
+    // ya da yaşlı nesil son tam koleksiyondan bu yana iki katına çıktıysa
+    bool fullDue = youngGenCollections + 1 >= fullCollectionInterval ||
+                   oldGeneration.size() > 2 * oldGenSizeAtLastFull + 64;
+    if (!fullDue || oldGeneration.empty() || remainingNs() <= 0) return didWork;
+    if (estimateCollectionNs(true) <= remainingNs()) {
+        collectGarbage(true);
+        idleFullCollections++;
+    } else {
+        startIdleCycle();
+        idleSlices++;
+        advanceIdleCycle(deadline);
+    }
+    return true;
+}
+
+// Döngü başı: işaretler sıfırlanır, süpürülecek adaylar (genç ve yaşlı nesil) kaydedilir.
+// Döngü boyunca ayrılan nesneler aday değildir (bkz. trackObject).
+void Gc::startIdleCycle() {
+    idleCycleStartBytes = bytesAllocated;
+    idleSweepQueue.reserve(youngGeneration.size() + oldGeneration.size());
+    for (const auto& [obj, metadata] : objectMetadata) {
+        metadata->marked = false;
+        if (metadata->generation != 2) idleSweepQueue.push_back(obj);
+    }
+    idlePhase = IdlePhase::Mark;
+    updateWriteBarrier();
+    shadeIdleRoots();
+}
+
+// Süre her idleCheckInterval nesnede bir kontrol edilir; bir dilim deadline'ı en fazla bu kadar
+// nesnenin işlenme süresi kadar aşar ve her çağrı en az bu kadar ilerler.
+bool Gc::advanceIdleCycle(std::chrono::steady_clock::time_point deadline) {
+    size_t processed = 0;
+    auto outOfTime = [&]() {
+        return ++processed % idleCheckInterval == 0 && std::chrono::steady_clock::now() >= deadline;
+    };
+
+    while (idlePhase == IdlePhase::Mark) {
+        if (idleGrayObjects.empty()) {
+            finishIdleMarking();
+            if (outOfTime()) return false;
+            break;
+        }
+        ObjPtr obj = std::move(idleGrayObjects.back());
+        idleGrayObjects.pop_back();
+        scanIdleObject(obj);
+        if (outOfTime()) return false;
+    }
+    while (!idleSweepQueue.empty()) {
+        ObjPtr obj = std::move(idleSweepQueue.back());
+        idleSweepQueue.pop_back();
+        sweepIdleObject(obj);
+        if (outOfTime()) return false;
+    }
+    finishIdleCycle();
+    return true;
+}
+
+void Gc::shadeIdle(const ObjPtr& obj) {
+    if (obj == nullptr) return;
+    auto it = objectMetadata.find(obj);
+    if (it == objectMetadata.end() || it->second->marked) return;
+    it->second->marked = true;
+    idleGrayObjects.push_back(obj);
+}
+
+void Gc::shadeIdle(const Value& value) {
+    if (const ObjPtr* obj = std::get_if<ObjPtr>(&value)) shadeIdle(*obj);
+}
+
+// Döngü başında ve işaretleme sonunda çağrılır. Yığın kökleri bariyersiz değişir ve sabitlenmiş
+// listelerin tamponuna native kod doğrudan yazabilir; bu yüzden işaretleme sonunda kök ortamlar
+// baştan taranır, sabitlenmiş nesneler işaretli olsalar da yeniden gri listeye girer.
+void Gc::shadeIdleRoots() {
+    for (Value* root : roots) shadeIdle(*root);
+    for (const Value* value : temporaryRoots) shadeIdle(*value);
+    for (const std::vector<Value>* values : temporaryVectorRoots) {
+        for (const Value& value : *values) shadeIdle(value);
+    }
+    auto shadeChain = [this](const Environment* env) {
+        for (; env != nullptr; env = env->getEnclosing().get()) {
+            for (const auto& pair : env->getValues()) shadeIdle(pair.second);
+        }
+    };
+    if (interpreter_globals != nullptr) shadeChain(interpreter_globals->get());
+    if (interpreter_environment != nullptr) shadeChain(interpreter_environment->get());
+    for (const Environment* env : environmentRoots) shadeChain(env);
+
+    // Kare arenası endFrame'e kadar canlıdır (collectGarbage'daki gibi)
+    for (const ObjPtr& obj : frameObjects) shadeIdle(obj);
+    for (const auto& [obj, metadata] : objectMetadata) {
+        if (metadata->pinCount == 0) continue;
+        metadata->marked = true;
+        idleGrayObjects.push_back(obj);
+    }
+}
+
+void Gc::scanIdleObject(const ObjPtr& obj) {
+    if (objectMetadata.find(obj) == objectMetadata.end()) return; // Karede bırakılmış
+    auto shadeChain = [this](const Environment* env) {
+        for (; env != nullptr && idleScannedEnvironments.insert(env).second; env = env->getEnclosing().get()) {
+            for (const auto& pair : env->getValues()) shadeIdle(pair.second);
+        }
+    };
+    switch (obj->getType()) {
+        case Object::ObjectType::FUNCTION:
+            shadeChain(std::static_pointer_cast<CCubeFunction>(obj)->getClosure().get());
+            break;
+        case Object::ObjectType::C_CUBE_MODULE:
+            shadeChain(std::static_pointer_cast<CCubeModule>(obj)->getEnvironment().get());
+            break;
+        case Object::ObjectType::WEAK_MAP:
+            break; // Değerler anahtarlarına bağlıdır; işaretleme sonunda markEphemerons işler
+        default:
+            traceReferences(obj, [this](const ObjPtr& child) { shadeIdle(child); });
+            break;
+    }
+}
+
+// Tek adımda yapılır: kökler yeniden taranıp gri liste boşaltıldıktan sonra işaretler kesindir
+void Gc::finishIdleMarking() {
+    shadeIdleRoots();
+    while (!idleGrayObjects.empty()) {
+        ObjPtr obj = std::move(idleGrayObjects.back());
+        idleGrayObjects.pop_back();
+        scanIdleObject(obj);
+    }
+    markEphemerons(true);
+    clearDeadWeakReferences(true);
+    idleScannedEnvironments.clear();
+    idlePhase = IdlePhase::Sweep;
+    updateWriteBarrier();
+}
+
+void Gc::sweepIdleObject(const ObjPtr& obj) {
+    auto it = objectMetadata.find(obj);
+    if (it == objectMetadata.end()) return;
+    GcObjectMetadata* metadata = it->second;
+    if (metadata->marked || metadata->pinCount > 0) return;
+
+    if (verifyHeap) sweptObjects.push_back(obj);
+    bytesAllocated -= std::min(bytesAllocated, metadata->size);
+    (metadata->generation == 1 ? oldGeneration : youngGeneration).erase(obj);
+    attachGrowthHook(obj, nullptr);
+    releaseHandle(metadata);
+    deleteMetadata(metadata);
+    objectMetadata.erase(it);
+}
+
+void Gc::finishIdleCycle() {
+    while (!idleSweepQueue.empty()) {
+        ObjPtr obj = std::move(idleSweepQueue.back());
+        idleSweepQueue.pop_back();
+        sweepIdleObject(obj);
+    }
+    idlePhase = IdlePhase::None;
+    youngGenCollections = 0;
+    fullCollections++;
+    idleFullCollections++;
+    if (stringInternEnabled) internStrings();
+    oldGenSizeAtLastFull = oldGeneration.size();
+    if (heapTrimEnabled) trimHeap(idleCycleStartBytes - std::min(idleCycleStartBytes, bytesAllocated));
+    if (verifyHeap) verify();
+}
+
+// Kritik bölüm başlangıcı: otomatik koleksiyonlar ertelenir
+void Gc::pause() {
+    pauseDepth++;
+}
+
+// Kritik bölüm sonu: en dıştaki resume() ertelenmiş koleksiyonu çalıştırır
+void Gc::resume() {
+    if (pauseDepth == 0) return; // Eşleşmeyen resume çağrısı
+    pauseDepth--;
+    if (pauseDepth == 0 && collectionPending) {
+        collectGarbage(false);
+    }
+}
+
+void Gc::setNurserySize(size_t objectCount) {
+    youngGenCapacity = std::max<size_t>(1, objectCount);
+}
+
+void Gc::setPromotionThreshold(int collections) {
+    promotionThreshold = std::max(1, collections);
+}
+
+void Gc::attachInterpreterRoots(const std::shared_ptr<Environment>* globals,
+                                const std::shared_ptr<Environment>* current) {
+    interpreter_globals = globals;
+    interpreter_environment = current;
+}
+
+void Gc::setHeapLimits(size_t hardLimit, size_t softLimit, std::function<void(Gc&, size_t)> onSoftLimit) {
+    maxHeapBytes = hardLimit;
+    softHeapLimitBytes = softLimit;
+    softLimitCallback = std::move(onSoftLimit);
+    softLimitNotified = false;
+}
+
+void Gc::setStressMode(size_t everyNth, bool full) {
+    stressInterval = everyNth;
+    stressFullCollections = full;
+}
+
+// Kalıcı kökler ve yürütme yığını; koleksiyon ve kare sonu aynı kök kümesini kullanır
+void Gc::markRoots() {
+    // Tüm kökleri işaretle
+    for (Value* root_val : roots) {
+        markValue(*root_val);
+    }
+    // Sabitlenmiş nesneler native kod tarafından ödünç alınmıştır, kök sayılır
+    for (const auto& entry : objectMetadata) {
+        if (entry.second->pinCount > 0) markObject(entry.first);
+    }
+
+    // Ek kökler: Global ortam, interpreter'ın mevcut ortamı, sınıf metotları vb.
+    // Environment'ın kendisi de kök olmalı (globals ve current environment)
+    // Interpreter'daki globals ve current environment'ı buraya manuel olarak eklemeliyiz.
+    // Veya Interpreter'ın Gc ile olan ilişkisini güçlendirmeliyiz.
+    // Şimdilik, Interpreter'ın global ve mevcut ortamlarını burada varsayalım.
+    // Interpreter'ın ortamlarını buraya root olarak eklemenin en iyi yolu, Interpreter'ın
+    // `current` ve `globals` ortamlarını `Gc::addRoot` metoduna iletmek olacaktır.
+    // Geçici olarak, Interpreter'daki environment'ları burada doğrudan marklamaya çalışalım:
+    
+    if (interpreter_globals != nullptr) markEnvironmentChain(interpreter_globals->get());
+    if (interpreter_environment != nullptr) markEnvironmentChain(interpreter_environment->get());
+    // Yürütme yığını: çağıran çerçevelerin ortamları ve C++ yığınındaki geçici değerler
+    for (const Environment* env : environmentRoots) markEnvironmentChain(env);
+    for (const Value* value : temporaryRoots) markValue(*value);
+    for (const std::vector<Value>* values : temporaryVectorRoots) markContainer(*values);
+    
+    // Bu, Gc sınıfının Interpreter'a bağımlı olmasına neden olur, bu iyi bir tasarım değildir.
+    // En iyi yol, Interpreter'ın tüm kökleri Gc'ye sağlamasıdır.
+}
+
+// Ortam zincirini (mevcut ortam ve tüm üst ortamlar) işaretler
+void Gc::markEnvironmentChain(const Environment* env) {
+    // Üst ortamlar alt ortamın enclosing üyesiyle canlı tutulur; ham işaretçi yeterlidir
+    for (; env != nullptr; env = env->getEnclosing().get()) {
+        markMap(env->getValues());
+    }
+}
+
 // Tüm nesnelerin marklarını sıfırla
 void Gc::resetMarks() {
     for (const auto& entry : objectMetadata) {
@@ -228,19 +900,9 @@ void Gc::markObject(ObjPtr obj) {
     switch (obj->getType()) {
         case Object::ObjectType::FUNCTION: {
             std::shared_ptr<CCubeFunction> func = std::static_pointer_cast<CCubeFunction>(obj);
-            // Fonksiyonun kapsayan ortamını işaretle
-            // Environment'lar Value'lar tuttuğu için Environment::values haritasını işaretlemeliyiz.
-            if (func->closure != nullptr) {
-                // closure environment'ı da bir Environment objesidir, onu da marklamalıyız
-                // Ancak Environment'lar doğrudan ObjPtr değil, bu karmaşık bir durum.
-                // Basitlik için, Environment'ı işaretlemek yerine içindeki ObjPtr'ları işaretlemeliyiz.
-                // (Bu, Interpreter'ın Environment'ları da Gc ile yönetmesi gerektiği anlamına gelebilir.)
-                // Şimdilik, Environment'ın içindeki ObjPtr'ları markValue aracılığıyla işaretleyelim.
-                markMap(func->closure->getValues());
-                if (func->closure->getEnclosing() != nullptr) {
-                    markMap(func->closure->getEnclosing()->getValues());
-                }
-            }
+            // Kapanış zincirinin tamamı işaretlenir (doğrulayıcıdaki traceReferences ile aynı kural);
+            // fonksiyon, kendisinden kaç kapsam yukarıda tanımlanmış olursa olsun her değişkene erişebilir.
+            markEnvironmentChain(func->getClosure().get());
             break;
         }
         case Object::ObjectType::CLASS: {
@@ -276,16 +938,70 @@ void Gc::markObject(ObjPtr obj) {
         }
         case Object::ObjectType::C_CUBE_MODULE: {
             std::shared_ptr<CCubeModule> module = std::static_pointer_cast<CCubeModule>(obj);
-            // Modülün içerdiği üyeleri işaretle (genellikle environment'ıdır)
-            markMap(module->getEnvironment()->getValues());
+            // Modülün içerdiği üyeleri işaretle (ortamı ve üst zinciri, doğrulayıcıdaki gibi)
+            markEnvironmentChain(module->getEnvironment().get());
             break;
         }
+        // WEAK_REF hedefini, WEAK_MAP ise girdilerini doğrudan işaretlemez (bkz. markEphemerons)
         // Diğer obje tipleri için de benzer şekilde marklama yapılabilir
         default:
             break;
     }
 }
 
+bool Gc::survivesCollection(const ObjPtr& obj, bool full_collection) {
+    auto it = objectMetadata.find(obj);
+    if (it == objectMetadata.end()) return true; // GC tarafından yönetilmiyor
+    const GcObjectMetadata* metadata = it->second;
+    if (metadata->marked || metadata->generation == 2) return true;
+    return metadata->generation == 1 && !full_collection;
+}
+
+void Gc::markEphemerons(bool full_collection) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& entry : objectMetadata) {
+            if (entry.first->getType() != Object::ObjectType::WEAK_MAP) continue;
+            if (!survivesCollection(entry.first, full_collection)) continue;
+            auto map = std::static_pointer_cast<CCubeWeakMap>(entry.first);
+            for (const auto& pair : map->getEntries()) {
+                ObjPtr key = pair.second.key.lock();
+                if (key == nullptr || !survivesCollection(key, full_collection)) continue;
+                if (!std::holds_alternative<ObjPtr>(pair.second.value)) continue;
+                auto valueIt = objectMetadata.find(std::get<ObjPtr>(pair.second.value));
+                if (valueIt != objectMetadata.end() && !valueIt->second->marked) {
+                    markValue(pair.second.value); // Yeni işaretlenen nesneler başka anahtarları canlandırabilir
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+void Gc::clearDeadWeakReferences(bool full_collection) {
+    for (const auto& entry : objectMetadata) {
+        Object::ObjectType type = entry.first->getType();
+        if (type == Object::ObjectType::WEAK_REF) {
+            auto ref = std::static_pointer_cast<CCubeWeakRef>(entry.first);
+            ObjPtr target = ref->get();
+            if (target != nullptr && !survivesCollection(target, full_collection)) {
+                ref->clear();
+            }
+        } else if (type == Object::ObjectType::WEAK_MAP) {
+            auto& entries = std::static_pointer_cast<CCubeWeakMap>(entry.first)->getEntriesMutable();
+            for (auto it = entries.begin(); it != entries.end();) {
+                ObjPtr key = it->second.key.lock();
+                if (key == nullptr || !survivesCollection(key, full_collection)) {
+                    it = entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+}
+
 // Bir Value'yu işaretle (eğer içinde ObjPtr varsa)
 void Gc::markValue(const Value& val) {
     if (std::holds_alternative<ObjPtr>(val)) {
@@ -300,13 +1016,6 @@ void Gc::markContainer(const std::vector<Value>& container) {
     }
 }
 
-// Bir string-Value haritası içindeki ObjPtr'ları işaretle
-void Gc::markMap(const std::unordered_map<std::string, Value>& map) {
-    for (const auto& pair : map) {
-        markValue(pair.second);
-    }
-}
-
 // Bir string-ObjPtr haritası içindeki ObjPtr'ları işaretle
 void Gc::markMapObjects(const std::unordered_map<std::string, ObjPtr>& map) {
     for (const auto& pair : map) {
@@ -317,7 +1026,7 @@ void Gc::markMapObjects(const std::unordered_map<std::string, ObjPtr>& map) {
 
 // Sweep aşaması: İşaretlenmemiş nesneleri toplar
 void Gc::sweep(int generation_to_sweep) {
-    std::unordered_set<ObjPtr>* target_generation = nullptr;
+    ObjectSet* target_generation = nullptr;
     if (generation_to_sweep == 0) {
         target_generation = &youngGeneration;
     } else if (generation_to_sweep == 1) {
@@ -334,9 +1043,14 @@ void Gc::sweep(int generation_to_sweep) {
     }
 
     for (const auto& obj : to_delete) {
-        bytesAllocated -= obj->getSize(); // Rough size
+        if (verifyHeap) sweptObjects.push_back(obj);
+        // Ayırmada eklenen boyutu düş; getSize() nesne büyüdükçe değiştiği için sayaç kayardı
+        size_t size = objectMetadata.count(obj) ? objectMetadata[obj]->size : 0;
+        bytesAllocated -= std::min(bytesAllocated, size);
         target_generation->erase(obj); // Nesli set'ten kaldır
-        delete objectMetadata[obj]; // Meta veriyi sil
+        attachGrowthHook(obj, nullptr); // Nesne native kodda yaşamaya devam edebilir
+        releaseHandle(objectMetadata[obj]);
+        deleteMetadata(objectMetadata[obj]); // Meta veriyi sil
         objectMetadata.erase(obj);  // Haritadan kaldır
         // Nesnenin kendisi shared_ptr olduğu için, başka referans yoksa otomatik silinecektir.
         // Eğer shared_ptr yerine raw pointer yönetseydik burada delete obj.get() yapardık.
@@ -351,7 +1065,7 @@ void Gc::promoteObjects() {
     for (const auto& obj : youngGeneration) {
         if (objectMetadata.count(obj) && objectMetadata[obj]->marked) { // İşaretli ve canlıysa
             objectMetadata[obj]->age++;
-            if (objectMetadata[obj]->age >= PROMOTION_THRESHOLD) {
+            if (objectMetadata[obj]->age >= promotionThreshold) {
                 to_promote.push_back(obj);
             }
         }
@@ -368,9 +1082,12 @@ void Gc::promoteObjects() {
 // GC'ye kaydettiğimiz GcObjectMetadata nesnelerinin temizlenmesi için
 void Gc::cleanupMetadata() {
     for (const auto& entry : objectMetadata) {
-        delete entry.second; // Heap'te oluşturulan GcObjectMetadata nesnelerini sil
+        attachGrowthHook(entry.first, nullptr); // Gc'den uzun yaşayan nesneler bize bildirim yapmasın
+        deleteMetadata(entry.second); // Host ayırıcısından alınan GcObjectMetadata nesnelerini sil
     }
     objectMetadata.clear();
+    handleSlots.assign(1, HandleSlot{});
+    freeHandleSlots.clear();
 }
 
 // Debug amaçlı istatistikleri yazdır
@@ -380,5 +1097,154 @@ void Gc::printStats() {
     std::cout << "Genç Nesil Nesneler: " << youngGeneration.size() << std::endl;
     std::cout << "Yaşlı Nesil Nesneler: " << oldGeneration.size() << std::endl;
     std::cout << "Genç Nesil Koleksiyonları: " << youngGenCollections << std::endl;
+    std::cout << "Tam Koleksiyonlar: " << fullCollections << std::endl;
+    if (heapTrims > 0) {
+        std::cout << "Heap Kırpma: " << heapTrims << " kez (tutulan hedef " << heapTrimRetainBytes << " bayt)" << std::endl;
+    }
+    if (idleMinorCollections > 0 || idleFullCollections > 0) {
+        std::cout << "Boşta Koleksiyonlar: Genç=" << idleMinorCollections << ", Tam=" << idleFullCollections
+                  << " (artımlı dilim=" << idleSlices << ")" << std::endl;
+    }
+    if (stringInternRuns > 0) {
+        std::cout << "String Birleştirme: " << stringInternRuns << " geçiş, son geçiş=" << lastStringInternShared
+                  << " değer/" << lastStringInternBytes << " bayt, geri kazanılan=" << stringInternReclaimedBytes
+                  << " bayt" << std::endl;
+    }
+    if (inFrame || lastFrameReclaimed > 0 || lastFramePromoted > 0) {
+        std::cout << "Kare Arenası: " << frameObjects.size() << " nesne, son kare bırakılan="
+                  << lastFrameReclaimed << ", terfi eden=" << lastFramePromoted << std::endl;
+    }
     std::cout << "-------------------------" << std::endl;
 }
+
+// --- Heap Doğrulayıcı ---
+
+// Bir nesnenin doğrudan referans verdiği nesneleri gezer.
+// markObject'ten bağımsız yazılmıştır; böylece işaretleme hataları doğrulayıcıda görünür.
+void Gc::traceReferences(const ObjPtr& obj, const std::function<void(const ObjPtr&)>& visit) const {
+    auto visitValue = [&visit](const Value& val) {
+        if (std::holds_alternative<ObjPtr>(val) && std::get<ObjPtr>(val) != nullptr) {
+            visit(std::get<ObjPtr>(val));
+        }
+    };
+    auto visitEnvironment = [&visitValue](std::shared_ptr<Environment> env) {
+        for (; env != nullptr; env = env->getEnclosing()) {
+            for (const auto& pair : env->getValues()) visitValue(pair.second);
+        }
+    };
+
+    switch (obj->getType()) {
+        case Object::ObjectType::FUNCTION:
+            visitEnvironment(std::static_pointer_cast<CCubeFunction>(obj)->getClosure());
+            break;
+        case Object::ObjectType::CLASS: {
+            auto klass = std::static_pointer_cast<CCubeClass>(obj);
+            for (const auto& pair : klass->getMethods()) {
+                if (pair.second != nullptr) visit(std::static_pointer_cast<Object>(pair.second));
+            }
+            if (klass->getSuperclass() != nullptr) visit(std::static_pointer_cast<Object>(klass->getSuperclass()));
+            break;
+        }
+        case Object::ObjectType::INSTANCE: {
+            auto instance = std::static_pointer_cast<CCubeInstance>(obj);
+            if (instance->get_class() != nullptr) visit(std::static_pointer_cast<Object>(instance->get_class()));
+            for (const auto& pair : instance->getProperties()) visitValue(pair.second);
+            break;
+        }
+        case Object::ObjectType::LIST:
+            for (const Value& val : std::static_pointer_cast<CCubeList>(obj)->getElements()) visitValue(val);
+            break;
+        case Object::ObjectType::BOUND_METHOD: {
+            auto bound = std::static_pointer_cast<BoundMethod>(obj);
+            if (bound->instance != nullptr) visit(std::static_pointer_cast<Object>(bound->instance));
+            if (bound->function != nullptr) visit(std::static_pointer_cast<Object>(bound->function));
+            break;
+        }
+        case Object::ObjectType::C_CUBE_MODULE:
+            visitEnvironment(std::static_pointer_cast<CCubeModule>(obj)->getEnvironment());
+            break;
+        case Object::ObjectType::WEAK_MAP:
+            // Zayıf referans hedefleri izlenmez; tablo değerleri yalnızca anahtarları canlıysa erişilebilir
+            for (const auto& pair : std::static_pointer_cast<CCubeWeakMap>(obj)->getEntries()) {
+                if (!pair.second.key.expired()) visitValue(pair.second.value);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Köklerden (Value* kökleri, Interpreter ortamları ve yürütme yığını) erişilebilen tüm nesneleri toplar
+std::unordered_set<Object*> Gc::collectReachable() const {
+    std::unordered_set<Object*> reachable;
+    std::vector<ObjPtr> worklist;
+
+    auto push = [&](const ObjPtr& obj) {
+        if (obj != nullptr && reachable.insert(obj.get()).second) {
+            worklist.push_back(obj);
+        }
+    };
+    auto pushValue = [&](const Value& val) {
+        if (std::holds_alternative<ObjPtr>(val)) push(std::get<ObjPtr>(val));
+    };
+    auto pushEnvironment = [&](const Environment* env) {
+        for (; env != nullptr; env = env->getEnclosing().get()) {
+            for (const auto& pair : env->getValues()) pushValue(pair.second);
+        }
+    };
+
+    for (Value* root_val : roots) pushValue(*root_val);
+    if (interpreter_globals != nullptr) pushEnvironment(interpreter_globals->get());
+    if (interpreter_environment != nullptr) pushEnvironment(interpreter_environment->get());
+    for (const Environment* env : environmentRoots) pushEnvironment(env);
+    for (const Value* value : temporaryRoots) pushValue(*value);
+    for (const std::vector<Value>* values : temporaryVectorRoots) {
+        for (const Value& val : *values) pushValue(val);
+    }
+    for (const auto& entry : objectMetadata) {
+        if (entry.second->pinCount > 0) push(entry.first);
+    }
+
+    while (!worklist.empty()) {
+        ObjPtr obj = worklist.back();
+        worklist.pop_back();
+        traceReferences(obj, push);
+    }
+    return reachable;
+}
+
+// Koleksiyon sonrası heap tutarlılığını doğrular
+size_t Gc::verify() {
+    std::unordered_set<Object*> reachable = collectReachable();
+
+    std::unordered_map<Object*, const GcObjectMetadata*> tracked;
+    for (const auto& entry : objectMetadata) {
+        tracked[entry.first.get()] = entry.second;
+    }
+
+    size_t failures = 0;
+    for (Object* obj : reachable) {
+        auto it = tracked.find(obj);
+        if (it == tracked.end()) {
+            // Native fonksiyonlar GC tarafından izlenmez; bunlar yaprak nesnelerdir.
+            if (obj->getType() == Object::ObjectType::NATIVE_FUNCTION) continue;
+            std::cerr << "GC Doğrulama Hatası: erişilebilir nesne izlenmiyor: " << obj->toString() << std::endl;
+            failures++;
+        } else if (!it->second->marked) {
+            std::cerr << "GC Doğrulama Hatası: erişilebilir nesne işaretlenmemiş: " << obj->toString() << std::endl;
+            failures++;
+        }
+    }
+
+    for (const auto& weak : sweptObjects) {
+        ObjPtr obj = weak.lock();
+        if (obj != nullptr && reachable.count(obj.get())) {
+            std::cerr << "GC Doğrulama Hatası: süpürülen nesne hâlâ erişilebilir: " << obj->toString() << std::endl;
+            failures++;
+        }
+    }
+    sweptObjects.clear();
+
+    verificationFailures += failures;
+    return failures;
+}
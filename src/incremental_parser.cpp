@@ -0,0 +1,151 @@
+#include "incremental_parser.h"
+
+#include <algorithm>
+
+#include "scanner.h"
+#include "parser.h"
+
+IncrementalParser::IncrementalParser(ErrorReporter& reporter, Allocator& allocator)
+    : reporter(reporter), allocator(allocator) {}
+
+IncrementalParser::~IncrementalParser() {
+    // Parser'dan uzun yaşayan düğümlerin (örn. yorumlayıcıdaki fonksiyonlar) konumları bilinmeyen
+    // satır olarak çözülür; harita serbest kalan belleğe bakmaz
+    for (const auto& [generation, chunk] : chunks) sourceMap().removeBuffer(chunk.text);
+}
+
+SourceEdit IncrementalParser::diff(std::string_view oldText, std::string_view newText) {
+    size_t prefix = 0;
+    size_t limit = std::min(oldText.size(), newText.size());
+    while (prefix < limit && oldText[prefix] == newText[prefix]) prefix++;
+
+    size_t suffix = 0;
+    limit -= prefix;
+    while (suffix < limit && oldText[oldText.size() - 1 - suffix] == newText[newText.size() - 1 - suffix]) suffix++;
+
+    return SourceEdit{prefix, oldText.size() - suffix, newText.size() - suffix};
+}
+
+const std::vector<StmtPtr>& IncrementalParser::parse(std::string source) {
+    text = std::move(source);
+    return fullParse();
+}
+
+const std::vector<StmtPtr>& IncrementalParser::reparse(std::string source) {
+    SourceEdit edit = diff(text, source);
+    return reparse(std::move(source), edit);
+}
+
+const std::vector<StmtPtr>& IncrementalParser::reparse(std::string source, const SourceEdit& edit) {
+    if (edit.start > edit.oldEnd || edit.oldEnd > text.size() || edit.start > edit.newEnd ||
+        edit.newEnd > source.size() || source.size() - edit.newEnd != text.size() - edit.oldEnd) {
+        // Aralık metinlerle uyuşmuyor: güvenli yol
+        text = std::move(source);
+        return fullParse();
+    }
+
+    // Düzenlemeye dokunan (sınırda değenler dahil) bildirimler kirlidir. Yeniden parse edilen
+    // parça, önceki temiz bildirimin sonundan sonraki temiz bildirimin başına kadar uzanır;
+    // böylece aradaki boşluk ve yorumlar da yeniden taranır ve parça bir token ortasında başlamaz.
+    size_t first = 0;
+    while (first < entries.size() && entries[first].end < edit.start) first++;
+    size_t last = first;
+    while (last < entries.size() && entries[last].begin <= edit.oldEnd) last++;
+    // Kirli bildirimler: [first, last)
+
+    const long long delta = static_cast<long long>(edit.newEnd) - static_cast<long long>(edit.oldEnd);
+    size_t rangeBegin = first > 0 ? entries[first - 1].end : 0;
+    size_t rangeEnd = last < entries.size() ? static_cast<size_t>(entries[last].begin + delta) : source.size();
+
+    int lineDelta = static_cast<int>(std::count(source.begin() + edit.start, source.begin() + edit.newEnd, '\n')) -
+                    static_cast<int>(std::count(text.begin() + edit.start, text.begin() + edit.oldEnd, '\n'));
+
+    text = std::move(source);
+
+    ErrorReporter rangeReporter;
+    rangeReporter.setSilent(true); // Hata varsa tam parse hataları asıl reporter'a yazar
+    std::vector<Entry> fresh;
+    if (!parseRange(rangeBegin, rangeEnd, rangeReporter, fresh)) return fullParse();
+
+    // Sonraki bildirimler kayar: aralıklar metinde, satırlar SourceMap'te (tampon başına bir kez;
+    // bir tampondaki bildirimlerin kaynak sırası ofset sırasıyla aynıdır)
+    std::vector<size_t> shiftedGenerations;
+    for (size_t i = last; i < entries.size(); ++i) {
+        Entry& entry = entries[i];
+        entry.begin += delta;
+        entry.end += delta;
+        if (lineDelta != 0 &&
+            std::find(shiftedGenerations.begin(), shiftedGenerations.end(), entry.generation) == shiftedGenerations.end()) {
+            sourceMap().shiftLines(entry.loc, lineDelta);
+            shiftedGenerations.push_back(entry.generation);
+        }
+    }
+
+    changed.clear();
+    for (const Entry& entry : fresh) changed.push_back(entry.stmt);
+    entries.erase(entries.begin() + first, entries.begin() + last);
+    entries.insert(entries.begin() + first, fresh.begin(), fresh.end());
+    lastFull = false;
+    publish();
+    releaseChunks();
+    return program;
+}
+
+bool IncrementalParser::parseRange(size_t begin, size_t end, ErrorReporter& rangeReporter, std::vector<Entry>& out) {
+    int firstLine = 1 + static_cast<int>(std::count(text.begin(), text.begin() + begin, '\n'));
+    bool hadErrorBefore = rangeReporter.hadError();
+    size_t generation = nextGeneration++;
+    Chunk& owner = chunks[generation];
+    owner.text.assign(text, begin, end - begin);
+    const std::string& chunk = owner.text;
+    sourceMap().addBuffer(chunk, firstLine);
+
+    Scanner scanner(chunk, rangeReporter, firstLine);
+    Parser parser(scanner, rangeReporter, allocator);
+    parser.setLazyFunctionBodies(false);
+    std::vector<Parser::StatementSpan> spans;
+    std::vector<StmtPtr> statements = parser.parse(spans);
+    // Hatalı parçanın düğümleri kullanılmazsa parça sonraki releaseChunks()'ta silinir
+    owner.statements.assign(statements.begin(), statements.end());
+    if (!hadErrorBefore && rangeReporter.hadError()) return false;
+
+    for (size_t i = 0; i < statements.size(); ++i) {
+        size_t spanBegin = static_cast<size_t>(spans[i].begin - chunk.data());
+        size_t spanEnd = static_cast<size_t>(spans[i].end - chunk.data());
+        out.push_back(Entry{statements[i], begin + spanBegin, begin + spanEnd, generation,
+                            sourceMap().locate(spans[i].begin, firstLine)});
+    }
+    return true;
+}
+
+const std::vector<StmtPtr>& IncrementalParser::fullParse() {
+    std::vector<Entry> fresh;
+    parseRange(0, text.size(), reporter, fresh);
+    entries = std::move(fresh);
+    changed.clear();
+    for (const Entry& entry : entries) changed.push_back(entry.stmt);
+    lastFull = true;
+    publish();
+    releaseChunks();
+    return program;
+}
+
+void IncrementalParser::releaseChunks() {
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        const std::vector<std::weak_ptr<Stmt>>& statements = it->second.statements;
+        bool discarded = std::all_of(statements.begin(), statements.end(),
+                                     [](const std::weak_ptr<Stmt>& stmt) { return stmt.expired(); });
+        if (!discarded) {
+            ++it;
+            continue;
+        }
+        sourceMap().removeBuffer(it->second.text);
+        it = chunks.erase(it);
+    }
+}
+
+void IncrementalParser::publish() {
+    program.clear();
+    program.reserve(entries.size());
+    for (const Entry& entry : entries) program.push_back(entry.stmt);
+}
@@ -2,34 +2,57 @@
 #include "class.h"      // CCubeClass tanımı için
 #include "error_reporter.h" // RuntimeException için
 #include "utils.h"      // valueToString için
+#include "gc.h"         // Büyüme bildirimi (heap sınırı)
 
 // Constructor
 CCubeInstance::CCubeInstance(std::shared_ptr<CCubeClass> klass) : klass(klass) {}
 
 // Bir özelliğin değerini alır
 Value CCubeInstance::get(const Token& name) {
+    return get(std::string(name.lexeme), SourceLoc::fromLine(name.line));
+}
+
+Value CCubeInstance::get(const std::string& name, SourceLoc loc) {
     // Önce instance'ın kendi özelliklerinde ara
-    if (properties.count(name.lexeme)) {
-        return properties.at(name.lexeme);
+    auto it = properties.find(name);
+    if (it != properties.end()) {
+        return it->second;
     }
 
     // Instance'da bulunamazsa, sınıfın metotlarında ara
-    std::shared_ptr<CCubeFunction> method = klass->findMethod(name.lexeme);
+    std::shared_ptr<CCubeFunction> method = klass->findMethod(name);
     if (method != nullptr) {
         // Metodu mevcut instance'a bağla ve döndür.
         // Bu BoundMethod nesnesini GC'ye kaydetmek gerekir,
         // ancak bu metot çağrısı Interpreter'dan yapıldığı için,
         // Interpreter'ın döndürülen BoundMethod'u GC'ye kaydetmesi gerekir.
         // Interpreter'da visitGetExpr kısmında bu zaten yapılıyor.
+        // Nesne, instance'ı izleyen GC'nin host ayırıcısından (AllocCategory::Object) ayrılır.
+        if (heap != nullptr) return heap->make<BoundMethod>(shared_from_this(), method);
         return std::make_shared<BoundMethod>(shared_from_this(), method);
     }
 
-    throw RuntimeException(name, "'" + name.lexeme + "' adlı özellik bulunamadı.");
+    throw RuntimeException(sourceMap().token(loc), "'" + name + "' adlı özellik bulunamadı.");
 }
 
 // Bir özelliğe değer atar
 void CCubeInstance::set(const Token& name, Value value) {
-    properties[name.lexeme] = value;
+    set(std::string(name.lexeme), std::move(value));
+}
+
+void CCubeInstance::set(const std::string& name, Value value) {
+    // Büyüme getSize() ile aynı ölçüyle hesaplanır: yeni alan anahtarı ve yuvası, string içerikleri
+    std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(Gc::payloadBytes(value));
+    if (heap != nullptr) heap->rememberStore(this, value);
+    auto it = properties.find(name);
+    if (it == properties.end()) {
+        delta += static_cast<std::ptrdiff_t>(name.size() + sizeof(Value));
+        properties.emplace(name, std::move(value));
+    } else {
+        delta -= static_cast<std::ptrdiff_t>(Gc::payloadBytes(it->second));
+        it->second = std::move(value);
+    }
+    if (heap != nullptr) heap->chargeGrowth(this, delta);
 }
 
 // Object arayüzünden toString implementasyonu
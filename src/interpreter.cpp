@@ -1,4 +1,6 @@
 #include "interpreter.h"
+#include "parser.h" // Tembel fonksiyon gövdeleri için
+#include "aot_runtime.h" // Önceden derlenmiş fonksiyon gövdeleri
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -11,10 +13,27 @@
 
 // Constructor
 Interpreter::Interpreter(ErrorReporter& reporter, Gc& gc_instance, ModuleLoader& loader)
-    : globals(std::make_shared<Environment>()), environment(globals),
+    : Interpreter(reporter, gc_instance, loader, gc_instance.getAllocator()) {}
+
+Interpreter::Interpreter(ErrorReporter& reporter, Gc& gc_instance, ModuleLoader& loader, Allocator& allocator)
+    : allocator(allocator),
+      globals(allocateShared<Environment>(allocator, AllocCategory::Environment, allocator)), environment(globals),
       errorReporter(reporter), gc(gc_instance), moduleLoader(loader) {
-    // Yerleşik fonksiyonları global ortama ekle
-    BuiltinFunctions::defineBuiltins(globals, gc); // BuiltinFunctions'ın da Gc'yi kullanması sağlanmalı
+    // Yerleşik fonksiyonları ve modülleri global ortama ekle. Tek tanımlama yeri burasıdır: ikinci
+    // bir çağrı gc/weak modüllerinin kopyalarını oluşturup öncekilerin bağlamasını ezerdi.
+    BuiltinFunctions::defineBuiltins(globals, gc);
+    // GC, kök taraması için ortam üyelerimizin adreslerini tutar (ortam değiştikçe güncel kalır)
+    gc.attachInterpreterRoots(&globals, &environment);
+}
+
+// Destructor: Gc, Interpreter'dan uzun yaşayabilir; ortam adreslerini geçersiz bırakmamak için bağı kopar
+Interpreter::~Interpreter() {
+    gc.attachInterpreterRoots(nullptr, nullptr);
+}
+
+// Verilen üst ortamı kapsayan yeni bir ortamı host ayırıcısından oluşturur
+std::shared_ptr<Environment> Interpreter::newEnvironment(std::shared_ptr<Environment> enclosing) {
+    return allocateShared<Environment>(allocator, AllocCategory::Environment, enclosing);
 }
 
 // Programı yorumlamaya başlar
@@ -35,8 +54,17 @@ void Interpreter::interpret(const std::vector<StmtPtr>& statements) {
         // ilgili Environment'ların içindeki ObjPtr'ları tarayacağını varsayalım.
         // (Bu, Gc'nin Interpreter'a bağımlı olmasını gerektirir, ideal değildir. Daha iyi çözüm daha sonra.)
 
-        for (const auto& stmt : statements) {
-            execute(stmt);
+        if (execMode == ExecMode::Closure) {
+            ClosureCompiler::compile(statements)->run(*this);
+        } else if (execMode == ExecMode::Flat) {
+            FlatAst flat = FlatAst::lower(statements);
+            for (FlatAst::Index i = 0; i < flat.rootCount; ++i) {
+                executeFlat(flat, flat.lists[flat.rootBegin + i]);
+            }
+        } else {
+            for (const auto& stmt : statements) {
+                execute(stmt);
+            }
         }
     } catch (const RuntimeException& e) {
         errorReporter.runtimeError(e);
@@ -59,7 +87,7 @@ bool Interpreter::isTruthy(const Value& value) {
     if (std::holds_alternative<std::monostate>(value)) return false; // none is false
     if (std::holds_alternative<bool>(value)) return std::get<bool>(value);
     if (std::holds_alternative<double>(value)) return std::get<double>(value) != 0.0;
-    if (std::holds_alternative<std::string>(value)) return !std::get<std::string>(value).empty();
+    if (std::holds_alternative<CubeString>(value)) return !std::get<CubeString>(value).empty();
     // Diğer tüm objeler (fonksiyonlar, sınıflar, objeler, listeler, modüller) true'dur.
     return true;
 }
@@ -73,20 +101,20 @@ bool Interpreter::isEqual(const Value& a, const Value& b) {
         return std::get<bool>(a) == std::get<bool>(b);
     } else if (std::holds_alternative<double>(a)) {
         return std::get<double>(a) == std::get<double>(b);
-    } else if (std::holds_alternative<std::string>(a)) {
-        return std::get<std::string>(a) == std::get<std::string>(b);
+    } else if (std::holds_alternative<CubeString>(a)) {
+        return std::get<CubeString>(a) == std::get<CubeString>(b);
     } else if (std::holds_alternative<ObjPtr>(a)) {
         return std::get<ObjPtr>(a) == std::get<ObjPtr>(b);
     }
     return false;
 }
 
-void Interpreter::checkNumberOperand(const Token& op, const Value& operand) {
+void Interpreter::checkNumberOperand(SourceLoc op, const Value& operand) {
     if (std::holds_alternative<double>(operand)) return;
     throw runtimeError(op, "Operand bir sayı olmalıdır.");
 }
 
-void Interpreter::checkNumberOperands(const Token& op, const Value& left, const Value& right) {
+void Interpreter::checkNumberOperands(SourceLoc op, const Value& left, const Value& right) {
     if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right)) return;
     throw runtimeError(op, "Operanlar sayı olmalıdır.");
 }
@@ -95,13 +123,15 @@ RuntimeException Interpreter::runtimeError(const Token& token, const std::string
     return RuntimeException(token, message);
 }
 
+RuntimeException Interpreter::runtimeError(SourceLoc loc, const std::string& message) {
+    return RuntimeException(sourceMap().token(loc), message);
+}
+
 void Interpreter::executeBlock(const std::vector<StmtPtr>& statements, std::shared_ptr<Environment> newEnvironment) {
     std::shared_ptr<Environment> previousEnvironment = this->environment;
+    // Çağıranın ortamı blok sürerken yalnızca bu yerelde kalır; GC'ye yığın kökü olarak bildirilir
+    GcStackRoot callerRoot(gc, previousEnvironment.get());
     this->environment = newEnvironment;
-    // Gc'ye yeni ortamı root olarak bildirmek (eğer Environment'lar ObjPtr yönetiyorsa)
-    // Şu anki Environment tasarımı ObjPtr tutmuyor, Value tutuyor.
-    // Bu nedenle, Environment'ın içindeki ObjPtr'ları GC'nin mark aşamasında taraması gerekecek.
-    // Eğer Environment'ın kendisi de ObjPtr olsaydı, burada Gc::addRoot(environment_obj) yapılırdı.
 
     try {
         for (const auto& stmt : statements) {
@@ -114,54 +144,177 @@ void Interpreter::executeBlock(const std::vector<StmtPtr>& statements, std::shar
     this->environment = previousEnvironment;
 }
 
+void Interpreter::ensureFunctionBody(FunStmt& declaration) {
+    if (declaration.bodyParsed) return;
+    Parser::parseLazyBody(declaration, allocator);
+}
+
+void Interpreter::executeCompiledBlock(const CompiledBlock& block, std::shared_ptr<Environment> newEnvironment) {
+    std::shared_ptr<Environment> previousEnvironment = this->environment;
+    GcStackRoot callerRoot(gc, previousEnvironment.get());
+    this->environment = newEnvironment;
+    try {
+        block.run(*this);
+    } catch (...) {
+        this->environment = previousEnvironment;
+        throw;
+    }
+    this->environment = previousEnvironment;
+}
+
+namespace {
+// Yan tablodaki düğüm durumu; yoksa (ya da adres serbest kalmış bir düğümden yeni düğüme
+// geçtiyse) boş durum kurulur ve created true olur. Süresi dolmuş kayıtlar tablo iki katına
+// çıktıkça temizlenir (amortize O(1)); canlı düğümlerin kayıtları yerinden oynamaz.
+template <typename State, typename Node>
+State& sideTableEntry(std::unordered_map<const Node*, State>& table, size_t& pruneAt,
+                      const std::shared_ptr<Node>& node, bool& created) {
+    if (table.size() >= pruneAt) {
+        for (auto it = table.begin(); it != table.end();) {
+            it = it->second.node.expired() ? table.erase(it) : std::next(it);
+        }
+        pruneAt = std::max<size_t>(64, table.size() * 2);
+    }
+    State& state = table[node.get()];
+    created = state.node.expired();
+    if (created) {
+        state = State{};
+        state.node = node;
+    }
+    return state;
+}
+} // namespace
+
+Interpreter::FunctionState& Interpreter::functionState(const std::shared_ptr<FunStmt>& declaration) {
+    bool created = false;
+    FunctionState& state = sideTableEntry(functionStates, functionStatesPruneAt, declaration, created);
+    // Derlenmiş modüllerin gövdesi düğümü kuran AotRuntime'dan alınır
+    if (created) state.aotBody = AotRuntime::bodyOf(*declaration);
+    return state;
+}
+
+Interpreter::LoopState& Interpreter::loopState(const std::shared_ptr<WhileStmt>& loop) {
+    bool created = false;
+    return sideTableEntry(loopStates, loopStatesPruneAt, loop, created);
+}
+
+void Interpreter::executeFunctionBody(FunStmt& declaration, FunctionState& state,
+                                      std::shared_ptr<Environment> functionEnvironment) {
+    ensureFunctionBody(declaration);
+    if (execMode == ExecMode::Closure) {
+        if (!state.compiledBody) {
+            state.compiledBody = ClosureCompiler::compile(declaration.body);
+        }
+        std::shared_ptr<const CompiledBlock> compiled = state.compiledBody; // Yürütme sırasında canlı kalsın
+        executeCompiledBlock(*compiled, functionEnvironment);
+        return;
+    }
+    if (execMode == ExecMode::Flat) {
+        if (!state.flatBody) {
+            state.flatBody = std::make_shared<const FlatAst>(FlatAst::lower(declaration.body));
+        }
+        std::shared_ptr<const FlatAst> flat = state.flatBody; // Yürütme sırasında canlı kalsın
+        executeFlatBlock(*flat, flat->rootBegin, flat->rootCount, functionEnvironment);
+        return;
+    }
+    executeBlock(declaration.body, functionEnvironment);
+}
+
+Value Interpreter::executeAotBody(const AotFunction& body, std::shared_ptr<Environment> functionEnvironment) {
+    std::shared_ptr<Environment> previousEnvironment = this->environment;
+    GcStackRoot callerRoot(gc, previousEnvironment.get());
+    this->environment = functionEnvironment;
+    Value result;
+    try {
+        result = body.body(*this);
+    } catch (...) {
+        this->environment = previousEnvironment;
+        throw;
+    }
+    this->environment = previousEnvironment;
+    return result;
+}
+
+bool Interpreter::callJitted(FunStmt& declaration, FunctionState& state, const std::vector<Value>& arguments, Value& result) {
+    if (state.jitRejected) return false;
+    if (!state.jitCode) {
+        ensureFunctionBody(declaration);
+        state.jitCode = JitCompiler::compile(declaration);
+        if (!state.jitCode) {
+            state.jitRejected = true;
+            return false;
+        }
+    }
+    std::shared_ptr<const JitCode> code = state.jitCode; // Yürütme sırasında canlı kalsın
+    return code->run(arguments, result);
+}
+
 Value Interpreter::lookUpVariable(const Token& name) {
-    if (environment->contains(name.lexeme)) {
+    if (environment->contains(std::string(name.lexeme))) {
         return environment->get(name);
-    } else if (globals->contains(name.lexeme)) {
+    } else if (globals->contains(std::string(name.lexeme))) {
         return globals->get(name);
     }
-    throw runtimeError(name, "Tanımlanmamış değişken '" + name.lexeme + "'.");
+    throw runtimeError(name, "Tanımlanmamış değişken '" + std::string(name.lexeme) + "'.");
+}
+
+Value Interpreter::lookUpVariable(const std::string& name, SourceLoc loc) {
+    if (environment->contains(name)) {
+        return environment->get(name, loc);
+    } else if (globals->contains(name)) {
+        return globals->get(name, loc);
+    }
+    throw runtimeError(loc, "Tanımlanmamış değişken '" + name + "'.");
 }
 
 // --- ExprVisitor Metotlarının Implementasyonları ---
 
+Value Interpreter::visitAssignExpr(std::shared_ptr<AssignExpr> expr) {
+    Value value = evaluate(expr->value);
+    environment->assign(names().spelling(expr->name), value, expr->loc); // Kapsam zincirinde yukarı doğru arar, bulamazsa hata fırlatır
+    return value;
+}
+
 Value Interpreter::visitBinaryExpr(std::shared_ptr<BinaryExpr> expr) {
     // ... (Öncekiyle aynı, ObjPtr oluşturmuyor)
     Value left = evaluate(expr->left);
     Value right = evaluate(expr->right);
+    return binaryOp(expr->op, expr->loc, left, right);
+}
 
-    switch (expr->op.type) {
+Value Interpreter::binaryOp(TokenType op, SourceLoc loc, const Value& left, const Value& right) {
+    switch (op) {
         case TokenType::MINUS:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             return std::get<double>(left) - std::get<double>(right);
         case TokenType::SLASH:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             if (std::get<double>(right) == 0.0) {
-                throw runtimeError(expr->op, "Sıfıra bölme hatası.");
+                throw runtimeError(loc, "Sıfıra bölme hatası.");
             }
             return std::get<double>(left) / std::get<double>(right);
         case TokenType::STAR:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             return std::get<double>(left) * std::get<double>(right);
         case TokenType::PLUS:
             if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right)) {
                 return std::get<double>(left) + std::get<double>(right);
             }
-            if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right)) {
-                return std::get<std::string>(left) + std::get<std::string>(right);
+            if (std::holds_alternative<CubeString>(left) && std::holds_alternative<CubeString>(right)) {
+                return std::get<CubeString>(left).str() + std::get<CubeString>(right).str();
             }
-            throw runtimeError(expr->op, "Operanlar sayılar veya stringler olmalıdır.");
+            throw runtimeError(loc, "Operanlar sayılar veya stringler olmalıdır.");
         case TokenType::GREATER:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             return std::get<double>(left) > std::get<double>(right);
         case TokenType::GREATER_EQUAL:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             return std::get<double>(left) >= std::get<double>(right);
         case TokenType::LESS:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             return std::get<double>(left) < std::get<double>(right);
         case TokenType::LESS_EQUAL:
-            checkNumberOperands(expr->op, left, right);
+            checkNumberOperands(loc, left, right);
             return std::get<double>(left) <= std::get<double>(right);
         case TokenType::BANG_EQUAL: return !isEqual(left, right);
         case TokenType::EQUAL_EQUAL: return isEqual(left, right);
@@ -172,57 +325,91 @@ Value Interpreter::visitBinaryExpr(std::shared_ptr<BinaryExpr> expr) {
 
 Value Interpreter::visitCallExpr(std::shared_ptr<CallExpr> expr) {
     Value callee = evaluate(expr->callee);
+    GcStackRoot calleeRoot(gc, callee); // Argümanlar değerlendirilirken de canlı kalmalı
 
     std::vector<Value> arguments;
+    GcStackRoot argumentRoots(gc, arguments);
     for (const auto& arg : expr->arguments) {
         arguments.push_back(evaluate(arg));
     }
+    return callValue(callee, arguments, expr->paren);
+}
 
+Value Interpreter::callValue(const Value& callee, const std::vector<Value>& arguments, SourceLoc paren) {
     if (!std::holds_alternative<ObjPtr>(callee)) {
-        throw runtimeError(expr->paren, "Sadece fonksiyonlar ve sınıflar çağrılabilir.");
+        throw runtimeError(paren, "Sadece fonksiyonlar ve sınıflar çağrılabilir.");
     }
 
     ObjPtr obj_callee = std::get<ObjPtr>(callee);
     if (!obj_callee->isCallable()) {
-        throw runtimeError(expr->paren, "Sadece fonksiyonlar ve sınıflar çağrılabilir.");
+        throw runtimeError(paren, "Sadece fonksiyonlar ve sınıflar çağrılabilir.");
     }
 
     Callable* callable = static_cast<Callable*>(obj_callee.get());
 
     if (arguments.size() != callable->arity()) {
-        throw runtimeError(expr->paren, "Beklenen " + std::to_string(callable->arity()) +
+        throw runtimeError(paren, "Beklenen " + std::to_string(callable->arity()) +
                                         " argüman, ancak " + std::to_string(arguments.size()) + " geldi.");
     }
 
+    // Çağrı sürerken callee ve argümanlar yalnızca çağıranın C++ yığınındadır
+    GcStackRoot calleeRoot(gc, callee);
+    GcStackRoot argumentRoots(gc, arguments);
     return callable->call(*this, arguments);
 }
 
 Value Interpreter::visitGetExpr(std::shared_ptr<GetExpr> expr) {
     Value object = evaluate(expr->object);
+    return getProperty(object, names().spelling(expr->name), expr->loc);
+}
 
+Value Interpreter::getProperty(const Value& object, const std::string& name, SourceLoc loc) {
     if (std::holds_alternative<ObjPtr>(object)) {
         ObjPtr instance = std::get<ObjPtr>(object);
         if (instance->getType() == Object::ObjectType::INSTANCE) {
             auto ccube_instance = std::static_pointer_cast<CCubeInstance>(instance);
-            Value result = ccube_instance->get(expr->name);
+            Value result = ccube_instance->get(name, loc);
             if (std::holds_alternative<ObjPtr>(result) &&
                 std::static_pointer_cast<CCubeFunction>(std::get<ObjPtr>(result))) {
-                // Metodu objeye bağla ve Gc aracılığıyla oluştur
-                return gc.createObject(std::make_shared<BoundMethod>(ccube_instance, std::static_pointer_cast<CCubeFunction>(std::get<ObjPtr>(result))));
+                // Metodu objeye bağla ve Gc aracılığıyla oluştur. Nesne geçici bir değer olabilir
+                // (örn. make().metot); bağlı metodun ayırması koleksiyon başlatırsa süpürülmemeli.
+                GcStackRoot objectRoot(gc, object);
+                return gc.createObject(gc.make<BoundMethod>(ccube_instance, std::static_pointer_cast<CCubeFunction>(std::get<ObjPtr>(result))));
             }
             return result;
         } else if (instance->getType() == Object::ObjectType::C_CUBE_MODULE) {
             auto module = std::static_pointer_cast<CCubeModule>(instance);
-            return module->getMember(expr->name);
+            return module->getMember(name, loc);
         }
     }
-    throw runtimeError(expr->name, "Sadece objeler, modüller veya sınıflar property'lere sahip olabilir.");
+    throw runtimeError(loc, "Sadece objeler, modüller veya sınıflar property'lere sahip olabilir.");
 }
 
 Value Interpreter::visitGroupingExpr(std::shared_ptr<GroupingExpr> expr) {
     return evaluate(expr->expression);
 }
 
+Value Interpreter::visitIndexExpr(std::shared_ptr<IndexExpr> expr) {
+    Value object = evaluate(expr->object);
+    GcStackRoot objectRoot(gc, object);
+    Value index = evaluate(expr->index);
+    return indexValue(object, index, expr->bracket);
+}
+
+Value Interpreter::indexValue(const Value& object, const Value& index, SourceLoc bracket) {
+    if (!std::holds_alternative<ObjPtr>(object) || std::get<ObjPtr>(object)->getType() != Object::ObjectType::LIST) {
+        throw runtimeError(bracket, "Sadece listeler dizinlenebilir.");
+    }
+    checkNumberOperand(bracket, index);
+    double position = std::get<double>(index);
+    auto list = std::static_pointer_cast<CCubeList>(std::get<ObjPtr>(object));
+    if (position < 0 || position != static_cast<double>(static_cast<size_t>(position)) ||
+        static_cast<size_t>(position) >= list->size()) {
+        throw runtimeError(bracket, "Liste dizin sınırları dışında.");
+    }
+    return list->get_at(static_cast<size_t>(position));
+}
+
 Value Interpreter::visitLiteralExpr(std::shared_ptr<LiteralExpr> expr) {
     return expr->value;
 }
@@ -231,7 +418,7 @@ Value Interpreter::visitLogicalExpr(std::shared_ptr<LogicalExpr> expr) {
     // ... (Öncekiyle aynı, ObjPtr oluşturmuyor)
     Value left = evaluate(expr->left);
 
-    if (expr->op.type == TokenType::OR) {
+    if (expr->op == TokenType::OR) {
         if (isTruthy(left)) return left;
     } else { // AND
         if (!isTruthy(left)) return left;
@@ -241,21 +428,27 @@ Value Interpreter::visitLogicalExpr(std::shared_ptr<LogicalExpr> expr) {
 
 Value Interpreter::visitSetExpr(std::shared_ptr<SetExpr> expr) {
     Value object = evaluate(expr->object);
-
-    if (!std::holds_alternative<ObjPtr>(object) || std::get<ObjPtr>(object)->getType() != Object::ObjectType::INSTANCE) {
-        throw runtimeError(expr->name, "Sadece objelerin property'leri atanabilir.");
-    }
+    GcStackRoot objectRoot(gc, object);
+    std::shared_ptr<CCubeInstance> instance = instanceForSet(object, expr->loc);
 
     Value value = evaluate(expr->value);
-    std::static_pointer_cast<CCubeInstance>(std::get<ObjPtr>(object))->set(expr->name, value);
+    instance->set(names().spelling(expr->name), value);
     return value;
 }
 
+std::shared_ptr<CCubeInstance> Interpreter::instanceForSet(const Value& object, SourceLoc loc) {
+    if (!std::holds_alternative<ObjPtr>(object) || std::get<ObjPtr>(object)->getType() != Object::ObjectType::INSTANCE) {
+        throw runtimeError(loc, "Sadece objelerin property'leri atanabilir.");
+    }
+    return std::static_pointer_cast<CCubeInstance>(std::get<ObjPtr>(object));
+}
+
 Value Interpreter::visitSuperExpr(std::shared_ptr<SuperExpr> expr) {
     // 'this' değişkenini ortamdan al
     // Not: Resolver bu token'ı correct depth'e bind etmeliydi.
     // Şimdilik, ortamda arama yaparak 'this'i bulmaya çalışalım.
-    Value this_value = environment->get(Token(TokenType::THIS, "this", std::monostate{}, expr->keyword.line));
+    static const std::string thisName = "this";
+    Value this_value = environment->get(thisName, expr->keyword);
     if (!std::holds_alternative<ObjPtr>(this_value) || std::get<ObjPtr>(this_value)->getType() != Object::ObjectType::INSTANCE) {
         throw runtimeError(expr->keyword, "'super' anahtar kelimesi sadece metot içinde kullanılabilir.");
     }
@@ -269,28 +462,33 @@ Value Interpreter::visitSuperExpr(std::shared_ptr<SuperExpr> expr) {
     }
 
     // Metodu üst sınıftan bul
-    std::shared_ptr<CCubeFunction> method = superclass->findMethod(expr->method.lexeme);
+    const std::string& methodName = names().spelling(expr->method);
+    std::shared_ptr<CCubeFunction> method = superclass->findMethod(methodName);
 
     if (method == nullptr) {
-        throw runtimeError(expr->method, "Tanımlanmamış üst sınıf metodu '" + expr->method.lexeme + "'.");
+        throw runtimeError(expr->methodLoc, "Tanımlanmamış üst sınıf metodu '" + methodName + "'.");
     }
 
     // Metodu mevcut instance'a bağla ve Gc aracılığıyla döndür
-    return gc.createObject(std::make_shared<BoundMethod>(instance, method));
+    return gc.createObject(gc.make<BoundMethod>(instance, method));
 }
 
 Value Interpreter::visitThisExpr(std::shared_ptr<ThisExpr> expr) {
-    return lookUpVariable(expr->keyword); // 'this' bir değişkendir
+    static const std::string thisName = "this";
+    return lookUpVariable(thisName, expr->keyword); // 'this' bir değişkendir
 }
 
 Value Interpreter::visitUnaryExpr(std::shared_ptr<UnaryExpr> expr) {
     // ... (Öncekiyle aynı, ObjPtr oluşturmuyor)
     Value right = evaluate(expr->right);
+    return unaryOp(expr->op, expr->loc, right);
+}
 
-    switch (expr->op.type) {
+Value Interpreter::unaryOp(TokenType op, SourceLoc loc, const Value& right) {
+    switch (op) {
         case TokenType::BANG: return !isTruthy(right);
         case TokenType::MINUS:
-            checkNumberOperand(expr->op, right);
+            checkNumberOperand(loc, right);
             return -std::get<double>(right);
         default: break;
     }
@@ -298,11 +496,12 @@ Value Interpreter::visitUnaryExpr(std::shared_ptr<UnaryExpr> expr) {
 }
 
 Value Interpreter::visitVariableExpr(std::shared_ptr<VariableExpr> expr) {
-    return lookUpVariable(expr->name);
+    return lookUpVariable(names().spelling(expr->name), expr->loc);
 }
 
 Value Interpreter::visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> expr) {
     std::vector<Value> elements;
+    GcStackRoot elementRoots(gc, elements);
     for (const auto& elem_expr : expr->elements) {
         elements.push_back(evaluate(elem_expr));
     }
@@ -314,7 +513,7 @@ Value Interpreter::visitListLiteralExpr(std::shared_ptr<ListLiteralExpr> expr) {
 // --- StmtVisitor Metotlarının Implementasyonları ---
 
 void Interpreter::visitBlockStmt(std::shared_ptr<BlockStmt> stmt) {
-    executeBlock(stmt->statements, std::make_shared<Environment>(environment));
+    executeBlock(stmt->statements, newEnvironment(environment));
 }
 
 void Interpreter::visitClassStmt(std::shared_ptr<ClassStmt> stmt) {
@@ -327,23 +526,24 @@ void Interpreter::visitClassStmt(std::shared_ptr<ClassStmt> stmt) {
             // Hata token'ı: superclass ifadesinin kendisi değil, superclass isminin token'ı olmalı.
             // Bu, 'superclass' bir VariableExpr ise, onun token'ını almak gerekir.
             // Şimdilik genel bir hata token'ı kullanıyoruz.
-            throw runtimeError(stmt->name, "Üst sınıf bir sınıf olmalıdır."); // Sınıfın adı token'ını kullan
+            throw runtimeError(stmt->loc, "Üst sınıf bir sınıf olmalıdır."); // Sınıfın adı token'ını kullan
         }
         superclass = std::static_pointer_cast<CCubeClass>(std::get<ObjPtr>(superclass_value));
     }
 
-    environment->define(stmt->name.lexeme, std::monostate{}); // Placeholder
+    const std::string& className = names().spelling(stmt->name);
+    environment->define(className, std::monostate{}); // Placeholder
 
     std::unordered_map<std::string, std::shared_ptr<CCubeFunction>> methods;
     for (const auto& method_stmt : stmt->methods) {
         // Fonksiyonu Gc aracılığıyla oluştur
-        std::shared_ptr<CCubeFunction> function = std::make_shared<CCubeFunction>(method_stmt, environment, method_stmt->name.lexeme == "init");
-        methods[method_stmt->name.lexeme] = function;
+        std::shared_ptr<CCubeFunction> function = gc.make<CCubeFunction>(method_stmt, environment, names().spelling(method_stmt->name) == "init");
+        methods[names().spelling(method_stmt->name)] = function;
     }
 
     // CCubeClass objesini Gc aracılığıyla oluştur ve global ortama ekle
-    std::shared_ptr<CCubeClass> klass = std::make_shared<CCubeClass>(stmt->name.lexeme, superclass, methods);
-    environment->assign(stmt->name, gc.createObject(klass)); // Sınıfı ortamda ata
+    std::shared_ptr<CCubeClass> klass = gc.make<CCubeClass>(className, superclass, methods);
+    environment->assign(className, gc.createObject(klass), stmt->loc); // Sınıfı ortamda ata
 }
 
 void Interpreter::visitExprStmt(std::shared_ptr<ExprStmt> stmt) {
@@ -352,8 +552,8 @@ void Interpreter::visitExprStmt(std::shared_ptr<ExprStmt> stmt) {
 
 void Interpreter::visitFunStmt(std::shared_ptr<FunStmt> stmt) {
     // Fonksiyonu Gc aracılığıyla oluştur
-    std::shared_ptr<CCubeFunction> function = std::make_shared<CCubeFunction>(stmt, environment, false);
-    environment->define(stmt->name.lexeme, gc.createObject(function));
+    std::shared_ptr<CCubeFunction> function = gc.make<CCubeFunction>(stmt, environment, false);
+    environment->define(names().spelling(stmt->name), gc.createObject(function));
 }
 
 void Interpreter::visitIfStmt(std::shared_ptr<IfStmt> stmt) {
@@ -366,12 +566,13 @@ void Interpreter::visitIfStmt(std::shared_ptr<IfStmt> stmt) {
 
 void Interpreter::visitImportStmt(std::shared_ptr<ImportStmt> stmt) {
     // Modülü yükle (ModuleLoader'ın Gc'yi kullanması gerekir)
-    std::shared_ptr<CCubeModule> module = moduleLoader.loadModule(stmt->moduleName, *this);
+    const std::string& moduleName = names().spelling(stmt->moduleName);
+    std::shared_ptr<CCubeModule> module = moduleLoader.loadModule(moduleName, *this);
     if (!module) {
-        throw runtimeError(stmt->moduleName, "Modül '" + stmt->moduleName.lexeme + "' bulunamadı veya yüklenemedi.");
+        throw runtimeError(stmt->loc, "Modül '" + moduleName + "' bulunamadı veya yüklenemedi.");
     }
 
-    std::string import_name = stmt->alias.empty() ? stmt->moduleName.lexeme : stmt->alias;
+    std::string import_name = stmt->alias.empty() ? moduleName : stmt->alias;
     environment->define(import_name, gc.createObject(module));
 }
 
@@ -388,15 +589,51 @@ void Interpreter::visitVarStmt(std::shared_ptr<VarStmt> stmt) {
     if (stmt->initializer != nullptr) {
         value = evaluate(stmt->initializer);
     }
-    environment->define(stmt->name.lexeme, value);
+    environment->define(names().spelling(stmt->name), value);
 }
 
 void Interpreter::visitWhileStmt(std::shared_ptr<WhileStmt> stmt) {
+    if (traceThreshold != 0) {
+        runTracedLoop(*stmt, loopState(stmt));
+        return;
+    }
     while (isTruthy(evaluate(stmt->condition))) {
         execute(stmt->body);
     }
 }
 
+void Interpreter::runTracedLoop(WhileStmt& loop, LoopState& state) {
+    constexpr uint8_t MAX_TRACE_FAILURES = 3;        // Sonrasında döngü hep yorumlanır
+    constexpr uint8_t MAX_UNPRODUCTIVE_ENTRIES = 16; // İz döngünün şimdiki yoluna uymuyor, atılır
+
+    while (true) {
+        if (state.trace == nullptr && state.traceFailures < MAX_TRACE_FAILURES && state.iterationCount >= traceThreshold) {
+            state.trace = TraceRecorder::record(loop, *environment, *globals);
+            if (state.trace == nullptr) {
+                ++state.traceFailures;
+                state.iterationCount = 0; // Yeniden denemeden önce döngü tekrar ısınsın
+            }
+        }
+        if (state.trace != nullptr) {
+            std::shared_ptr<const LoopTrace> trace = state.trace; // Yürütme sırasında canlı kalsın
+            uint64_t iterations = 0;
+            if (trace->run(*environment, *globals, iterations) == LoopTrace::Exit::LoopDone) return;
+            if (iterations > 0) {
+                state.unproductiveEntries = 0;
+            } else if (++state.unproductiveEntries >= MAX_UNPRODUCTIVE_ENTRIES) {
+                state.trace.reset();
+                state.unproductiveEntries = 0;
+                ++state.traceFailures;
+                state.iterationCount = 0;
+            }
+            // Muhafızın tutmadığı yineleme aşağıda yorumlayıcıyla baştan yürütülür
+        }
+        if (!isTruthy(evaluate(loop.condition))) return;
+        execute(loop.body);
+        if (state.iterationCount < traceThreshold) ++state.iterationCount;
+    }
+}
+
 void Interpreter::visitMatchStmt(std::shared_ptr<MatchStmt> stmt) {
     Value subject_value = evaluate(stmt->subject);
 
@@ -419,9 +656,9 @@ void Interpreter::visitMatchStmt(std::shared_ptr<MatchStmt> stmt) {
             }
         } else if (std::dynamic_pointer_cast<VariableExpr>(match_case.pattern)) {
             // Değişken deseni: her zaman eşleşir ve değeri değişkene atar
-            Token var_name = std::dynamic_pointer_cast<VariableExpr>(match_case.pattern)->name;
-            std::shared_ptr<Environment> case_env = std::make_shared<Environment>(environment);
-            case_env->define(var_name.lexeme, subject_value);
+            auto var_pattern = std::static_pointer_cast<VariableExpr>(match_case.pattern);
+            std::shared_ptr<Environment> case_env = newEnvironment(environment);
+            case_env->define(names().spelling(var_pattern->name), subject_value);
             // Match-case body'si bir BlockStmt olmalı
             if (auto block_body = std::dynamic_pointer_cast<BlockStmt>(match_case.body)) {
                  executeBlock(block_body->statements, case_env);
@@ -431,7 +668,7 @@ void Interpreter::visitMatchStmt(std::shared_ptr<MatchStmt> stmt) {
                  // Şimdilik, body'nin tek bir ifade olduğunu varsayalım ve yeni ortamda yürütelim.
                   execute(match_case.body); // Bu daha karmaşık bir durum.
                  // Match case body'leri genellikle bir BlockStmt olmalıdır.
-                 throw runtimeError(var_name, "Match case body'si bir blok olmalıdır.");
+                 throw runtimeError(var_pattern->loc, "Match case body'si bir blok olmalıdır.");
             }
             matched = true;
             break;
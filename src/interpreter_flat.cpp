@@ -0,0 +1,145 @@
+#include "interpreter.h"
+
+// Düz AST yürütücüsü (--exec=flat). Ağaç yürütücüsüyle aynı semantiği paylaşır: işlemler
+// binaryOp/callValue/... yardımcılarından, ortam ve hata yönetimi ağaç yürütücüsünden gelir.
+// Farkı düğümlerin visitor çağrısı yerine indeksle ve tür üzerinde switch ile dolaşılmasıdır.
+
+using Kind = FlatAst::Kind;
+
+Value Interpreter::evaluateFlat(const FlatAst& flat, FlatAst::Index node) {
+    const FlatAst::Index a = flat.a[node];
+    const FlatAst::Index b = flat.b[node];
+    const FlatAst::Index c = flat.c[node];
+    const SourceLoc loc = flat.locs[node];
+
+    switch (flat.kinds[node]) {
+        case Kind::LITERAL:
+            return flat.constants[a];
+        case Kind::VARIABLE:
+            return lookUpVariable(names().spelling(a), loc);
+        case Kind::ASSIGN: {
+            Value value = evaluateFlat(flat, b);
+            environment->assign(names().spelling(a), value, loc);
+            return value;
+        }
+        case Kind::UNARY:
+            return unaryOp(static_cast<TokenType>(a), loc, evaluateFlat(flat, b));
+        case Kind::BINARY: {
+            Value left = evaluateFlat(flat, b);
+            Value right = evaluateFlat(flat, c);
+            return binaryOp(static_cast<TokenType>(a), loc, left, right);
+        }
+        case Kind::LOGICAL: {
+            Value left = evaluateFlat(flat, b);
+            if (static_cast<TokenType>(a) == TokenType::OR) {
+                if (isTruthy(left)) return left;
+            } else { // AND
+                if (!isTruthy(left)) return left;
+            }
+            return evaluateFlat(flat, c);
+        }
+        case Kind::CALL: {
+            Value callee = evaluateFlat(flat, a);
+            GcStackRoot calleeRoot(gc, callee);
+            std::vector<Value> arguments;
+            GcStackRoot argumentRoots(gc, arguments);
+            arguments.reserve(c);
+            for (FlatAst::Index i = 0; i < c; ++i) {
+                arguments.push_back(evaluateFlat(flat, flat.lists[b + i]));
+            }
+            return callValue(callee, arguments, loc);
+        }
+        case Kind::GET:
+            return getProperty(evaluateFlat(flat, a), names().spelling(b), loc);
+        case Kind::SET: {
+            Value object = evaluateFlat(flat, a);
+            GcStackRoot objectRoot(gc, object);
+            std::shared_ptr<CCubeInstance> instance = instanceForSet(object, loc);
+            Value value = evaluateFlat(flat, c);
+            instance->set(names().spelling(b), value);
+            return value;
+        }
+        case Kind::INDEX: {
+            Value object = evaluateFlat(flat, a);
+            GcStackRoot objectRoot(gc, object);
+            Value index = evaluateFlat(flat, b);
+            return indexValue(object, index, loc);
+        }
+        case Kind::LIST: {
+            std::vector<Value> elements;
+            GcStackRoot elementRoots(gc, elements);
+            elements.reserve(c);
+            for (FlatAst::Index i = 0; i < c; ++i) {
+                elements.push_back(evaluateFlat(flat, flat.lists[b + i]));
+            }
+            return gc.createList(elements);
+        }
+        case Kind::THIS: {
+            static const std::string thisName = "this";
+            return lookUpVariable(thisName, loc);
+        }
+        case Kind::TREE_EXPR:
+            return evaluate(flat.treeExprs[a]);
+        default:
+            break;
+    }
+    throw runtimeError(loc, "Düz AST'de ifade beklenirken bildirim bulundu.");
+}
+
+void Interpreter::executeFlat(const FlatAst& flat, FlatAst::Index node) {
+    const FlatAst::Index a = flat.a[node];
+    const FlatAst::Index b = flat.b[node];
+    const FlatAst::Index c = flat.c[node];
+
+    switch (flat.kinds[node]) {
+        case Kind::EXPR_STMT:
+            evaluateFlat(flat, a);
+            return;
+        case Kind::VAR: {
+            Value value = b == FlatAst::NONE ? Value(std::monostate{}) : evaluateFlat(flat, b);
+            environment->define(names().spelling(a), value);
+            return;
+        }
+        case Kind::BLOCK:
+            executeFlatBlock(flat, b, c, newEnvironment(environment));
+            return;
+        case Kind::IF:
+            if (isTruthy(evaluateFlat(flat, a))) {
+                executeFlat(flat, b);
+            } else if (c != FlatAst::NONE) {
+                executeFlat(flat, c);
+            }
+            return;
+        case Kind::WHILE:
+            while (isTruthy(evaluateFlat(flat, a))) {
+                executeFlat(flat, b);
+            }
+            return;
+        case Kind::RETURN: {
+            Value value = a == FlatAst::NONE ? Value(std::monostate{}) : evaluateFlat(flat, a);
+            throw ReturnException(value);
+        }
+        case Kind::TREE_STMT:
+            execute(flat.treeStmts[a]);
+            return;
+        default:
+            break;
+    }
+    throw runtimeError(flat.locs[node], "Düz AST'de bildirim beklenirken ifade bulundu.");
+}
+
+void Interpreter::executeFlatBlock(const FlatAst& flat, FlatAst::Index begin, FlatAst::Index count,
+                                   std::shared_ptr<Environment> newEnvironment) {
+    std::shared_ptr<Environment> previousEnvironment = this->environment;
+    GcStackRoot callerRoot(gc, previousEnvironment.get());
+    this->environment = newEnvironment;
+    try {
+        for (FlatAst::Index i = 0; i < count; ++i) {
+            executeFlat(flat, flat.lists[begin + i]);
+        }
+    } catch (...) {
+        this->environment = previousEnvironment;
+        throw;
+    }
+    this->environment = previousEnvironment;
+}
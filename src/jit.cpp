@@ -0,0 +1,529 @@
+#include "jit.h"
+
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define C_CUBE_JIT_X86_64 1
+#endif
+
+namespace {
+
+// --- Şablonlar ---
+// Her şablon tek bir işlemin makine kodudur. Değerler xmm0'da hesaplanır; ikili işlemlerin sol
+// işleneni makine yığınına itilir, sağ işlenen xmm1'e alınır. rdi slot dizisini, rsi sonucun
+// yazılacağı adresi gösterir; rbp girişteki yığın göstergesini saklar, böylece her çıkış (kurtarma
+// dahil) yığını tek hamlede geri alır.
+
+enum class HoleKind : uint8_t {
+    Imm64,  // 64 bit sabit (double bitleri)
+    Disp32, // Slot ofseti (slot * 8)
+    Rel32   // Etikete göre atlama mesafesi
+};
+
+struct Hole {
+    uint8_t offset;
+    HoleKind kind;
+};
+
+struct Stencil {
+    std::vector<uint8_t> code;
+    std::vector<Hole> holes;
+};
+
+const Stencil PROLOGUE = {{0x55,                    // push rbp
+                           0x48, 0x89, 0xE5},       // mov rbp, rsp
+                          {}};
+const Stencil RETURN_VALUE = {{0xF2, 0x0F, 0x11, 0x06,       // movsd [rsi], xmm0
+                               0xB8, 0x01, 0x00, 0x00, 0x00, // mov eax, RETURNED_VALUE
+                               0x48, 0x89, 0xEC,             // mov rsp, rbp
+                               0x5D, 0xC3},                  // pop rbp; ret
+                              {}};
+const Stencil RETURN_NONE = {{0xB8, 0x02, 0x00, 0x00, 0x00, // mov eax, RETURNED_NONE
+                              0x48, 0x89, 0xEC,             // mov rsp, rbp
+                              0x5D, 0xC3},                  // pop rbp; ret
+                             {}};
+const Stencil BAILOUT = {{0x31, 0xC0,       // xor eax, eax (BAILOUT)
+                          0x48, 0x89, 0xEC, // mov rsp, rbp
+                          0x5D, 0xC3},      // pop rbp; ret
+                         {}};
+
+const Stencil LOAD_CONST = {{0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, // mov rax, imm64
+                             0x66, 0x48, 0x0F, 0x6E, 0xC0},     // movq xmm0, rax
+                            {{2, HoleKind::Imm64}}};
+const Stencil LOAD_SLOT = {{0xF2, 0x0F, 0x10, 0x87, 0, 0, 0, 0}, // movsd xmm0, [rdi + disp32]
+                           {{4, HoleKind::Disp32}}};
+const Stencil STORE_SLOT = {{0xF2, 0x0F, 0x11, 0x87, 0, 0, 0, 0}, // movsd [rdi + disp32], xmm0
+                            {{4, HoleKind::Disp32}}};
+
+// Sağ işlenen literal ya da değişkense yığına gerek kalmadan doğrudan xmm1'e yüklenir
+const Stencil LOAD_CONST_RIGHT = {{0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, // mov rax, imm64
+                                   0x66, 0x48, 0x0F, 0x6E, 0xC8},     // movq xmm1, rax
+                                  {{2, HoleKind::Imm64}}};
+const Stencil LOAD_SLOT_RIGHT = {{0xF2, 0x0F, 0x10, 0x8F, 0, 0, 0, 0}, // movsd xmm1, [rdi + disp32]
+                                 {{4, HoleKind::Disp32}}};
+
+const Stencil PUSH_LEFT = {{0x48, 0x83, 0xEC, 0x08,        // sub rsp, 8
+                            0xF2, 0x0F, 0x11, 0x04, 0x24}, // movsd [rsp], xmm0
+                           {}};
+const Stencil POP_LEFT = {{0x66, 0x0F, 0x28, 0xC8,       // movapd xmm1, xmm0
+                           0xF2, 0x0F, 0x10, 0x04, 0x24, // movsd xmm0, [rsp]
+                           0x48, 0x83, 0xC4, 0x08},      // add rsp, 8
+                          {}};
+
+const Stencil ADD = {{0xF2, 0x0F, 0x58, 0xC1}, {}}; // addsd xmm0, xmm1
+const Stencil SUB = {{0xF2, 0x0F, 0x5C, 0xC1}, {}}; // subsd xmm0, xmm1
+const Stencil MUL = {{0xF2, 0x0F, 0x59, 0xC1}, {}}; // mulsd xmm0, xmm1
+const Stencil DIV = {{0xF2, 0x0F, 0x5E, 0xC1}, {}}; // divsd xmm0, xmm1
+
+// Bölen sıfırsa kurtarmaya atlar (NaN sıfır sayılmaz)
+const Stencil CHECK_DIVISOR = {{0x66, 0x0F, 0x57, 0xD2,  // xorpd xmm2, xmm2
+                                0x66, 0x0F, 0x2E, 0xCA,  // ucomisd xmm1, xmm2
+                                0x7A, 0x06,              // jp +6
+                                0x0F, 0x84, 0, 0, 0, 0}, // je rel32
+                               {{12, HoleKind::Rel32}}};
+
+// Karşılaştırmalar al'deki bayrağı 0.0/1.0 olarak xmm0'a yazar. NaN ile her karşılaştırma
+// yanlıştır (!= hariç), yorumlayıcıdaki double karşılaştırmalarıyla aynı.
+#define C_CUBE_JIT_BOOL_RESULT 0x0F, 0xB6, 0xC0, /* movzx eax, al */ 0xF2, 0x0F, 0x2A, 0xC0 /* cvtsi2sd xmm0, eax */
+const Stencil LESS = {{0x66, 0x0F, 0x2E, 0xC8, // ucomisd xmm1, xmm0
+                       0x0F, 0x97, 0xC0,       // seta al
+                       C_CUBE_JIT_BOOL_RESULT},
+                      {}};
+const Stencil LESS_EQUAL = {{0x66, 0x0F, 0x2E, 0xC8, // ucomisd xmm1, xmm0
+                             0x0F, 0x93, 0xC0,       // setae al
+                             C_CUBE_JIT_BOOL_RESULT},
+                            {}};
+const Stencil GREATER = {{0x66, 0x0F, 0x2E, 0xC1, // ucomisd xmm0, xmm1
+                          0x0F, 0x97, 0xC0,       // seta al
+                          C_CUBE_JIT_BOOL_RESULT},
+                         {}};
+const Stencil GREATER_EQUAL = {{0x66, 0x0F, 0x2E, 0xC1, // ucomisd xmm0, xmm1
+                                0x0F, 0x93, 0xC0,       // setae al
+                                C_CUBE_JIT_BOOL_RESULT},
+                               {}};
+const Stencil EQUAL = {{0x66, 0x0F, 0x2E, 0xC1, // ucomisd xmm0, xmm1
+                        0x0F, 0x94, 0xC0,       // sete al
+                        0x0F, 0x9B, 0xC1,       // setnp cl
+                        0x20, 0xC8,             // and al, cl
+                        C_CUBE_JIT_BOOL_RESULT},
+                       {}};
+const Stencil NOT_EQUAL = {{0x66, 0x0F, 0x2E, 0xC1, // ucomisd xmm0, xmm1
+                            0x0F, 0x95, 0xC0,       // setne al
+                            0x0F, 0x9A, 0xC1,       // setp cl
+                            0x08, 0xC8,             // or al, cl
+                            C_CUBE_JIT_BOOL_RESULT},
+                           {}};
+
+const Stencil NEGATE = {{0x66, 0x48, 0x0F, 0x7E, 0xC0,  // movq rax, xmm0
+                         0x48, 0x0F, 0xBA, 0xF8, 0x3F,  // btc rax, 63
+                         0x66, 0x48, 0x0F, 0x6E, 0xC0}, // movq xmm0, rax
+                        {}};
+
+// Doğruluk testi: bool'lar 0.0/1.0 tutulduğu için isTruthy ile aynı kural (x != 0.0, NaN doğru)
+// hem sayılara hem bool'lara uyar
+#define C_CUBE_JIT_TEST_TRUTHY 0x66, 0x0F, 0x57, 0xC9, /* xorpd xmm1, xmm1 */ 0x66, 0x0F, 0x2E, 0xC1 /* ucomisd xmm0, xmm1 */
+const Stencil NOT = {{C_CUBE_JIT_TEST_TRUTHY,
+                      0x0F, 0x94, 0xC0, // sete al
+                      0x0F, 0x9B, 0xC1, // setnp cl
+                      0x20, 0xC8,       // and al, cl
+                      C_CUBE_JIT_BOOL_RESULT},
+                     {}};
+const Stencil JUMP_IF_FALSE = {{C_CUBE_JIT_TEST_TRUTHY,
+                                0x7A, 0x06,              // jp +6
+                                0x0F, 0x84, 0, 0, 0, 0}, // je rel32
+                               {{12, HoleKind::Rel32}}};
+const Stencil JUMP_IF_TRUE = {{C_CUBE_JIT_TEST_TRUTHY,
+                               0x0F, 0x8A, 0, 0, 0, 0,  // jp rel32
+                               0x0F, 0x85, 0, 0, 0, 0}, // jne rel32
+                              {{10, HoleKind::Rel32}, {16, HoleKind::Rel32}}};
+const Stencil JUMP = {{0xE9, 0, 0, 0, 0}, // jmp rel32
+                      {{1, HoleKind::Rel32}}};
+#undef C_CUBE_JIT_BOOL_RESULT
+#undef C_CUBE_JIT_TEST_TRUTHY
+
+// Şablonları art arda kopyalar ve boşluklarını yamalar. Atlamalar ileriye dönük olabildiği için
+// Rel32 boşlukları etiket bağlandıktan sonra, finish() içinde doldurulur.
+class StencilAssembler {
+public:
+    using Label = size_t;
+
+    Label newLabel() {
+        labels.push_back(UNBOUND);
+        return labels.size() - 1;
+    }
+    void bind(Label label) { labels[label] = code.size(); }
+
+    void emit(const Stencil& stencil, uint64_t value = 0, Label target = 0) {
+        size_t start = code.size();
+        code.insert(code.end(), stencil.code.begin(), stencil.code.end());
+        for (const Hole& hole : stencil.holes) {
+            uint8_t* at = code.data() + start + hole.offset;
+            switch (hole.kind) {
+                case HoleKind::Imm64:
+                    std::memcpy(at, &value, sizeof(value));
+                    break;
+                case HoleKind::Disp32: {
+                    int32_t displacement = static_cast<int32_t>(value);
+                    std::memcpy(at, &displacement, sizeof(displacement));
+                    break;
+                }
+                case HoleKind::Rel32:
+                    fixups.push_back({start + hole.offset, target});
+                    break;
+            }
+        }
+    }
+
+    std::vector<uint8_t> finish() {
+        for (const Fixup& fixup : fixups) {
+            // Mesafe, rel32 alanının bittiği yere (sonraki komuta) göredir
+            int32_t distance = static_cast<int32_t>(static_cast<int64_t>(labels[fixup.label]) -
+                                                    static_cast<int64_t>(fixup.at + 4));
+            std::memcpy(code.data() + fixup.at, &distance, sizeof(distance));
+        }
+        return std::move(code);
+    }
+
+private:
+    static constexpr size_t UNBOUND = SIZE_MAX;
+    struct Fixup {
+        size_t at;
+        Label label;
+    };
+
+    std::vector<uint8_t> code;
+    std::vector<size_t> labels;
+    std::vector<Fixup> fixups;
+};
+
+// --- Alt küme derleyicisi ---
+
+enum class JitType : uint8_t { Number, Bool };
+
+// Gövde alt küme dışında bir düğüm içeriyor; fonksiyon yorumlayıcıda kalır
+struct Unsupported {};
+
+uint64_t bitsOf(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Gövdeyi dolaşıp şablonları yayar. Her değişken bildirimi kendi slotunu alır; kapsamlar
+// derleme zamanında çözülür, bu yüzden makine kodu yalnızca slot ofsetleriyle çalışır.
+// İfade visit'leri sonucun statik türünü döndürür.
+class JitLowering : public ExprVisitor<JitType>, public StmtVisitor<void> {
+public:
+    explicit JitLowering(const FunStmt& declaration) : declaration(declaration) {}
+
+    void lower() {
+        bailout = assembler.newLabel();
+        assembler.emit(PROLOGUE);
+        // Parametreler ve gövdenin üst düzey bildirimleri aynı ortamı paylaşır (bkz. CCubeFunction::call)
+        scopes.emplace_back();
+        for (Name param : declaration.params) declare(param, JitType::Number);
+        for (const auto& statement : declaration.body) stmt(statement);
+        assembler.emit(RETURN_NONE);
+        assembler.bind(bailout);
+        assembler.emit(BAILOUT);
+    }
+
+    std::vector<uint8_t> finish() { return assembler.finish(); }
+    size_t getSlotCount() const { return slotCount; }
+    JitCode::ReturnType getReturnType() const {
+        return returnType == JitType::Bool ? JitCode::ReturnType::Bool : JitCode::ReturnType::Number;
+    }
+
+    // --- İfadeler ---
+    JitType visitAssignExpr(std::shared_ptr<AssignExpr> node) override {
+        const Slot& slot = assignTarget(node->name);
+        if (expr(node->value) != slot.type) throw Unsupported{}; // Değişkenin türü değişemez
+        assembler.emit(STORE_SLOT, slot.offset());
+        return slot.type;
+    }
+    JitType visitBinaryExpr(std::shared_ptr<BinaryExpr> node) override {
+        JitType left = expr(node->left);
+        JitType right = operand(node->right);
+        switch (node->op) {
+            case TokenType::PLUS: return arithmetic(left, right, ADD);
+            case TokenType::MINUS: return arithmetic(left, right, SUB);
+            case TokenType::STAR: return arithmetic(left, right, MUL);
+            case TokenType::SLASH:
+                requireNumbers(left, right);
+                assembler.emit(CHECK_DIVISOR, 0, bailout); // Hata mesajını yorumlayıcı üretsin
+                assembler.emit(DIV);
+                return JitType::Number;
+            case TokenType::LESS: return comparison(left, right, LESS);
+            case TokenType::LESS_EQUAL: return comparison(left, right, LESS_EQUAL);
+            case TokenType::GREATER: return comparison(left, right, GREATER);
+            case TokenType::GREATER_EQUAL: return comparison(left, right, GREATER_EQUAL);
+            case TokenType::EQUAL_EQUAL: return equality(left, right, EQUAL);
+            case TokenType::BANG_EQUAL: return equality(left, right, NOT_EQUAL);
+            default: throw Unsupported{};
+        }
+    }
+    JitType visitCallExpr(std::shared_ptr<CallExpr>) override { throw Unsupported{}; }
+    JitType visitGetExpr(std::shared_ptr<GetExpr>) override { throw Unsupported{}; }
+    JitType visitGroupingExpr(std::shared_ptr<GroupingExpr> node) override { return expr(node->expression); }
+    JitType visitIndexExpr(std::shared_ptr<IndexExpr>) override { throw Unsupported{}; }
+    JitType visitLiteralExpr(std::shared_ptr<LiteralExpr> node) override {
+        JitType type = literalType(*node);
+        assembler.emit(LOAD_CONST, literalBits(*node));
+        return type;
+    }
+    JitType visitLogicalExpr(std::shared_ptr<LogicalExpr> node) override {
+        // and/or işlenenin kendisini döndürür; iki tarafın türü aynıysa sonuç türü de bellidir
+        StencilAssembler::Label end = assembler.newLabel();
+        JitType left = expr(node->left);
+        assembler.emit(node->op == TokenType::OR ? JUMP_IF_TRUE : JUMP_IF_FALSE, 0, end);
+        if (expr(node->right) != left) throw Unsupported{};
+        assembler.bind(end);
+        return left;
+    }
+    JitType visitSetExpr(std::shared_ptr<SetExpr>) override { throw Unsupported{}; }
+    JitType visitSuperExpr(std::shared_ptr<SuperExpr>) override { throw Unsupported{}; }
+    JitType visitThisExpr(std::shared_ptr<ThisExpr>) override { throw Unsupported{}; }
+    JitType visitUnaryExpr(std::shared_ptr<UnaryExpr> node) override {
+        JitType right = expr(node->right);
+        switch (node->op) {
+            case TokenType::MINUS:
+                if (right != JitType::Number) throw Unsupported{};
+                assembler.emit(NEGATE);
+                return JitType::Number;
+            case TokenType::BANG:
+                assembler.emit(NOT);
+                return JitType::Bool;
+            default: throw Unsupported{};
+        }
+    }
+    JitType visitVariableExpr(std::shared_ptr<VariableExpr> node) override {
+        const Slot& slot = read(node->name);
+        assembler.emit(LOAD_SLOT, slot.offset());
+        return slot.type;
+    }
+    JitType visitListLiteralExpr(std::shared_ptr<ListLiteralExpr>) override { throw Unsupported{}; }
+
+    // --- Bildirimler ---
+    void visitBlockStmt(std::shared_ptr<BlockStmt> node) override {
+        scopes.emplace_back();
+        for (const auto& statement : node->statements) stmt(statement);
+        scopes.pop_back();
+    }
+    void visitClassStmt(std::shared_ptr<ClassStmt>) override { throw Unsupported{}; }
+    void visitExprStmt(std::shared_ptr<ExprStmt> node) override { expr(node->expression); }
+    void visitFunStmt(std::shared_ptr<FunStmt>) override { throw Unsupported{}; }
+    void visitIfStmt(std::shared_ptr<IfStmt> node) override {
+        StencilAssembler::Label elseBranch = assembler.newLabel();
+        expr(node->condition);
+        assembler.emit(JUMP_IF_FALSE, 0, elseBranch);
+        stmt(node->thenBranch);
+        if (node->elseBranch == nullptr) {
+            assembler.bind(elseBranch);
+            return;
+        }
+        StencilAssembler::Label end = assembler.newLabel();
+        assembler.emit(JUMP, 0, end);
+        assembler.bind(elseBranch);
+        stmt(node->elseBranch);
+        assembler.bind(end);
+    }
+    void visitImportStmt(std::shared_ptr<ImportStmt>) override { throw Unsupported{}; }
+    void visitReturnStmt(std::shared_ptr<ReturnStmt> node) override {
+        if (node->value == nullptr) {
+            assembler.emit(RETURN_NONE);
+            return;
+        }
+        JitType type = expr(node->value);
+        if (returnType && *returnType != type) throw Unsupported{}; // Tüm dönüşler aynı türde olmalı
+        returnType = type;
+        assembler.emit(RETURN_VALUE);
+    }
+    void visitVarStmt(std::shared_ptr<VarStmt> node) override {
+        if (node->initializer == nullptr) throw Unsupported{}; // none değeri alt kümede yok
+        JitType type = expr(node->initializer); // Başlangıç değeri, yeni ad tanımlanmadan hesaplanır
+        assembler.emit(STORE_SLOT, declare(node->name, type).offset());
+    }
+    void visitWhileStmt(std::shared_ptr<WhileStmt> node) override {
+        StencilAssembler::Label top = assembler.newLabel();
+        StencilAssembler::Label end = assembler.newLabel();
+        assembler.bind(top);
+        expr(node->condition);
+        assembler.emit(JUMP_IF_FALSE, 0, end);
+        stmt(node->body);
+        assembler.emit(JUMP, 0, top);
+        assembler.bind(end);
+    }
+    void visitMatchStmt(std::shared_ptr<MatchStmt>) override { throw Unsupported{}; }
+
+private:
+    struct Slot {
+        size_t index;
+        JitType type;
+        uint64_t offset() const { return index * sizeof(double); }
+    };
+
+    JitType expr(const ExprPtr& node) { return node->accept(static_cast<ExprVisitor<JitType>&>(*this)); }
+    void stmt(const StmtPtr& node) {
+        if (node == nullptr) return;
+        node->accept(static_cast<StmtVisitor<void>&>(*this));
+    }
+
+    // İkili işlemin sağ işleneni: literal ve değişkenler doğrudan xmm1'e, diğerleri yığın üzerinden
+    JitType operand(const ExprPtr& node) {
+        if (auto literal = std::dynamic_pointer_cast<LiteralExpr>(node)) {
+            JitType type = literalType(*literal);
+            assembler.emit(LOAD_CONST_RIGHT, literalBits(*literal));
+            return type;
+        }
+        if (auto variable = std::dynamic_pointer_cast<VariableExpr>(node)) {
+            const Slot& slot = read(variable->name);
+            assembler.emit(LOAD_SLOT_RIGHT, slot.offset());
+            return slot.type;
+        }
+        assembler.emit(PUSH_LEFT);
+        JitType type = expr(node);
+        assembler.emit(POP_LEFT);
+        return type;
+    }
+
+    static void requireNumbers(JitType left, JitType right) {
+        if (left != JitType::Number || right != JitType::Number) throw Unsupported{};
+    }
+    JitType arithmetic(JitType left, JitType right, const Stencil& stencil) {
+        requireNumbers(left, right); // String birleştirme ve tür hataları yorumlayıcıda kalır
+        assembler.emit(stencil);
+        return JitType::Number;
+    }
+    JitType comparison(JitType left, JitType right, const Stencil& stencil) {
+        requireNumbers(left, right);
+        assembler.emit(stencil);
+        return JitType::Bool;
+    }
+    JitType equality(JitType left, JitType right, const Stencil& stencil) {
+        if (left != right) throw Unsupported{};
+        assembler.emit(stencil);
+        return JitType::Bool;
+    }
+
+    static JitType literalType(const LiteralExpr& literal) {
+        if (std::holds_alternative<double>(literal.value)) return JitType::Number;
+        if (std::holds_alternative<bool>(literal.value)) return JitType::Bool;
+        throw Unsupported{};
+    }
+    static uint64_t literalBits(const LiteralExpr& literal) {
+        if (const double* number = std::get_if<double>(&literal.value)) return bitsOf(*number);
+        return bitsOf(std::get<bool>(literal.value) ? 1.0 : 0.0);
+    }
+
+    const Slot& declare(Name name, JitType type) {
+        Slot& slot = scopes.back()[name];
+        slot = Slot{slotCount++, type};
+        return slot;
+    }
+    // lookUpVariable yalnızca en içteki ortama, sonra globals'a bakar. Dış bloktaki yerel okunamaz
+    // (yorumlayıcı onu değil globals'taki aynı adı bulur); globals ve closure değişkenlerinin de
+    // değeri ve türü çağrılar arasında değişebilir.
+    const Slot& read(Name name) const {
+        auto found = scopes.back().find(name);
+        if (found != scopes.back().end()) return found->second;
+        throw Unsupported{};
+    }
+    // Environment::assign ise ortam zincirinde içten dışa arar
+    const Slot& assignTarget(Name name) const {
+        for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+            auto found = scope->find(name);
+            if (found != scope->end()) return found->second;
+        }
+        throw Unsupported{}; // Global ya da closure değişkeni
+    }
+
+    const FunStmt& declaration;
+    StencilAssembler assembler;
+    StencilAssembler::Label bailout = 0;
+    std::vector<std::unordered_map<Name, Slot>> scopes;
+    size_t slotCount = 0;
+    std::optional<JitType> returnType;
+};
+
+} // namespace
+
+JitCode::JitCode(void* memory, size_t mappedSize, size_t codeSize, size_t paramCount, size_t slotCount,
+                 ReturnType returnType)
+    : memory(memory), mappedSize(mappedSize), codeSize(codeSize), paramCount(paramCount), slotCount(slotCount),
+      returnType(returnType) {}
+
+JitCode::~JitCode() {
+#ifdef C_CUBE_JIT_X86_64
+    munmap(memory, mappedSize);
+#endif
+}
+
+bool JitCode::run(const std::vector<Value>& arguments, Value& result) const {
+    if (arguments.size() != paramCount) return false;
+
+    // Küçük çerçeveler yığında, büyükler heap'te
+    constexpr size_t INLINE_SLOTS = 16;
+    double inlineSlots[INLINE_SLOTS];
+    std::vector<double> heapSlots;
+    double* slots = inlineSlots;
+    if (slotCount > INLINE_SLOTS) {
+        heapSlots.resize(slotCount);
+        slots = heapSlots.data();
+    }
+    // Kod parametreleri sayı varsayarak derlendi
+    for (size_t i = 0; i < paramCount; ++i) {
+        const double* number = std::get_if<double>(&arguments[i]);
+        if (number == nullptr) return false;
+        slots[i] = *number;
+    }
+
+    double value = 0.0;
+    switch (reinterpret_cast<Entry>(memory)(slots, &value)) {
+        case RETURNED_VALUE:
+            if (returnType == ReturnType::Bool) {
+                result = value != 0.0;
+            } else {
+                result = value;
+            }
+            return true;
+        case RETURNED_NONE:
+            result = std::monostate{};
+            return true;
+        default:
+            return false; // Kurtarma: çağrı yorumlayıcıda baştan yürütülecek
+    }
+}
+
+std::shared_ptr<const JitCode> JitCompiler::compile(const FunStmt& declaration) {
+#ifdef C_CUBE_JIT_X86_64
+    if (!declaration.bodyParsed) return nullptr;
+
+    JitLowering lowering(declaration);
+    try {
+        lowering.lower();
+    } catch (const Unsupported&) {
+        return nullptr;
+    }
+    std::vector<uint8_t> code = lowering.finish();
+
+    // W^X: kod yazılabilir sayfalara kopyalanır, sonra sayfalar salt okunur ve çalıştırılabilir yapılır
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t mappedSize = (code.size() + pageSize - 1) / pageSize * pageSize;
+    void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return nullptr;
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, mappedSize, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, mappedSize);
+        return nullptr;
+    }
+    return std::make_shared<const JitCode>(memory, mappedSize, code.size(), declaration.params.size(),
+                                           lowering.getSlotCount(), lowering.getReturnType());
+#else
+    (void)declaration;
+    return nullptr;
+#endif
+}
@@ -1,6 +1,7 @@
 #include "list.h"
 #include "error_reporter.h" // RuntimeException için
 #include "utils.h"          // valueToString için
+#include "gc.h"             // Büyüme bildirimi (heap sınırı)
 #include <sstream>
 
 // Constructor
@@ -8,7 +9,18 @@ CCubeList::CCubeList(const std::vector<Value>& initialElements) : elements(initi
 
 // Liste elemanına değer ekler
 void CCubeList::add(Value val) {
-    elements.push_back(val);
+    if (pinCount > 0 && elements.size() == elements.capacity()) {
+        // Tampon büyürse native kodun tuttuğu işaretçiler geçersiz kalır
+        throw RuntimeException(Token(TokenType::IDENTIFIER, "add", std::monostate{}, -1),
+                               "Sabitlenmiş liste büyütülemez (native kod tamponu ödünç almış).");
+    }
+    const size_t oldCapacity = elements.capacity();
+    const size_t payload = Gc::payloadBytes(val);
+    if (heap != nullptr) heap->rememberStore(this, val);
+    elements.push_back(std::move(val));
+    if (heap != nullptr) {
+        heap->chargeGrowth(this, static_cast<std::ptrdiff_t>((elements.capacity() - oldCapacity) * sizeof(Value) + payload));
+    }
 }
 
 // Belirtilen indeksteki elemanı alır
@@ -24,7 +36,11 @@ void CCubeList::set_at(size_t index, Value val) {
     if (index >= elements.size()) {
         throw RuntimeException(Token(TokenType::NUMBER, "", static_cast<double>(index), -1), "Liste dizin sınırları dışında.");
     }
-    elements[index] = val;
+    const std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(Gc::payloadBytes(val)) -
+                                 static_cast<std::ptrdiff_t>(Gc::payloadBytes(elements[index]));
+    if (heap != nullptr) heap->rememberStore(this, val);
+    elements[index] = std::move(val);
+    if (heap != nullptr) heap->chargeGrowth(this, delta);
 }
 
 // Listenin boyutunu döndürür
@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <memory> // std::shared_ptr için
+#include <algorithm> // std::min için
+#include <filesystem> // --emit-cpp: varsayılan modül adı için
 
 // Proje bağımlılıkları
 #include "scanner.h"          // Kaynak kodu taramak için
@@ -12,39 +14,65 @@
 #include "error_reporter.h"   // Hata yönetimi için
 #include "gc.h"               // Çöp toplayıcı için
 #include "module_loader.h"    // Modül yükleme için
-#include "builtin_functions.h" // Yerleşik fonksiyonlar için
+#include "ast_cache.h"        // Çözümlenmiş AST önbelleği (.ccbc) için
+#include "cpp_emitter.h"      // --emit-cpp için C++ kod üreticisi
+#include "incremental_parser.h" // REPL oturumu için artımlı parser
 
 // Global hata raporlayıcı
 ErrorReporter errorReporter;
 
-// Kaynak kodu çalıştıran ana fonksiyon
-void run(const std::string& source) {
-    Scanner scanner(source, errorReporter);
-    std::vector<Token> tokens = scanner.scanTokens();
-
-    if (errorReporter.hadError()) return;
-
-    Parser parser(tokens, errorReporter);
-    std::vector<StmtPtr> statements = parser.parse();
+// Komut satırı seçenekleri
+struct RunOptions {
+    size_t gcStressInterval = 0; // --gc-stress[=N]: her N. ayırmada koleksiyon zorla (0: kapalı)
+    bool gcStressFull = false;   // --gc-stress-full: zorlanan koleksiyonlar tam koleksiyon olsun
+    bool gcVerify = false;       // --gc-verify: her koleksiyondan sonra heap doğrulayıcıyı çalıştır
+    size_t maxHeapMb = 0;        // --max-heap-mb=N: sert heap sınırı (0: sınırsız)
+    size_t softHeapMb = 0;       // --soft-heap-mb=N: yumuşak heap sınırı, aşılınca uyarı basılır
+    bool lazyFunctionBodies = false; // --lazy-parse: fonksiyon gövdeleri ilk çağrıda çözümlenir (--eager-parse varsayılanı geri alır)
+    bool astCache = true;        // --no-ast-cache ile kapanır: çözümlenmiş AST .ccbc dosyalarında saklanmaz
+    ExecMode execMode = ExecMode::Tree; // --exec=tree|flat|closure: AST'nin yürütülme biçimi
+    size_t jitThreshold = 0;     // --jit[=N]: N. çağrıdan sonra fonksiyonları makine koduna derle (0: kapalı)
+    size_t traceThreshold = 0;   // --trace-loops[=N]: N yinelemeden sonra while döngülerinin izini kaydet (0: kapalı)
+    bool emitCpp = false;        // --emit-cpp[=DOSYA]: dosyayı çalıştırmak yerine C++ kaynağına çevir
+    std::string emitCppPath;     // Boşsa üretilen kod standart çıktıya yazılır
+    std::string moduleName;      // --module-name=AD: derlenmiş modülün import adı (varsayılan: dosya adı)
+};
+RunOptions runOptions;
 
-    if (errorReporter.hadError()) return;
+// GC doğrulayıcısı herhangi bir çalıştırmada hata bulduysa true olur
+bool hadGcVerificationError = false;
 
-    // ----- GC Entegrasyonu Başlangıcı -----
-    // Gc nesnesini oluştur
-    // youngGenCapacity ve oldGenCapacity değerlerini projenizin ihtiyacına göre ayarlayın.
-    // İlk denemeler için küçük değerler kullanmak, GC'nin çalıştığını görmenizi kolaylaştırır.
-    // Örneğin, 10MB ve 100MB yerine 1MB ve 10MB gibi.
-    // production code'da bu değerler daha büyük olacaktır.
-    Gc gc(1 * 1024 * 1024, 10 * 1024 * 1024); // Young Gen: 1MB, Old Gen: 10MB
+// ----- GC Entegrasyonu Başlangıcı -----
+// Bir çalıştırmanın GC'si, modül yükleyicisi ve yorumlayıcısı. run() her kaynak için yenisini kurar;
+// REPL oturumu tek bir tanesini tutar, böylece satırlar arasında tanımlar korunur.
+struct Runtime {
+    Gc gc;
+    ModuleLoader moduleLoader;
+    Interpreter interpreter;
 
-    // Modül Yükleyiciyi oluştur
-    ModuleLoader moduleLoader(errorReporter, gc); // ModuleLoader'ın da GC'ye ihtiyacı var
+    Runtime();
+    // İmport'ları yükleyip bildirimleri yürütür; çalışma zamanı hataları raporlanır
+    void execute(const std::vector<StmtPtr>& statements);
+    // Son tam koleksiyon, istatistikler ve doğrulama sonucu
+    void finish();
 
-    // Yorumlayıcıyı oluştur ve Gc referansını ona ilet
-    Interpreter interpreter(errorReporter, gc, moduleLoader);
+private:
+    static Gc& configure(Gc& gc); // GC ayarları, modül yükleyici ve yorumlayıcı ayırmaya başlamadan uygulanır
+};
 
-    // Yerleşik fonksiyonları tanımla (artık Gc'yi kullanarak)
-    BuiltinFunctions::defineBuiltins(interpreter.getGlobalsEnvironment(), gc);
+// Gc nesnesini oluştur
+// youngGenCapacity ve oldGenCapacity değerlerini projenizin ihtiyacına göre ayarlayın.
+// İlk denemeler için küçük değerler kullanmak, GC'nin çalıştığını görmenizi kolaylaştırır.
+// Örneğin, 10MB ve 100MB yerine 1MB ve 10MB gibi.
+// production code'da bu değerler daha büyük olacaktır.
+Runtime::Runtime()
+    : gc(1 * 1024 * 1024, 10 * 1024 * 1024), // Young Gen: 1MB, Old Gen: 10MB
+      moduleLoader(errorReporter, configure(gc)), // ModuleLoader'ın da GC'ye ihtiyacı var
+      interpreter(errorReporter, gc, moduleLoader) { // Yorumlayıcıya Gc referansını ilet
+    interpreter.setExecMode(runOptions.execMode);
+    interpreter.setJitThreshold(static_cast<uint32_t>(std::min<size_t>(runOptions.jitThreshold, UINT32_MAX)));
+    interpreter.setTraceThreshold(static_cast<uint32_t>(std::min<size_t>(runOptions.traceThreshold, UINT32_MAX)));
+    // Yerleşik fonksiyonlar ve modüller (clock, gc, weak) Interpreter kurucusunda tanımlanır
 
     // GC'nin Interpreter'ın ana ortamlarına erişmesini sağlamak için (kök taraması için)
     // Gc sınıfında bu ortamları kaydetmek için bir mekanizma eklemiş olmalıyız.
@@ -52,23 +80,71 @@ void run(const std::string& source) {
     // Alternatif olarak, Gc'nin mark aşamasında Interpreter'a danışması.
     // Şimdilik, Interpreter'ın içindeki globals ve environment'ın otomatik olarak Gc tarafından
     // (örneğin markMap aracılığıyla) taranacağını varsayıyoruz.
+}
+
+Gc& Runtime::configure(Gc& gc) {
+    // Stres modu, toplayıcı değişikliklerini doğrulamak içindir; bu yüzden doğrulayıcıyı da açar.
+    gc.setStressMode(runOptions.gcStressInterval, runOptions.gcStressFull);
+    gc.verifyHeap = runOptions.gcVerify || runOptions.gcStressInterval > 0;
 
+    // Heap sınırları: sert sınır aşılırsa script bir çalışma zamanı hatasıyla durur.
+    gc.setHeapLimits(runOptions.maxHeapMb * 1024 * 1024, runOptions.softHeapMb * 1024 * 1024,
+                     [](Gc&, size_t used) {
+                         std::cerr << "Uyarı: yumuşak heap sınırı aşıldı (" << used << " bayt)." << std::endl;
+                     });
+    return gc;
+}
+
+void Runtime::execute(const std::vector<StmtPtr>& statements) {
     // GC toplama eşiği için bir mekanizma eklenebilir.
     // Örneğin, her N statement'ta bir GC çalıştırma veya bellek tahsis eşiğine göre.
     // Şimdilik Interpreter'ın sonunda bir tam toplama yapalım.
     try {
+        // İmport edilen modüller yürütme başlamadan paralel parse edilir; çalıştırma sırası değişmez
+        moduleLoader.preloadImports(statements);
         interpreter.interpret(statements);
     } catch (const RuntimeException& e) {
         errorReporter.runtimeError(e);
     }
+}
 
+void Runtime::finish() {
     // Program bittiğinde veya çıkış yapmadan önce manuel olarak tam bir GC döngüsü çalıştır.
     // Bu, programın sonunda tüm bellek kaynaklarının temizlendiğinden emin olmanın iyi bir yoludur.
     // Normalde, GC otomatik olarak çalıştığı için bu zorunlu değildir, ancak debug ve tam temizlik için faydalıdır.
     std::cout << "\n--- Program Sonuçları ---" << std::endl;
     gc.collectFull();
     gc.printStats();
-    // ----- GC Entegrasyonu Sonu -----
+    if (gc.verificationFailures > 0) {
+        std::cerr << "GC doğrulaması " << gc.verificationFailures << " hata buldu." << std::endl;
+        hadGcVerificationError = true;
+    }
+}
+// ----- GC Entegrasyonu Sonu -----
+
+// Kaynak kodu çalıştıran ana fonksiyon.
+// cachePath boş değilse AST önce oradan yüklenmeye çalışılır; tutmazsa kaynak parse edilir
+// ve hatasız sonuç aynı yola yazılır.
+void run(const std::string& source, const std::string& cachePath = "") {
+    // AST düğümleri konumları bu tampona göre ofset olarak tutar (bkz. source_location.h).
+    // Tampon (dosya içeriği) çağıranındır; kayıt run() bitince silinir.
+    SourceBufferScope sourceBuffer(source);
+    std::vector<StmtPtr> statements;
+    if (cachePath.empty() || !AstCache::load(cachePath, source, defaultAllocator(), statements)) {
+        // Tarama ve parse iç içe ilerler: parser token'ları scanner'dan isteğe bağlı çeker,
+        // tüm token listesi hiçbir zaman bellekte oluşturulmaz
+        Scanner scanner(source, errorReporter);
+        Parser parser(scanner, errorReporter);
+        parser.setLazyFunctionBodies(runOptions.lazyFunctionBodies);
+        statements = parser.parse();
+
+        if (errorReporter.hadError()) return;
+        if (!cachePath.empty()) AstCache::store(cachePath, source, statements);
+    }
+
+    Runtime runtime;
+    runtime.execute(statements);
+    runtime.finish();
 }
 
 // Dosyadan kodu okuyan fonksiyon
@@ -81,31 +157,177 @@ void runFile(const std::string& path) {
 
     std::stringstream buffer;
     buffer << file.rdbuf();
-    run(buffer.str());
+    // REPL satırları önbelleğe alınmaz; yalnızca dosyadan çalışan scriptler
+    run(buffer.str(), AstCache::isEnabled() ? AstCache::cachePathFor(path) : std::string());
 
     if (errorReporter.hadError()) exit(65);       // Syntax error
     if (errorReporter.hadRuntimeError()) exit(70); // Runtime error
+    if (hadGcVerificationError) exit(71);          // GC doğrulama hatası (--gc-stress / --gc-verify)
+}
+
+// Dosyayı C++ kaynağına çevirir (bkz. cpp_emitter.h). Üretilen kod tüm gövdeleri içermesi gerektiği
+// için kaynak tembel gövdeler ve AST önbelleği olmadan parse edilir.
+void emitCppFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Dosya okunamadı: " << path << std::endl;
+        exit(1);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string source = buffer.str();
+
+    SourceBufferScope sourceBuffer(source);
+    Scanner scanner(source, errorReporter);
+    Parser parser(scanner, errorReporter);
+    parser.setLazyFunctionBodies(false);
+    std::vector<StmtPtr> statements = parser.parse();
+    if (errorReporter.hadError()) exit(65);
+
+    std::string moduleName = runOptions.moduleName;
+    if (moduleName.empty()) moduleName = std::filesystem::path(path).stem().string();
+
+    std::string code;
+    try {
+        code = CppEmitter::emit(statements, moduleName, path);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        exit(65);
+    }
+
+    if (runOptions.emitCppPath.empty()) {
+        std::cout << code;
+        return;
+    }
+    std::ofstream out(runOptions.emitCppPath);
+    out << code;
+    if (!out) {
+        std::cerr << "Dosya yazılamadı: " << runOptions.emitCppPath << std::endl;
+        exit(74);
+    }
 }
 
-// Etkileşimli kabuk (REPL) fonksiyonu
+// Etkileşimli kabuk (REPL) fonksiyonu.
+// Oturum tek bir yorumlayıcı kullanır; girilen satırlar oturum metnine eklenir ve IncrementalParser
+// yalnızca yeni satırı parse eder. Yalnızca yeni bildirimler yürütülür, öncekilerin tanımları kalır.
+// Hatalı satır oturum metnine eklenmez.
 void runPrompt() {
+    Runtime runtime;
+    IncrementalParser parser(errorReporter);
+    std::string session; // Şimdiye kadar kabul edilen satırlar
     std::string line;
     for (;;) {
         std::cout << "> ";
         if (!std::getline(std::cin, line)) break;
-        run(line);
+
+        const size_t known = parser.statements().size();
+        std::string next = session + line + "\n";
+        parser.reparse(next);
+        if (errorReporter.hadError()) {
+            // Parça parse edilemedi ve tam parse hatayı raporladı: önceki hâle dön
+            parser.reparse(session);
+        } else {
+            session = std::move(next);
+            // Tam parse'ta changedStatements() tüm oturumdur; önceden yürütülenler atlanır
+            std::vector<StmtPtr> fresh;
+            if (parser.lastParseWasFull()) {
+                fresh.assign(parser.statements().begin() + std::min(known, parser.statements().size()),
+                             parser.statements().end());
+            } else {
+                fresh = parser.changedStatements();
+            }
+            runtime.execute(fresh);
+        }
         errorReporter.resetErrors(); // REPL'de her satırda hataları sıfırla
     }
 }
 
+static void printUsage() {
+    std::cout << "Kullanım: c-cube [--gc-stress[=N]] [--gc-stress-full] [--gc-verify]"
+                 " [--max-heap-mb=N] [--soft-heap-mb=N] [--lazy-parse|--eager-parse] [--no-ast-cache] [--exec=tree|flat|closure] [--jit[=N]] [--trace-loops[=N]] [dosya]\n"
+                 "       c-cube --emit-cpp[=çıktı.cpp] [--module-name=AD] modül.cube" << std::endl;
+}
+
+// "--gc-stress=N" biçimindeki sayısal seçenek değerini okur
+static size_t parseCountOption(const std::string& arg, const std::string& prefix) {
+    std::string text = arg.substr(prefix.length());
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        std::cerr << "Geçersiz seçenek değeri: " << arg << std::endl;
+        exit(64);
+    }
+    return static_cast<size_t>(std::stoull(text));
+}
+
 int main(int argc, char* argv[]) {
-    if (argc > 2) {
-        std::cout << "Kullanım: c-cube [dosya]" << std::endl;
-        exit(64); // Yanlış argüman sayısı
-    } else if (argc == 2) {
-        runFile(argv[1]); // Dosya verildi
+    std::string scriptPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--gc-stress") {
+            runOptions.gcStressInterval = 1; // Her ayırmada koleksiyon
+        } else if (arg.rfind("--gc-stress=", 0) == 0) {
+            runOptions.gcStressInterval = parseCountOption(arg, "--gc-stress=");
+        } else if (arg == "--gc-stress-full") {
+            runOptions.gcStressFull = true;
+        } else if (arg == "--gc-verify") {
+            runOptions.gcVerify = true;
+        } else if (arg.rfind("--max-heap-mb=", 0) == 0) {
+            runOptions.maxHeapMb = parseCountOption(arg, "--max-heap-mb=");
+        } else if (arg.rfind("--soft-heap-mb=", 0) == 0) {
+            runOptions.softHeapMb = parseCountOption(arg, "--soft-heap-mb=");
+        } else if (arg == "--lazy-parse") {
+            runOptions.lazyFunctionBodies = true;
+        } else if (arg == "--eager-parse") {
+            runOptions.lazyFunctionBodies = false;
+        } else if (arg == "--no-ast-cache") {
+            runOptions.astCache = false;
+        } else if (arg == "--exec=tree") {
+            runOptions.execMode = ExecMode::Tree;
+        } else if (arg == "--exec=flat") {
+            runOptions.execMode = ExecMode::Flat;
+        } else if (arg == "--exec=closure") {
+            runOptions.execMode = ExecMode::Closure;
+        } else if (arg == "--jit") {
+            runOptions.jitThreshold = 1000;
+        } else if (arg.rfind("--jit=", 0) == 0) {
+            runOptions.jitThreshold = parseCountOption(arg, "--jit=");
+        } else if (arg == "--trace-loops") {
+            runOptions.traceThreshold = 50;
+        } else if (arg.rfind("--trace-loops=", 0) == 0) {
+            runOptions.traceThreshold = parseCountOption(arg, "--trace-loops=");
+        } else if (arg == "--emit-cpp") {
+            runOptions.emitCpp = true;
+        } else if (arg.rfind("--emit-cpp=", 0) == 0) {
+            runOptions.emitCpp = true;
+            runOptions.emitCppPath = arg.substr(std::string("--emit-cpp=").length());
+        } else if (arg.rfind("--module-name=", 0) == 0) {
+            runOptions.moduleName = arg.substr(std::string("--module-name=").length());
+        } else if (arg.rfind("--", 0) == 0 || !scriptPath.empty()) {
+            printUsage();
+            exit(64); // Bilinmeyen seçenek veya birden fazla dosya
+        } else {
+            scriptPath = arg;
+        }
+    }
+
+    // Tembel parse açık değilse tüm gövdeler baştan denetlenmelidir: modüller de aynı kuralı
+    // izler ve tembel gövdeli (denetlenmemiş) önbellek dosyaları kabul edilmez
+    AstCache::setEnabled(runOptions.astCache);
+    AstCache::setAcceptLazyBodies(runOptions.lazyFunctionBodies);
+    CubeModuleReader::setLazyFunctionBodies(runOptions.lazyFunctionBodies);
+
+    if (runOptions.emitCpp) {
+        if (scriptPath.empty()) {
+            printUsage();
+            exit(64); // Çevrilecek dosya verilmedi
+        }
+        emitCppFile(scriptPath);
+        return 0;
+    }
+
+    if (!scriptPath.empty()) {
+        runFile(scriptPath); // Dosya verildi
     } else {
-        runPrompt(); // Argüman verilmedi, REPL başlat
+        runPrompt(); // Dosya verilmedi, REPL başlat
     }
 
     return 0;
@@ -1,15 +1,20 @@
 #include "module_loader.h"
-#include "lexer.h"           // C-CUBE lexing
+#include "scanner.h"         // C-CUBE lexing (ana programla aynı tokenizer)
 #include "parser.h"          // C-CUBE parsing
 #include "interpreter.h"     // Interpreter'ın global ortamına erişim için
 #include "error_reporter.h"  // Hata raporlama için
 #include "value.h"           // ValuePtr ve ModulePtr için
 #include "c_cube_module.h"   // C_CUBE_Module sınıfı için
+#include "ast_cache.h"       // Modül AST'lerinin .ccbc önbelleği
+#include "aot_runtime.h"     // C++'a derlenmiş modüller
 
 #include <fstream>           // File I/O
 #include <sstream>           // String stream
 #include <iostream>          // Debugging/Error output
 #include <filesystem>        // C++17 for path manipulation
+#include <algorithm>         // std::max
+#include <future>            // Modüllerin paralel parse edilmesi
+#include <thread>            // std::thread::hardware_concurrency
 
 // Use C++17 filesystem for path manipulation if available
 #ifdef __cpp_lib_filesystem
@@ -31,33 +36,63 @@ static std::string readFileContent(const std::string& filePath) {
 }
 
 // --- CubeModuleReader Implementasyonu ---
+CubeModuleReader::~CubeModuleReader() {
+    for (const std::string& source : retainedSources) sourceMap().removeBuffer(source);
+}
+
+bool CubeModuleReader::parseSource(const std::string& filePath, const std::string& source,
+                                   ErrorReporter& reporter, std::vector<StmtPtr>& ast) {
+    // AST düğümleri konumları bu tampona göre ofset olarak tutar
+    sourceMap().addBuffer(source);
+
+    // Kaynak değişmediyse tarama ve parse atlanır
+    std::string cachePath = AstCache::cachePathFor(filePath);
+    if (AstCache::load(cachePath, source, defaultAllocator(), ast)) return true;
+
+    // Lexing
+    Scanner scanner(source, reporter);
+
+    // Parsing (token'lar scanner'dan akış olarak çekilir)
+    Parser parser(scanner, reporter);
+    parser.setLazyFunctionBodies(lazyFunctionBodies); // --lazy-parse: gövdeler ilk çağrıda çözümlenir
+    ast = parser.parse();
+    if (reporter.hadError()) return false;
+    AstCache::store(cachePath, source, ast);
+    return true;
+}
+
 ModulePtr CubeModuleReader::readModule(const std::string& filePath,
                                        const std::string& moduleName,
                                        Interpreter& interpreter) {
     try {
-        std::string source = readFileContent(filePath);
-
-        // Lexing
-        Lexer lexer(source);
-        std::vector<Token> tokens = lexer.scanTokens();
-        // if (globalErrorReporter.hadLexError()) return nullptr; // Lexer hatalarını kontrol et
-
-        // Parsing
-        Parser parser(tokens);
         std::vector<StmtPtr> ast;
-        try {
-            ast = parser.parse();
-        } catch (const ParseError& e) {
-            // globalErrorReporter.parseError(e.token, e.what());
-            std::cerr << "[Module " << moduleName << " @ " << e.token.line << "] Parse Error: " << e.what() << std::endl;
-            return nullptr;
+        auto ready = preparsed.find(filePath);
+        if (ready != preparsed.end()) {
+            // ModuleLoader::preloadImports tarafından zaten parse edildi
+            ast = std::move(ready->second);
+            preparsed.erase(ready);
+        } else {
+            // Token'lar ve AST kaynak tamponuna referans verir; modül fonksiyonları yaşadıkça
+            // kaynak metin de yaşamalı
+            std::string& source = retainSource();
+            source = readFileContent(filePath);
+
+            ErrorReporter reporter;
+            try {
+                if (!parseSource(filePath, source, reporter, ast)) return nullptr; // Tarama/parse hataları raporlandı
+            } catch (const ParseError& e) {
+                // globalErrorReporter.parseError(e.token, e.what());
+                std::cerr << "[Module " << moduleName << " @ " << e.token.line << "] Parse Error: " << e.what() << std::endl;
+                return nullptr;
+            }
         }
 
         // Modül için yeni bir ortam oluştur (built-in'lere erişebilmeli)
         // Eğer Interpreter'da built-in'leri tutan ayrı bir ortam varsa, onu parent yapın.
         // Aksi takdirde, main Interpreter'ın global ortamını kullanabiliriz.
         // Burada Interpreter'ın global ortamını parent olarak kullanıyoruz.
-        EnvironmentPtr moduleEnv = std::make_shared<Environment>(interpreter.globals);
+        EnvironmentPtr moduleEnv = allocateShared<Environment>(interpreter.globals->getAllocator(),
+                                                               AllocCategory::Environment, interpreter.globals);
 
         // Modül objesini oluştur
         ModulePtr loadedModule = std::make_shared<Module>(std::move(ast), moduleEnv);
@@ -66,6 +101,7 @@ ModulePtr CubeModuleReader::readModule(const std::string& filePath,
         // Bu, C-CUBE modüllerinin `import` edildiğinde otomatik olarak çalıştırıldığı anlamına gelir.
         // Interpreter'ın ortamını geçici olarak modül ortamına ayarla
         EnvironmentPtr originalEnv = interpreter.environment;
+        GcStackRoot callerRoot(interpreter.getGc(), originalEnv.get()); // import eden ortam
         interpreter.environment = moduleEnv;
         try {
             interpreter.interpret(loadedModule->ast); // Modülün kodunu çalıştır
@@ -164,6 +200,17 @@ ModulePtr JuliaModuleReader::readModule(const std::string& filePath,
 
 // --- ModuleLoader Core Implementasyonu ---
 
+// Derlenmiş modül kaydı. Kayıtlar başka çeviri birimlerinin statik ilklendiricilerinden geldiği
+// için tablo ilk kullanımda kurulur.
+static std::unordered_map<std::string, PrecompiledModule>& precompiledModules() {
+    static std::unordered_map<std::string, PrecompiledModule> modules;
+    return modules;
+}
+
+void ModuleLoader::registerPrecompiled(const std::string& modulePath, PrecompiledModule body) {
+    precompiledModules()[modulePath] = body;
+}
+
 // Constructor: Interpreter ve arama yollarını ayarla, okuyucuları kaydet
 ModuleLoader::ModuleLoader(Interpreter& interpreter, const std::vector<std::string>& searchPaths)
     : searchPaths(searchPaths) {
@@ -255,6 +302,103 @@ std::string ModuleLoader::findModuleFile(const std::string& modulePath,
     return ""; // Bulunamadı
 }
 
+// Bir bildirim listesindeki import edilen modül isimlerini toplar. Henüz parse edilmemiş
+// (tembel) fonksiyon gövdelerine bakılmaz.
+static void collectImports(const std::vector<StmtPtr>& statements, std::vector<std::string>& out);
+
+static void collectImports(const StmtPtr& stmt, std::vector<std::string>& out) {
+    if (!stmt) return;
+    if (auto import = std::dynamic_pointer_cast<ImportStmt>(stmt)) {
+        out.push_back(names().spelling(import->moduleName));
+    } else if (auto block = std::dynamic_pointer_cast<BlockStmt>(stmt)) {
+        collectImports(block->statements, out);
+    } else if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(stmt)) {
+        collectImports(ifStmt->thenBranch, out);
+        collectImports(ifStmt->elseBranch, out);
+    } else if (auto whileStmt = std::dynamic_pointer_cast<WhileStmt>(stmt)) {
+        collectImports(whileStmt->body, out);
+    } else if (auto match = std::dynamic_pointer_cast<MatchStmt>(stmt)) {
+        for (const auto& matchCase : match->cases) collectImports(matchCase.body, out);
+    } else if (auto function = std::dynamic_pointer_cast<FunStmt>(stmt)) {
+        if (function->bodyParsed) collectImports(function->body, out);
+    } else if (auto klass = std::dynamic_pointer_cast<ClassStmt>(stmt)) {
+        for (const auto& method : klass->methods) collectImports(method, out);
+    }
+}
+
+static void collectImports(const std::vector<StmtPtr>& statements, std::vector<std::string>& out) {
+    for (const auto& stmt : statements) collectImports(stmt, out);
+}
+
+// Import grafiği genişlikte dolaşılır: bir modülün parse'ı bitince onun import'ları kuyruğa
+// eklenir. Aynı anda en fazla donanım iş parçacığı sayısı kadar parse çalışır. Kaynak tamponları
+// ve sonuçlar yalnızca bu (ana) iş parçacığında CubeModuleReader'a yazılır; işçiler yalnızca
+// kendilerine ayrılan tampona ve iş parçacığı güvenli sourceMap()/names()/ayırıcıya dokunur.
+void ModuleLoader::preloadImports(const std::vector<StmtPtr>& program) {
+    auto cubeReaderIt = readers.find(".cube");
+    if (cubeReaderIt == readers.end()) return;
+    CubeModuleReader* cubeReader = dynamic_cast<CubeModuleReader*>(cubeReaderIt->second.get());
+    if (!cubeReader) return; // .cube için farklı bir okuyucu kaydedilmiş
+
+    std::vector<std::string> allExtensions;
+    for (const auto& pair : readers) {
+        allExtensions.push_back(pair.first);
+    }
+
+    struct ParseResult {
+        std::string filePath;
+        std::vector<StmtPtr> ast;
+        bool ok = false;
+    };
+
+    std::vector<std::string> pendingImports;
+    collectImports(program, pendingImports);
+    std::deque<std::string> waiting;      // Parse edilecek dosya yolları
+    std::deque<std::future<ParseResult>> running;
+    const size_t maxParallel = std::max(1u, std::thread::hardware_concurrency());
+
+    auto enqueue = [&](const std::vector<std::string>& modulePaths) {
+        for (const auto& modulePath : modulePaths) {
+            if (moduleCache.count(modulePath) || precompiledModules().count(modulePath)) continue;
+            std::string filePath = findModuleFile(modulePath, allExtensions);
+            if (filePath.empty() || getFileExtension(filePath) != ".cube") continue; // Hata import anında raporlanır
+            if (!preloadedFiles.insert(filePath).second) continue;
+            waiting.push_back(filePath);
+        }
+    };
+    enqueue(pendingImports);
+
+    while (!waiting.empty() || !running.empty()) {
+        while (!waiting.empty() && running.size() < maxParallel) {
+            std::string filePath = std::move(waiting.front());
+            waiting.pop_front();
+            std::string& source = cubeReader->retainSource();
+            running.push_back(std::async(std::launch::async, [filePath, &source]() {
+                ParseResult result;
+                result.filePath = filePath;
+                try {
+                    source = readFileContent(filePath);
+                    ErrorReporter reporter;
+                    reporter.setSilent(true); // Hatalar import anındaki yeniden parse'ta raporlanır
+                    result.ok = CubeModuleReader::parseSource(filePath, source, reporter, result.ast);
+                } catch (const std::exception&) {
+                    result.ok = false;
+                }
+                return result;
+            }));
+        }
+
+        ParseResult result = running.front().get();
+        running.pop_front();
+        if (!result.ok) continue;
+
+        pendingImports.clear();
+        collectImports(result.ast, pendingImports);
+        enqueue(pendingImports);
+        cubeReader->addPreparsed(result.filePath, std::move(result.ast));
+    }
+}
+
 // Modülü yükle ve çalıştır
 ModulePtr ModuleLoader::loadModule(const std::string& modulePath) {
     // 1. Önbellekte var mı kontrol et
@@ -263,6 +407,18 @@ ModulePtr ModuleLoader::loadModule(const std::string& modulePath) {
         return moduleCache.at(modulePath);
     }
 
+    // Programa derlenmiş modüller dosya aranmadan yüklenir
+    auto precompiled = precompiledModules().find(modulePath);
+    if (precompiled != precompiledModules().end()) {
+        ModulePtr loadedModule = AotRuntime::loadModule(interpreter, modulePath, precompiled->second);
+        if (!loadedModule) {
+            std::cerr << "Error: Precompiled module '" << modulePath << "' failed to load." << std::endl;
+            return nullptr;
+        }
+        moduleCache[modulePath] = loadedModule;
+        return loadedModule;
+    }
+
     std::cout << "Debug: Attempting to load module '" << modulePath << "' from file." << std::endl;
 
     // Olası tüm uzantıları topla
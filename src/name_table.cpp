@@ -0,0 +1,32 @@
+#include "name_table.h"
+
+#include <stdexcept>
+
+NameTable::~NameTable() {
+    for (auto& chunk : chunks) delete[] chunk.load(std::memory_order_relaxed);
+}
+
+Name NameTable::intern(std::string_view text) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+
+    Name id = count.load(std::memory_order_relaxed);
+    uint32_t chunkIndex = id >> CHUNK_BITS;
+    if (chunkIndex >= MAX_CHUNKS) throw std::length_error("İsim tablosu doldu.");
+    std::string* chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new std::string[CHUNK_SIZE];
+        chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    std::string& slot = chunk[id & (CHUNK_SIZE - 1)];
+    slot.assign(text.data(), text.size());
+    ids.emplace(slot, id);
+    count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+NameTable& names() {
+    static NameTable table;
+    return table;
+}
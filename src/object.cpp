@@ -18,13 +18,13 @@ C_CUBE_Object::C_CUBE_Object(C_CUBE_ClassPtr klass) : klass(klass) {
 // Alan değerini alma veya metot bulma
 ValuePtr C_CUBE_Object::get(const Token& name) {
     // Önce alanlarda ara
-    if (fields.count(name.lexeme)) {
-        return fields.at(name.lexeme);
+    if (fields.count(std::string(name.lexeme))) {
+        return fields.at(std::string(name.lexeme));
     }
 
     // Alanlarda yoksa, sınıfın metotlarında ara
     // Bu kısım C_CUBE_Class sınıfına bir getMethod metodu eklenmesini gerektirir.
-     C_CUBE_FunctionPtr method = klass->findMethod(name.lexeme); // C_CUBE_Class'a bu metot eklenecek
+     C_CUBE_FunctionPtr method = klass->findMethod(std::string(name.lexeme)); // C_CUBE_Class'a bu metot eklenecek
 
     
     if (method) {
@@ -36,10 +36,10 @@ ValuePtr C_CUBE_Object::get(const Token& name) {
     
 
     // Ne alan ne de metot bulunamadıysa runtime hatası
-     runtimeError(name, "Undefined property '" + name.lexeme + "'.");
+     runtimeError(name, "Undefined property '" + std::string(name.lexeme) + "'.");
     std::cerr << "[Line " << name.line << "] Runtime Error: Undefined property '" << name.lexeme << "'." << std::endl;
      hadRuntimeError = true;
-     throw std::runtime_error("Undefined property '" + name.lexeme + "'"); // İstisna fırlatma seçeneği
+     throw std::runtime_error("Undefined property '" + std::string(name.lexeme) + "'"); // İstisna fırlatma seçeneği
 
     return nullptr; // Hata durumunda veya bulunamadığında nullptr döndür (veya özel None değeri)
 }
@@ -47,7 +47,7 @@ ValuePtr C_CUBE_Object::get(const Token& name) {
 // Alan değeri atama veya yeni alan ekleme
 void C_CUBE_Object::set(const Token& name, ValuePtr value) {
     // Alan mevcutsa güncellenir, yoksa yeni alan eklenir.
-    fields[name.lexeme] = value;
+    fields[std::string(name.lexeme)] = value;
 }
 
 // Nesnenin string temsili
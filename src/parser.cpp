@@ -1,30 +1,52 @@
 #include "parser.h"
 #include <iostream>   // Debugging için
 #include <stdexcept>  // std::runtime_error için
+#include <array>      // Pratt kural tablosu için
+#include <algorithm>
+#include "scanner.h"  // Tembel gövdeleri yeniden taramak için
 
 // Constructor
-Parser::Parser(const std::vector<Token>& tokens, ErrorReporter& reporter)
-    : tokens(tokens), errorReporter(reporter) {}
+Parser::Parser(TokenSource& source, ErrorReporter& reporter, Allocator& allocator)
+    : source(source), errorReporter(reporter), allocator(allocator),
+      ring(LOOKAHEAD_SLOTS, Token(TokenType::END_OF_FILE, "", std::monostate{}, 0)) {}
+
+Parser::Parser(const std::vector<Token>& tokens, ErrorReporter& reporter, Allocator& allocator)
+    : ownedSource(std::make_unique<VectorTokenSource>(tokens)), source(*ownedSource),
+      errorReporter(reporter), allocator(allocator),
+      ring(LOOKAHEAD_SLOTS, Token(TokenType::END_OF_FILE, "", std::monostate{}, 0)) {}
+
+// Halkaya kaynaktan token çeker. Önceki token'ın yuvası (head - 1) korunur,
+// bu yüzden en fazla LOOKAHEAD_SLOTS - 1 token ileri okunabilir.
+void Parser::fill(size_t count) const {
+    while (buffered < count && buffered < LOOKAHEAD_SLOTS - 1) {
+        ring[(head + buffered) % LOOKAHEAD_SLOTS] = source.nextToken();
+        buffered++;
+    }
+}
 
 // Token akışının sonuna ulaşıldı mı?
 bool Parser::isAtEnd() const {
-    return peek().type == TokenType::EOF_TOKEN;
+    return peek().type == TokenType::END_OF_FILE;
 }
 
 // Sonraki token'ı tüketir ve döndürür
-Token Parser::advance() {
-    if (!isAtEnd()) current++;
+const Token& Parser::advance() {
+    if (!isAtEnd()) {
+        head = (head + 1) % LOOKAHEAD_SLOTS;
+        buffered--;
+    }
     return previous();
 }
 
 // Mevcut token'ı tüketmeden döndürür
-Token Parser::peek() const {
-    return tokens[current];
+const Token& Parser::peek() const {
+    fill(1);
+    return ring[head];
 }
 
 // Tüketilen son token'ı döndürür
-Token Parser::previous() const {
-    return tokens[current - 1];
+const Token& Parser::previous() const {
+    return ring[(head + LOOKAHEAD_SLOTS - 1) % LOOKAHEAD_SLOTS];
 }
 
 // Mevcut token'ın belirtilen türde olup olmadığını kontrol eder
@@ -34,7 +56,7 @@ bool Parser::check(TokenType type) const {
 }
 
 // Mevcut token'ın türü, verilen türlerden biriyle eşleşirse true döndürür ve ilerler
-bool Parser::match(const std::vector<TokenType>& types) {
+bool Parser::match(std::initializer_list<TokenType> types) {
     for (TokenType type : types) {
         if (check(type)) {
             advance();
@@ -45,7 +67,7 @@ bool Parser::match(const std::vector<TokenType>& types) {
 }
 
 // Belirtilen token türünü tüketir, aksi takdirde hata verir
-Token Parser::consume(TokenType type, const std::string& message) {
+const Token& Parser::consume(TokenType type, const std::string& message) {
     if (check(type)) return advance();
     throw error(peek(), message);
 }
@@ -96,6 +118,21 @@ std::vector<StmtPtr> Parser::parse() {
     return statements;
 }
 
+std::vector<StmtPtr> Parser::parse(std::vector<StatementSpan>& spans) {
+    std::vector<StmtPtr> statements;
+    while (!isAtEnd()) {
+        const char* begin = peek().lexeme.data();
+        try {
+            statements.push_back(declaration());
+            const Token& last = previous();
+            spans.push_back(StatementSpan{begin, last.lexeme.data() + last.lexeme.size()});
+        } catch (const ParseError& e) {
+            synchronize();
+        }
+    }
+    return statements;
+}
+
 // En üst seviye bildirimleri işler (var, class, fun veya normal statement)
 StmtPtr Parser::declaration() {
     if (match({TokenType::VAR})) return varDeclaration();
@@ -116,7 +153,7 @@ StmtPtr Parser::varDeclaration() {
     }
 
     consume(TokenType::SEMICOLON, "Değişken bildiriminden sonra ';' bekleniyor.");
-    return std::make_shared<VarStmt>(name, initializer);
+    return node<VarStmt>(intern(name), locate(name), initializer);
 }
 
 // 'class' bildirimi: class ClassName < SuperClass { ... }
@@ -126,7 +163,7 @@ StmtPtr Parser::classDeclaration() {
     ExprPtr superclass = nullptr;
     if (match({TokenType::LESS})) { // Miras alma varsa (<)
         consume(TokenType::IDENTIFIER, "Üst sınıf ismi bekleniyor.");
-        superclass = std::make_shared<VariableExpr>(previous()); // Üst sınıf bir değişken ifadesidir
+        superclass = node<VariableExpr>(intern(previous()), locate(previous())); // Üst sınıf bir değişken ifadesidir
     }
 
     consume(TokenType::LEFT_BRACE, "Sınıf isminden sonra '{' bekleniyor.");
@@ -137,7 +174,7 @@ StmtPtr Parser::classDeclaration() {
     }
 
     consume(TokenType::RIGHT_BRACE, "Sınıf gövdesinden sonra '}' bekleniyor.");
-    return std::make_shared<ClassStmt>(name, superclass, methods);
+    return node<ClassStmt>(intern(name), locate(name), superclass, methods);
 }
 
 // 'fun' (fonksiyon/metot) bildirimi: fun name(params) { ... }
@@ -157,9 +194,82 @@ StmtPtr Parser::funDeclaration(const std::string& kind) {
     consume(TokenType::RIGHT_PAREN, "Parametrelerden sonra ')' bekleniyor.");
 
     consume(TokenType::LEFT_BRACE, kind + " gövdesinden önce '{' bekleniyor.");
+    if (lazyFunctionBodies) return skipFunctionBody(name, std::move(parameters), kind);
     std::vector<StmtPtr> body = std::dynamic_pointer_cast<BlockStmt>(blockStatement())->statements;
 
-    return std::make_shared<FunStmt>(name, parameters, body);
+    return node<FunStmt>(intern(name), locate(name), internAll(parameters), body);
+}
+
+std::vector<Name> Parser::internAll(const std::vector<Token>& tokens) {
+    std::vector<Name> result;
+    result.reserve(tokens.size());
+    for (const Token& token : tokens) result.push_back(intern(token));
+    return result;
+}
+
+// Fonksiyon gövdesini token düzeyinde atlar: yalnızca süslü parantez derinliği izlenir ve
+// gövdenin kaynak aralığı kaydedilir. Aynı geçişte serbest isimler de toplanır: '.' sonrası
+// olmayan ve gövdede var/fun/class ile tanımlanmayan tanımlayıcılar. Kapsamlar izlenmediği
+// için liste bir üst kümedir (iç içe fonksiyon parametreleri de girebilir).
+StmtPtr Parser::skipFunctionBody(const Token& name, std::vector<Token> parameters, const std::string& kind) {
+    const Token& open = previous();
+    const char* bodyBegin = open.lexeme.data() + open.lexeme.size();
+    int bodyLine = open.line;
+
+    std::vector<std::string_view> declared;
+    for (const Token& param : parameters) declared.push_back(param.lexeme);
+    std::vector<std::string_view> referenced;
+
+    int depth = 1;
+    TokenType prevType = TokenType::LEFT_BRACE;
+    while (!isAtEnd()) {
+        const Token& token = advance();
+        if (token.type == TokenType::LEFT_BRACE) {
+            depth++;
+        } else if (token.type == TokenType::RIGHT_BRACE) {
+            if (--depth == 0) break;
+        } else if (token.type == TokenType::IDENTIFIER) {
+            if (prevType == TokenType::VAR || prevType == TokenType::FUN || prevType == TokenType::CLASS) {
+                declared.push_back(token.lexeme);
+            } else if (prevType != TokenType::DOT) {
+                referenced.push_back(token.lexeme);
+            }
+        }
+        prevType = token.type;
+    }
+    if (depth != 0) throw error(peek(), kind + " gövdesinden sonra '}' bekleniyor.");
+    const char* bodyEnd = previous().lexeme.data(); // Kapanan '}'
+
+    std::vector<std::string> freeNames;
+    for (std::string_view ref : referenced) {
+        if (std::find(declared.begin(), declared.end(), ref) != declared.end()) continue;
+        if (std::find(freeNames.begin(), freeNames.end(), ref) != freeNames.end()) continue;
+        freeNames.emplace_back(ref);
+    }
+
+    return node<FunStmt>(intern(name), locate(name), internAll(parameters), std::string_view(bodyBegin, bodyEnd - bodyBegin),
+                         bodyLine, std::move(freeNames));
+}
+
+void Parser::parseLazyBody(FunStmt& function, Allocator& allocator) {
+    if (function.bodyParsed) return;
+
+    // Gövdenin kendi raporlayıcısı: hadError yalnızca bu gövdenin hatalarını gösterir
+    // (REPL'de ya da önceki bir hatadan sonra paylaşılan bayrak zaten set olabilir)
+    ErrorReporter reporter;
+    // Gövde artımlı parse ile yeniden kullanılmışsa satırı kaymış olabilir; güncel satır SourceMap'ten
+    int firstLine = sourceMap().line(sourceMap().locate(function.bodySource.data(), function.bodyLine));
+    Scanner scanner(function.bodySource, reporter, firstLine);
+    Parser parser(scanner, reporter, allocator);
+    parser.setLazyFunctionBodies(true); // İç içe fonksiyonlar da ilk çağrılarına kadar tembel kalır
+    std::vector<StmtPtr> body = parser.parse();
+
+    if (reporter.hadError()) {
+        const std::string& name = names().spelling(function.name);
+        throw RuntimeException(sourceMap().token(function.loc), "'" + name + "' fonksiyonunun gövdesi çözümlenemedi.");
+    }
+    function.body = std::move(body);
+    function.bodyParsed = true;
 }
 
 // Genel bildirim
@@ -185,7 +295,7 @@ StmtPtr Parser::ifStatement() {
         elseBranch = statement(); // 'else' bloğu varsa
     }
 
-    return std::make_shared<IfStmt>(condition, thenBranch, elseBranch);
+    return node<IfStmt>(condition, thenBranch, elseBranch);
 }
 
 // 'while' bildirimi: while (condition) { ... }
@@ -196,7 +306,7 @@ StmtPtr Parser::whileStatement() {
 
     StmtPtr body = statement();
 
-    return std::make_shared<WhileStmt>(condition, body);
+    return node<WhileStmt>(condition, body);
 }
 
 // 'match' bildirimi: match (expression) { case pattern: statement; ... default: statement; }
@@ -209,7 +319,7 @@ StmtPtr Parser::matchStatement() {
     std::vector<MatchCase> cases = parseMatchCases();
 
     consume(TokenType::RIGHT_BRACE, "Match gövdesinden sonra '}' bekleniyor.");
-    return std::make_shared<MatchStmt>(subject, cases);
+    return node<MatchStmt>(subject, cases);
 }
 
 // Match ifadesi için case'leri çözümler
@@ -253,12 +363,12 @@ MatchCase Parser::parseMatchCase() {
 // Daha karmaşık desenler (listeler, objeler) için daha fazla mantık gerekir.
 ExprPtr Parser::parsePattern() {
     if (match({TokenType::NUMBER, TokenType::STRING, TokenType::TRUE, TokenType::FALSE, TokenType::NONE})) {
-        return std::make_shared<LiteralExpr>(previous().literal);
+        return literal(previous());
     }
     if (match({TokenType::IDENTIFIER})) {
         // Bu bir değişken deseni olabilir (örneğin 'case x:'), bu durumda x'i VariableExpr olarak döndürüyoruz.
         // Interpreter'ın 'match' implementasyonu bu tür desenleri özel olarak ele alacaktır.
-        return std::make_shared<VariableExpr>(previous());
+        return node<VariableExpr>(intern(previous()), locate(previous()));
     }
     // TODO: Daha karmaşık desen türlerini (liste desenleri, obje desenleri, if koşullu desenler) burada ekle
     throw error(peek(), "Beklenmeyen desen tipi.");
@@ -275,7 +385,7 @@ StmtPtr Parser::importStatement() {
     }
 
     consume(TokenType::SEMICOLON, "İmport bildiriminden sonra ';' bekleniyor.");
-    return std::make_shared<ImportStmt>(moduleName, alias.lexeme.empty() ? "" : alias.lexeme);
+    return node<ImportStmt>(intern(moduleName), locate(moduleName), std::string(alias.lexeme));
 }
 
 
@@ -289,7 +399,7 @@ StmtPtr Parser::returnStatement() {
     }
 
     consume(TokenType::SEMICOLON, "Return bildiriminden sonra ';' bekleniyor.");
-    return std::make_shared<ReturnStmt>(keyword, value);
+    return node<ReturnStmt>(locate(keyword), value);
 }
 
 // Süslü parantez içindeki kod bloğu { ... }
@@ -299,201 +409,187 @@ StmtPtr Parser::blockStatement() {
         statements.push_back(declaration()); // Blok içinde de bildirimler olabilir
     }
     consume(TokenType::RIGHT_BRACE, "Bloktan sonra '}' bekleniyor.");
-    return std::make_shared<BlockStmt>(statements);
+    return node<BlockStmt>(statements);
 }
 
 // Sadece bir ifade olan bildirim: expression;
 StmtPtr Parser::expressionStatement() {
     ExprPtr expr = expression();
     consume(TokenType::SEMICOLON, "İfade bildiriminden sonra ';' bekleniyor.");
-    return std::make_shared<ExprStmt>(expr);
+    return node<ExprStmt>(expr);
 }
 
 // --- İfade (Expression) Parsing Metodları ---
 
+// Pratt kural tablosu: TokenType değerine göre doğrudan dizinlenir.
+// Boş satırlar (prefix ve infix nullptr) ifade içinde anlamı olmayan token'lardır.
+const Parser::ParseRule& Parser::getRule(TokenType type) {
+    static const auto rules = [] {
+        std::array<ParseRule, static_cast<size_t>(TokenType::END_OF_FILE) + 1> table{};
+        auto rule = [&table](TokenType type, PrefixFn prefix, InfixFn infix, Precedence precedence) {
+            table[static_cast<size_t>(type)] = ParseRule{prefix, infix, precedence};
+        };
+        //   token                       prefix                  infix             öncelik
+        rule(TokenType::LEFT_PAREN,    &Parser::grouping,      &Parser::call,    Precedence::CALL);
+        rule(TokenType::LEFT_BRACKET,  &Parser::listLiteral,   &Parser::index,   Precedence::CALL);
+        rule(TokenType::DOT,           nullptr,                &Parser::dot,     Precedence::CALL);
+        rule(TokenType::MINUS,         &Parser::unary,         &Parser::binary,  Precedence::TERM);
+        rule(TokenType::PLUS,          nullptr,                &Parser::binary,  Precedence::TERM);
+        rule(TokenType::SLASH,         nullptr,                &Parser::binary,  Precedence::FACTOR);
+        rule(TokenType::STAR,          nullptr,                &Parser::binary,  Precedence::FACTOR);
+        rule(TokenType::BANG,          &Parser::unary,         nullptr,          Precedence::NONE);
+        rule(TokenType::BANG_EQUAL,    nullptr,                &Parser::binary,  Precedence::EQUALITY);
+        rule(TokenType::EQUAL_EQUAL,   nullptr,                &Parser::binary,  Precedence::EQUALITY);
+        rule(TokenType::EQUAL,         nullptr,                &Parser::assign,  Precedence::ASSIGNMENT);
+        rule(TokenType::GREATER,       nullptr,                &Parser::binary,  Precedence::COMPARISON);
+        rule(TokenType::GREATER_EQUAL, nullptr,                &Parser::binary,  Precedence::COMPARISON);
+        rule(TokenType::LESS,          nullptr,                &Parser::binary,  Precedence::COMPARISON);
+        rule(TokenType::LESS_EQUAL,    nullptr,                &Parser::binary,  Precedence::COMPARISON);
+        rule(TokenType::AND,           nullptr,                &Parser::logical, Precedence::AND);
+        rule(TokenType::OR,            nullptr,                &Parser::logical, Precedence::OR);
+        rule(TokenType::IDENTIFIER,    &Parser::variable,      nullptr,          Precedence::NONE);
+        rule(TokenType::STRING,        &Parser::literal,       nullptr,          Precedence::NONE);
+        rule(TokenType::NUMBER,        &Parser::literal,       nullptr,          Precedence::NONE);
+        rule(TokenType::FALSE,         &Parser::literal,       nullptr,          Precedence::NONE);
+        rule(TokenType::TRUE,          &Parser::literal,       nullptr,          Precedence::NONE);
+        rule(TokenType::NONE,          &Parser::literal,       nullptr,          Precedence::NONE);
+        rule(TokenType::THIS,          &Parser::thisExpr,      nullptr,          Precedence::NONE);
+        rule(TokenType::SUPER,         &Parser::superExpr,     nullptr,          Precedence::NONE);
+        return table;
+    }();
+    return rules[static_cast<size_t>(type)];
+}
+
 // Ana ifade parsing metodu (en düşük öncelikli operatörden başlar)
 ExprPtr Parser::expression() {
-    return assignment();
+    return parsePrecedence(Precedence::ASSIGNMENT);
 }
 
-// Atama: identifier = expression; veya object.property = expression;
-ExprPtr Parser::assignment() {
-    ExprPtr expr = logicalOr(); // Atama sol tarafı bir L-value olmalı, bu yüzden en azından bir atama öncesi ifade olmalı
-
-    if (match({TokenType::EQUAL})) {
-        Token equals = previous(); // '=' token'ı
-        ExprPtr value = assignment(); // Sağ taraftaki değer (sağdan sola öncelik için recursive çağrı)
-
-        if (std::dynamic_pointer_cast<VariableExpr>(expr)) {
-            // Değişken ataması (örn: x = 10)
-            Token name = std::dynamic_pointer_cast<VariableExpr>(expr)->name;
-            return std::make_shared<AssignExpr>(name, value);
-        } else if (std::dynamic_pointer_cast<GetExpr>(expr)) {
-            // Property ataması (örn: obj.prop = 10)
-            GetExprPtr get = std::dynamic_pointer_cast<GetExpr>(expr);
-            return std::make_shared<SetExpr>(get->object, get->name, value);
-        }
-
-        errorReporter.error(equals, "Geçersiz atama hedefi.");
-        return nullptr; // Hata durumunda null döndür veya ParseError fırlat
+// Bir prefix ifade çözümler, ardından bağlanma gücü en az 'precedence' olan
+// infix operatörleri soldan sağa katlar. Basit bir literal için tek çağrı yeterlidir.
+ExprPtr Parser::parsePrecedence(Precedence precedence) {
+    PrefixFn prefix = getRule(peek().type).prefix;
+    if (prefix == nullptr) {
+        // Eğer hiçbir şey eşleşmezse, beklenmeyen bir token'dır
+        throw error(peek(), "Beklenmeyen ifade.");
     }
+    Token token = advance();
+    ExprPtr expr = (this->*prefix)(token);
 
-    return expr;
-}
-
-// Mantıksal OR: expr or expr
-ExprPtr Parser::logicalOr() {
-    ExprPtr expr = logicalAnd();
-
-    while (match({TokenType::OR})) {
-        Token op = previous();
-        ExprPtr right = logicalAnd();
-        expr = std::make_shared<LogicalExpr>(expr, op, right);
+    while (true) {
+        const ParseRule& rule = getRule(peek().type);
+        if (rule.infix == nullptr || rule.precedence < precedence) break;
+        Token op = advance();
+        expr = (this->*rule.infix)(expr, op);
     }
     return expr;
 }
 
-// Mantıksal AND: expr and expr
-ExprPtr Parser::logicalAnd() {
-    ExprPtr expr = equality();
-
-    while (match({TokenType::AND})) {
-        Token op = previous();
-        ExprPtr right = equality();
-        expr = std::make_shared<LogicalExpr>(expr, op, right);
+// Temel ifadeler: false, true, none, sayı ve string literalleri
+ExprPtr Parser::literal(const Token& token) {
+    switch (token.type) {
+        case TokenType::FALSE: return node<LiteralExpr>(false);
+        case TokenType::TRUE: return node<LiteralExpr>(true);
+        case TokenType::NUMBER: return node<LiteralExpr>(std::get<double>(token.literal));
+        case TokenType::STRING: return node<LiteralExpr>(std::string(token.stringContents())); // Tek kopya burada
+        default: return node<LiteralExpr>(std::monostate{});
     }
-    return expr;
 }
 
-// Eşitlik: expr == expr | expr != expr
-ExprPtr Parser::equality() {
-    ExprPtr expr = comparison();
-
-    while (match({TokenType::BANG_EQUAL, TokenType::EQUAL_EQUAL})) {
-        Token op = previous();
-        ExprPtr right = comparison();
-        expr = std::make_shared<BinaryExpr>(expr, op, right);
-    }
-    return expr;
+ExprPtr Parser::variable(const Token& token) {
+    return node<VariableExpr>(intern(token), locate(token));
 }
 
-// Karşılaştırma: expr > expr | expr >= expr | expr < expr | expr <= expr
-ExprPtr Parser::comparison() {
-    ExprPtr expr = addition();
-
-    while (match({TokenType::GREATER, TokenType::GREATER_EQUAL, TokenType::LESS, TokenType::LESS_EQUAL})) {
-        Token op = previous();
-        ExprPtr right = addition();
-        expr = std::make_shared<BinaryExpr>(expr, op, right);
-    }
-    return expr;
+ExprPtr Parser::thisExpr(const Token& token) {
+    return node<ThisExpr>(locate(token));
 }
 
-// Toplama/Çıkarma: expr + expr | expr - expr
-ExprPtr Parser::addition() {
-    ExprPtr expr = multiplication();
-
-    while (match({TokenType::MINUS, TokenType::PLUS})) {
-        Token op = previous();
-        ExprPtr right = multiplication();
-        expr = std::make_shared<BinaryExpr>(expr, op, right);
-    }
-    return expr;
+// super.method
+ExprPtr Parser::superExpr(const Token& token) {
+    consume(TokenType::DOT, "'super' anahtar kelimesinden sonra '.' bekleniyor.");
+    Token method = consume(TokenType::IDENTIFIER, "Üst sınıf metot ismi bekleniyor.");
+    return node<SuperExpr>(locate(token), intern(method), locate(method));
 }
 
-// Çarpma/Bölme: expr * expr | expr / expr
-ExprPtr Parser::multiplication() {
-    ExprPtr expr = unary();
+// Parantezli ifade: ( expr )
+ExprPtr Parser::grouping(const Token&) {
+    ExprPtr expr = expression();
+    consume(TokenType::RIGHT_PAREN, "İfadeden sonra ')' bekleniyor.");
+    return node<GroupingExpr>(expr);
+}
 
-    while (match({TokenType::SLASH, TokenType::STAR})) {
-        Token op = previous();
-        ExprPtr right = unary();
-        expr = std::make_shared<BinaryExpr>(expr, op, right);
+// List literals: [expr, expr, ...]
+ExprPtr Parser::listLiteral(const Token&) {
+    std::vector<ExprPtr> elements;
+    if (!check(TokenType::RIGHT_BRACKET)) {
+        do {
+            elements.push_back(expression());
+        } while (match({TokenType::COMMA}));
     }
-    return expr;
+    consume(TokenType::RIGHT_BRACKET, "Liste literalinden sonra ']' bekleniyor.");
+    return node<ListLiteralExpr>(elements);
 }
 
 // Tekli operatörler: !expr | -expr
-ExprPtr Parser::unary() {
-    if (match({TokenType::BANG, TokenType::MINUS})) {
-        Token op = previous();
-        ExprPtr right = unary(); // Sağdan sola öncelik için recursive çağrı
-        return std::make_shared<UnaryExpr>(op, right);
-    }
-    return call(); // Tekli operatörden sonra çağrı ifadeleri gelebilir (örn: -obj.method())
+ExprPtr Parser::unary(const Token& op) {
+    ExprPtr right = parsePrecedence(Precedence::UNARY); // Sağdan sola: -!x, --x
+    return node<UnaryExpr>(op.type, locate(op), right);
 }
 
-// Fonksiyon çağrısı, metot çağrısı, dizin erişimi
-ExprPtr Parser::call() {
-    ExprPtr expr = primary(); // Çağrının sol tarafı (birincil ifade veya tanımlayıcı olabilir)
-
-    while (true) {
-        if (match({TokenType::LEFT_PAREN})) { // Fonksiyon çağrısı
-            std::vector<ExprPtr> arguments;
-            if (!check(TokenType::RIGHT_PAREN)) { // Argümanlar boş değilse
-                do {
-                    if (arguments.size() >= 255) {
-                        error(peek(), "Fonksiyon çok fazla argümana sahip olamaz.");
-                    }
-                    arguments.push_back(expression());
-                } while (match({TokenType::COMMA}));
-            }
-            Token paren = consume(TokenType::RIGHT_PAREN, "Argümanlardan sonra ')' bekleniyor.");
-            expr = std::make_shared<CallExpr>(expr, paren, arguments);
-        } else if (match({TokenType::DOT})) { // Property erişimi (örn: object.property)
-            Token name = consume(TokenType::IDENTIFIER, "Property ismi bekleniyor.");
-            expr = std::make_shared<GetExpr>(expr, name);
-        } else if (match({TokenType::LEFT_BRACKET})) { // Dizin erişimi (örn: array[index])
-            ExprPtr index = expression();
-            Token bracket = consume(TokenType::RIGHT_BRACKET, "Dizin erişiminden sonra ']' bekleniyor.");
-            expr = std::make_shared<GetExpr>(expr, index->toString()); // Geçiçi çözüm: IndexExpr tipi oluşturulabilir
-            // TODO: Dizilere doğrudan erişim için ayrı bir IndexExpr yapısı daha uygun olabilir
-             return std::make_shared<IndexExpr>(expr, index);
-        }
-        else {
-            break; // Daha fazla çağrı veya erişim yoksa döngüden çık
-        }
-    }
-    return expr;
+// İkili operatörler sola birleşimlidir: sağ taraf bir üst öncelikte çözümlenir
+ExprPtr Parser::binary(ExprPtr left, const Token& op) {
+    Precedence next = static_cast<Precedence>(static_cast<uint8_t>(getRule(op.type).precedence) + 1);
+    ExprPtr right = parsePrecedence(next);
+    return node<BinaryExpr>(left, op.type, locate(op), right);
 }
 
-// Temel ifadeler (literaller, parantezli ifadeler, tanımlayıcılar, 'this', 'super')
-ExprPtr Parser::primary() {
-    if (match({TokenType::FALSE})) return std::make_shared<LiteralExpr>(false);
-    if (match({TokenType::TRUE})) return std::make_shared<LiteralExpr>(true);
-    if (match({TokenType::NONE})) return std::make_shared<LiteralExpr>(std::monostate{});
-
-    if (match({TokenType::NUMBER})) return std::make_shared<LiteralExpr>(std::get<double>(previous().literal));
-    if (match({TokenType::STRING})) return std::make_shared<LiteralExpr>(std::get<std::string>(previous().literal));
+// Mantıksal and/or: ayrı düğüm, çünkü yorumlayıcı sağ tarafı kısa devre ile değerlendirir
+ExprPtr Parser::logical(ExprPtr left, const Token& op) {
+    Precedence next = static_cast<Precedence>(static_cast<uint8_t>(getRule(op.type).precedence) + 1);
+    ExprPtr right = parsePrecedence(next);
+    return node<LogicalExpr>(left, op.type, locate(op), right);
+}
 
-    if (match({TokenType::SUPER})) {
-        Token keyword = previous();
-        consume(TokenType::DOT, "'super' anahtar kelimesinden sonra '.' bekleniyor.");
-        Token method = consume(TokenType::IDENTIFIER, "Üst sınıf metot ismi bekleniyor.");
-        return std::make_shared<SuperExpr>(keyword, method);
+// Atama: identifier = expression; veya object.property = expression;
+ExprPtr Parser::assign(ExprPtr left, const Token& equals) {
+    ExprPtr value = parsePrecedence(Precedence::ASSIGNMENT); // Sağdan sola: a = b = c
+
+    if (auto variable = std::dynamic_pointer_cast<VariableExpr>(left)) {
+        // Değişken ataması (örn: x = 10)
+        return node<AssignExpr>(variable->name, variable->loc, value);
+    } else if (auto get = std::dynamic_pointer_cast<GetExpr>(left)) {
+        // Property ataması (örn: obj.prop = 10)
+        return node<SetExpr>(get->object, get->name, get->loc, value);
     }
-    if (match({TokenType::THIS})) return std::make_shared<ThisExpr>(previous());
 
-    if (match({TokenType::IDENTIFIER})) return std::make_shared<VariableExpr>(previous());
+    errorReporter.error(equals, "Geçersiz atama hedefi.");
+    return left; // Parse devam edebilsin diye sol tarafı koru
+}
 
-    if (match({TokenType::LEFT_PAREN})) {
-        ExprPtr expr = expression();
-        consume(TokenType::RIGHT_PAREN, "İfadeden sonra ')' bekleniyor.");
-        return std::make_shared<GroupingExpr>(expr);
+// Fonksiyon/metot çağrısı: callee(args)
+ExprPtr Parser::call(ExprPtr callee, const Token&) {
+    std::vector<ExprPtr> arguments;
+    if (!check(TokenType::RIGHT_PAREN)) { // Argümanlar boş değilse
+        do {
+            if (arguments.size() >= 255) {
+                error(peek(), "Fonksiyon çok fazla argümana sahip olamaz.");
+            }
+            arguments.push_back(expression());
+        } while (match({TokenType::COMMA}));
     }
+    Token paren = consume(TokenType::RIGHT_PAREN, "Argümanlardan sonra ')' bekleniyor.");
+    return node<CallExpr>(callee, locate(paren), arguments);
+}
 
-    // List literals: [expr, expr, ...]
-    if (match({TokenType::LEFT_BRACKET})) {
-        std::vector<ExprPtr> elements;
-        if (!check(TokenType::RIGHT_BRACKET)) {
-            do {
-                elements.push_back(expression());
-            } while (match({TokenType::COMMA}));
-        }
-        consume(TokenType::RIGHT_BRACKET, "Liste literalinden sonra ']' bekleniyor.");
-        return std::make_shared<ListLiteralExpr>(elements);
-    }
+// Property erişimi (örn: object.property)
+ExprPtr Parser::dot(ExprPtr object, const Token&) {
+    Token name = consume(TokenType::IDENTIFIER, "Property ismi bekleniyor.");
+    return node<GetExpr>(object, intern(name), locate(name));
+}
 
-    // Eğer hiçbir şey eşleşmezse, beklenmeyen bir token'dır
-    throw error(peek(), "Beklenmeyen ifade.");
+// Dizin erişimi (örn: array[index])
+ExprPtr Parser::index(ExprPtr object, const Token&) {
+    ExprPtr index = expression();
+    Token bracket = consume(TokenType::RIGHT_BRACKET, "Dizin erişiminden sonra ']' bekleniyor.");
+    return node<IndexExpr>(object, locate(bracket), index);
 }
@@ -1,37 +1,92 @@
 #include "scanner.h"
 #include <iostream> // Debug çıktısı için kullanılabilir, normalde kaldırılır
 #include <variant>
+#include <charconv> // std::from_chars için
+#include "simd_scan.h" // Vektörel boşluk/yorum/string/tanımlayıcı taraması
+
+// Tanımlayıcının anahtar kelime olup olmadığını belirler
+TokenType Scanner::keywordType(std::string_view text) {
+    switch (text[0]) {
+        case 'a':
+            if (text == "and") return TokenType::AND;
+            if (text == "as") return TokenType::AS;
+            break;
+        case 'c':
+            if (text == "class") return TokenType::CLASS;
+            if (text == "case") return TokenType::CASE;
+            break;
+        case 'd':
+            if (text == "default") return TokenType::DEFAULT;
+            break;
+        case 'e':
+            if (text == "else") return TokenType::ELSE;
+            break;
+        case 'f':
+            if (text == "fun") return TokenType::FUN;
+            if (text == "for") return TokenType::FOR;
+            if (text == "false") return TokenType::FALSE;
+            break;
+        case 'i':
+            if (text == "if") return TokenType::IF;
+            if (text == "import") return TokenType::IMPORT;
+            break;
+        case 'm':
+            if (text == "match") return TokenType::MATCH;
+            break;
+        case 'n':
+            if (text == "none") return TokenType::NONE;
+            break;
+        case 'o':
+            if (text == "or") return TokenType::OR;
+            break;
+        case 'p':
+            if (text == "print") return TokenType::PRINT;
+            break;
+        case 'r':
+            if (text == "return") return TokenType::RETURN;
+            break;
+        case 's':
+            if (text == "super") return TokenType::SUPER;
+            break;
+        case 't':
+            if (text == "this") return TokenType::THIS;
+            if (text == "true") return TokenType::TRUE;
+            break;
+        case 'v':
+            if (text == "var") return TokenType::VAR;
+            break;
+        case 'w':
+            if (text == "while") return TokenType::WHILE;
+            break;
+    }
+    return TokenType::IDENTIFIER;
+}
 
-// Anahtar kelimelerin statik haritası
-const std::unordered_map<std::string, TokenType> Scanner::keywords = {
-    {"and", TokenType::AND},
-    {"class", TokenType::CLASS},
-    {"else", TokenType::ELSE},
-    {"false", TokenType::FALSE},
-    {"fun", TokenType::FUN},
-    {"for", TokenType::FOR},
-    {"if", TokenType::IF},
-    {"none", TokenType::NONE},
-    {"or", TokenType::OR},
-    {"print", TokenType::PRINT},
-    {"return", TokenType::RETURN},
-    {"super", TokenType::SUPER},
-    {"this", TokenType::THIS},
-    {"true", TokenType::TRUE},
-    {"var", TokenType::VAR},
-    {"while", TokenType::WHILE},
-    {"import", TokenType::IMPORT},
-    {"as", TokenType::AS},
-    {"match", TokenType::MATCH},
-    {"case", TokenType::CASE},
-    {"default", TokenType::DEFAULT}
-};
-
-Scanner::Scanner(const std::string& source, ErrorReporter& reporter)
-    : source(source), errorReporter(reporter) {}
+Scanner::Scanner(std::string_view source, ErrorReporter& reporter, int firstLine)
+    : source(source), errorReporter(reporter), line(firstLine) {}
 
 // Kaynak kodu tarar ve token listesini döndürür.
+bool Scanner::checkEncoding() {
+    if (encodingChecked) return encodingValid;
+    encodingChecked = true;
+
+    size_t invalid = SimdScan::validateUtf8(source.data(), source.size());
+    encodingValid = invalid == source.size();
+    if (!encodingValid) {
+        for (size_t i = 0; i < invalid; ++i) {
+            if (source[i] == '\n') line++;
+        }
+        errorReporter.error(line, "Geçersiz UTF-8 baytı (konum " + std::to_string(invalid) + ").");
+    }
+    return encodingValid;
+}
+
 std::vector<Token> Scanner::scanTokens() {
+    if (!checkEncoding()) {
+        tokens.emplace_back(TokenType::END_OF_FILE, "", std::monostate{}, line);
+        return tokens;
+    }
+
     while (!isAtEnd()) {
         start = current;
         scanToken();
@@ -42,6 +97,23 @@ std::vector<Token> Scanner::scanTokens() {
     return tokens;
 }
 
+// Akış modu: tokens vektörü yalnızca tek token'lık ara bellek olarak kullanılır
+Token Scanner::nextToken() {
+    if (!checkEncoding()) {
+        return Token(TokenType::END_OF_FILE, "", std::monostate{}, line);
+    }
+    while (tokens.empty()) {
+        if (isAtEnd()) {
+            return Token(TokenType::END_OF_FILE, "", std::monostate{}, line);
+        }
+        start = current;
+        scanToken(); // Boşluk ve yorumlar token üretmez; döngü devam eder
+    }
+    Token token = std::move(tokens.back());
+    tokens.clear();
+    return token;
+}
+
 // Tek karakterli token'ları ve basit durumları işler
 void Scanner::scanToken() {
     char c = advance();
@@ -76,20 +148,20 @@ void Scanner::scanToken() {
         case '/':
             if (match('/')) {
                 // Yorum satırı: satır sonuna kadar ilerle
-                while (peek() != '\n' && !isAtEnd()) advance();
+                current = static_cast<int>(SimdScan::findLineEnd(source.data(), current, source.size()));
             } else {
                 addToken(TokenType::SLASH);
             }
             break;
 
-        // Boşluk karakterlerini atla
+        // Boşluk karakterlerini atla (ardışık boşluklar ve satır sonları toplu geçilir)
+        case '\n':
+            line++; // Yeni satır
+            [[fallthrough]];
         case ' ':
         case '\r':
         case '\t':
-            break;
-
-        case '\n':
-            line++; // Yeni satır
+            current = static_cast<int>(SimdScan::skipWhitespace(source.data(), current, source.size(), line));
             break;
 
         case '"': string(); break; // String literal'leri
@@ -113,8 +185,9 @@ void Scanner::addToken(TokenType type) {
 }
 
 // Token'ı tipi ve literal değeriyle ekler
-void Scanner::addToken(TokenType type, std::variant<std::monostate, std::string, double, bool> literal) {
-    std::string text = source.substr(start, current - start);
+void Scanner::addToken(TokenType type, std::variant<std::monostate, double, bool> literal) {
+    // Kopya yok: lexeme kaynak tamponunun ilgili aralığına bakar
+    std::string_view text(source.data() + start, current - start);
     tokens.emplace_back(type, text, literal, line);
 }
 
@@ -168,10 +241,8 @@ bool Scanner::isAlphaNumeric(char c) const {
 
 // String literal'leri işler.
 void Scanner::string() {
-    while (peek() != '"' && !isAtEnd()) {
-        if (peek() == '\n') line++; // String içinde yeni satır olamaz (Lox dilinde)
-        advance();
-    }
+    // Kapanış tırnağına kadar ilerle (string içindeki satır sonları sayılır)
+    current = static_cast<int>(SimdScan::findStringEnd(source.data(), current, source.size(), line));
 
     if (isAtEnd()) {
         errorReporter.error(line, "Tanımlanmamış string.");
@@ -180,9 +251,8 @@ void Scanner::string() {
 
     advance(); // Kapanış tırnak işaretini tüketir.
 
-    // Tırnak işaretleri arasındaki string değerini al
-    std::string value = source.substr(start + 1, current - 2 - start);
-    addToken(TokenType::STRING, value);
+    // Değer kopyalanmaz; parser tırnaklar arasındaki metni lexeme'den alır (Token::stringContents)
+    addToken(TokenType::STRING);
 }
 
 // Sayı literal'leri işler.
@@ -195,23 +265,16 @@ void Scanner::number() {
         while (isDigit(peek())) advance();
     }
 
-    addToken(TokenType::NUMBER, std::stod(source.substr(start, current - start)));
+    // Geçici string oluşturmadan ve yerel ayardan bağımsız olarak çözümle
+    double value = 0.0;
+    std::from_chars(source.data() + start, source.data() + current, value);
+    addToken(TokenType::NUMBER, value);
 }
 
 // Tanımlayıcıları (değişken isimleri, anahtar kelimeler) işler.
 void Scanner::identifier() {
-    while (isAlphaNumeric(peek())) advance();
-
-    // Tanımlayıcının metinsel değerini al
-    std::string text = source.substr(start, current - start);
+    current = static_cast<int>(SimdScan::identifierEnd(source.data(), current, source.size()));
 
     // Anahtar kelime mi yoksa özel bir tanımlayıcı mı kontrol et
-    TokenType type;
-    auto it = keywords.find(text);
-    if (it != keywords.end()) {
-        type = it->second; // Anahtar kelime
-    } else {
-        type = TokenType::IDENTIFIER; // Normal tanımlayıcı
-    }
-    addToken(type);
+    addToken(keywordType(std::string_view(source.data() + start, current - start)));
 }
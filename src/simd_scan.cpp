@@ -0,0 +1,238 @@
+#include "simd_scan.h"
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define C_CUBE_SCAN_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define C_CUBE_SCAN_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace {
+    inline unsigned countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    inline int popCount(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return static_cast<int>(__popcnt(mask));
+#else
+        return __builtin_popcount(mask);
+#endif
+    }
+
+    // Maskede idx'ten önceki bitler
+    inline uint32_t bitsBelow(unsigned idx) {
+        return idx >= 32 ? 0xFFFFFFFFu : (1u << idx) - 1;
+    }
+
+    inline bool isWhitespace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+    inline bool isIdentifierChar(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+#ifdef C_CUBE_SCAN_SSE2
+    inline uint32_t eqMask16(__m128i chunk, char c) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(c))));
+    }
+    inline uint32_t whitespaceMask16(__m128i chunk) {
+        return eqMask16(chunk, ' ') | eqMask16(chunk, '\t') | eqMask16(chunk, '\r') | eqMask16(chunk, '\n');
+    }
+    // Aralık testi: SSE2'de yalnızca işaretli karşılaştırma var; 0x80 üstü baytlar negatif
+    // olduğundan hiçbir ASCII aralığına düşmez
+    inline __m128i inRange16(__m128i chunk, char lo, char hi) {
+        return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                             _mm_cmplt_epi8(chunk, _mm_set1_epi8(static_cast<char>(hi + 1))));
+    }
+    inline uint32_t identifierMask16(__m128i chunk) {
+        __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20)); // 'A'-'Z' -> 'a'-'z'
+        __m128i ident = _mm_or_si128(inRange16(lower, 'a', 'z'), inRange16(chunk, '0', '9'));
+        ident = _mm_or_si128(ident, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+        return static_cast<uint32_t>(_mm_movemask_epi8(ident));
+    }
+#endif
+
+#ifdef C_CUBE_SCAN_AVX2
+    inline uint32_t eqMask32(__m256i chunk, char c) {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c))));
+    }
+    inline uint32_t whitespaceMask32(__m256i chunk) {
+        return eqMask32(chunk, ' ') | eqMask32(chunk, '\t') | eqMask32(chunk, '\r') | eqMask32(chunk, '\n');
+    }
+    inline __m256i inRange32(__m256i chunk, char lo, char hi) {
+        return _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                                _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), chunk));
+    }
+    inline uint32_t identifierMask32(__m256i chunk) {
+        __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        __m256i ident = _mm256_or_si256(inRange32(lower, 'a', 'z'), inRange32(chunk, '0', '9'));
+        ident = _mm256_or_si256(ident, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(ident));
+    }
+#endif
+}
+
+size_t SimdScan::skipWhitespace(const char* data, size_t pos, size_t end, int& line) {
+#ifdef C_CUBE_SCAN_AVX2
+    for (; pos + 32 <= end; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        uint32_t stop = ~whitespaceMask32(chunk);
+        uint32_t newlines = eqMask32(chunk, '\n');
+        if (stop != 0) {
+            unsigned idx = countTrailingZeros(stop);
+            line += popCount(newlines & bitsBelow(idx));
+            return pos + idx;
+        }
+        line += popCount(newlines);
+    }
+#endif
+#ifdef C_CUBE_SCAN_SSE2
+    for (; pos + 16 <= end; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        uint32_t stop = ~whitespaceMask16(chunk) & 0xFFFFu;
+        uint32_t newlines = eqMask16(chunk, '\n');
+        if (stop != 0) {
+            unsigned idx = countTrailingZeros(stop);
+            line += popCount(newlines & bitsBelow(idx));
+            return pos + idx;
+        }
+        line += popCount(newlines);
+    }
+#endif
+    for (; pos < end && isWhitespace(data[pos]); ++pos) {
+        if (data[pos] == '\n') line++;
+    }
+    return pos;
+}
+
+size_t SimdScan::findLineEnd(const char* data, size_t pos, size_t end) {
+#ifdef C_CUBE_SCAN_AVX2
+    for (; pos + 32 <= end; pos += 32) {
+        uint32_t hits = eqMask32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos)), '\n');
+        if (hits != 0) return pos + countTrailingZeros(hits);
+    }
+#endif
+#ifdef C_CUBE_SCAN_SSE2
+    for (; pos + 16 <= end; pos += 16) {
+        uint32_t hits = eqMask16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)), '\n');
+        if (hits != 0) return pos + countTrailingZeros(hits);
+    }
+#endif
+    while (pos < end && data[pos] != '\n') ++pos;
+    return pos;
+}
+
+size_t SimdScan::findStringEnd(const char* data, size_t pos, size_t end, int& line) {
+#ifdef C_CUBE_SCAN_AVX2
+    for (; pos + 32 <= end; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        uint32_t quotes = eqMask32(chunk, '"');
+        uint32_t newlines = eqMask32(chunk, '\n');
+        if (quotes != 0) {
+            unsigned idx = countTrailingZeros(quotes);
+            line += popCount(newlines & bitsBelow(idx));
+            return pos + idx;
+        }
+        line += popCount(newlines);
+    }
+#endif
+#ifdef C_CUBE_SCAN_SSE2
+    for (; pos + 16 <= end; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        uint32_t quotes = eqMask16(chunk, '"');
+        uint32_t newlines = eqMask16(chunk, '\n');
+        if (quotes != 0) {
+            unsigned idx = countTrailingZeros(quotes);
+            line += popCount(newlines & bitsBelow(idx));
+            return pos + idx;
+        }
+        line += popCount(newlines);
+    }
+#endif
+    for (; pos < end && data[pos] != '"'; ++pos) {
+        if (data[pos] == '\n') line++;
+    }
+    return pos;
+}
+
+size_t SimdScan::identifierEnd(const char* data, size_t pos, size_t end) {
+#ifdef C_CUBE_SCAN_AVX2
+    for (; pos + 32 <= end; pos += 32) {
+        uint32_t stop = ~identifierMask32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos)));
+        if (stop != 0) return pos + countTrailingZeros(stop);
+    }
+#endif
+#ifdef C_CUBE_SCAN_SSE2
+    for (; pos + 16 <= end; pos += 16) {
+        uint32_t stop = ~identifierMask16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos))) & 0xFFFFu;
+        if (stop != 0) return pos + countTrailingZeros(stop);
+    }
+#endif
+    while (pos < end && isIdentifierChar(data[pos])) ++pos;
+    return pos;
+}
+
+size_t SimdScan::validateUtf8(const char* data, size_t size) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t pos = 0;
+    while (pos < size) {
+        // ASCII bloklarını toplu geç (en yüksek bit hiçbir baytta set değil)
+#ifdef C_CUBE_SCAN_AVX2
+        while (pos + 32 <= size &&
+               _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos))) == 0) {
+            pos += 32;
+        }
+#endif
+#ifdef C_CUBE_SCAN_SSE2
+        while (pos + 16 <= size &&
+               _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos))) == 0) {
+            pos += 16;
+        }
+#endif
+        if (pos >= size) break;
+
+        unsigned char lead = bytes[pos];
+        if (lead < 0x80) {
+            pos++;
+            continue;
+        }
+
+        size_t length;
+        uint32_t codePoint;
+        uint32_t minimum;
+        if ((lead & 0xE0) == 0xC0) {
+            length = 2; codePoint = lead & 0x1F; minimum = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3; codePoint = lead & 0x0F; minimum = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 4; codePoint = lead & 0x07; minimum = 0x10000;
+        } else {
+            return pos; // Geçersiz başlangıç baytı (devam baytı ya da 0xF8 üstü)
+        }
+        if (pos + length > size) return pos; // Kesik dizi
+
+        for (size_t i = 1; i < length; ++i) {
+            unsigned char next = bytes[pos + i];
+            if ((next & 0xC0) != 0x80) return pos;
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+        if (codePoint < minimum || codePoint > 0x10FFFF ||
+            (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return pos; // Aşırı uzun kodlama, vekil ya da aralık dışı
+        }
+        pos += length;
+    }
+    return size;
+}
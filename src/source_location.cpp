@@ -0,0 +1,99 @@
+#include "source_location.h"
+
+#include <algorithm>
+#include <mutex>
+
+int LineTable::lineOf(uint32_t offset) const {
+    if (lineStarts.empty()) {
+        lineStarts.push_back(0);
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\n') lineStarts.push_back(static_cast<uint32_t>(i + 1));
+        }
+    }
+    auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset);
+    return static_cast<int>(it - lineStarts.begin());
+}
+
+void SourceMap::addBuffer(std::string_view text, int firstLine) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    // Ofset uzayı dolduysa tampon kaydedilmez; konumları satır kodlamasına düşer
+    if (text.size() >= SourceLoc::LINE_FLAG - 1 - nextBase) return;
+    buffers.push_back(Buffer{text, nextBase, LineTable(text), firstLine, {}});
+    nextBase += static_cast<uint32_t>(text.size()) + 1; // +1: tampon sonu (EOF) konumu da ayrı kalsın
+}
+
+void SourceMap::removeBuffer(std::string_view text) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (auto it = buffers.rbegin(); it != buffers.rend(); ++it) {
+        if (it->text.data() == text.data() && it->text.size() == text.size()) {
+            buffers.erase(std::next(it).base()); // Sıra korunur; nextBase geri alınmaz
+            return;
+        }
+    }
+}
+
+bool SourceMap::baseOf(std::string_view text, uint32_t& base) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (auto it = buffers.rbegin(); it != buffers.rend(); ++it) {
+        if (it->text.data() == text.data() && it->text.size() == text.size()) {
+            base = it->base;
+            return true;
+        }
+    }
+    return false;
+}
+
+SourceLoc SourceMap::locate(const Token& token) const {
+    return locate(token.lexeme.data(), token.line);
+}
+
+SourceLoc SourceMap::locate(const char* p, int line) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    // Son eklenen tampon önce: güncel parse hemen her zaman onu kullanır
+    for (auto it = buffers.rbegin(); p != nullptr && it != buffers.rend(); ++it) {
+        const char* begin = it->text.data();
+        if (p >= begin && p <= begin + it->text.size()) {
+            return SourceLoc::fromOffset(it->base + static_cast<uint32_t>(p - begin));
+        }
+    }
+    return SourceLoc::fromLine(line);
+}
+
+int SourceMap::line(SourceLoc loc) const {
+    if (!loc.isValid()) return -1;
+    if (loc.isLine()) return loc.line();
+    uint32_t offset = loc.offset();
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = std::upper_bound(buffers.begin(), buffers.end(), offset,
+                               [](uint32_t value, const Buffer& buffer) { return value < buffer.base; });
+    if (it == buffers.begin()) return -1;
+    --it;
+    uint32_t local = offset - it->base;
+    if (local > it->text.size()) return -1; // Kaydı silinmiş bir tampondan kalan konum
+    int result = it->firstLine - 1 + it->lines.lineOf(local);
+    for (const auto& shift : it->lineShifts) {
+        if (local >= shift.first) result += shift.second;
+    }
+    return result;
+}
+
+void SourceMap::shiftLines(SourceLoc from, int delta) {
+    if (!from.isValid() || from.isLine() || delta == 0) return;
+    uint32_t offset = from.offset();
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = std::upper_bound(buffers.begin(), buffers.end(), offset,
+                               [](uint32_t value, const Buffer& buffer) { return value < buffer.base; });
+    if (it == buffers.begin()) return;
+    --it;
+    if (offset - it->base > it->text.size()) return;
+    it->lineShifts.emplace_back(offset - it->base, delta);
+}
+
+Token SourceMap::token(SourceLoc loc, std::string_view lexeme, TokenType type) const {
+    return Token(type, lexeme, std::monostate{}, line(loc));
+}
+
+SourceMap& sourceMap() {
+    static SourceMap map;
+    return map;
+}
@@ -0,0 +1,513 @@
+#include "trace_jit.h"
+
+#include <cstring>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "list.h"       // CCubeList
+#include "name_table.h" // names()
+
+namespace {
+
+using Reg = LoopTrace::Reg;
+using Type = LoopTrace::Type;
+using Op = LoopTrace::Op;
+using Instr = LoopTrace::Instr;
+using Location = LoopTrace::Location;
+
+// Yorumlayıcının isTruthy kuralı; bool'lar 0.0/1.0 tutulduğu için ikisine de uyar (NaN doğrudur)
+inline bool truthy(double value) { return value != 0.0; }
+
+// Yan etkisiz işlemlerin değeri. Kayıtta somut değerleri ve sabit katlamayı, iz yürütücüsünde
+// yazmaçları hesaplar; iki taraf aynı kuralı paylaşır.
+inline double pureOp(Op op, double a, double b) {
+    switch (op) {
+        case Op::ADD: return a + b;
+        case Op::SUB: return a - b;
+        case Op::MUL: return a * b;
+        case Op::DIV: return a / b;
+        case Op::NEGATE: return -a;
+        case Op::NOT: return truthy(a) ? 0.0 : 1.0;
+        case Op::LESS: return a < b ? 1.0 : 0.0;
+        case Op::LESS_EQUAL: return a <= b ? 1.0 : 0.0;
+        case Op::GREATER: return a > b ? 1.0 : 0.0;
+        case Op::GREATER_EQUAL: return a >= b ? 1.0 : 0.0;
+        case Op::EQUAL: return a == b ? 1.0 : 0.0;
+        case Op::NOT_EQUAL: return a != b ? 1.0 : 0.0;
+        default: return 0.0;
+    }
+}
+
+// Liste dizinini Interpreter::indexValue ile aynı kurallarla denetler
+inline bool validPosition(double position, size_t size) {
+    return !(position < 0 || position != static_cast<double>(static_cast<size_t>(position)) ||
+             static_cast<size_t>(position) >= size);
+}
+
+inline const Value* elementOfType(const std::vector<Value>& elements, double position, Type type) {
+    if (!validPosition(position, elements.size())) return nullptr;
+    const Value& element = elements[static_cast<size_t>(position)];
+    bool matches = type == Type::Number ? std::holds_alternative<double>(element)
+                                        : std::holds_alternative<bool>(element);
+    return matches ? &element : nullptr;
+}
+
+inline double unbox(const Value& value) {
+    if (const double* number = std::get_if<double>(&value)) return *number;
+    return std::get<bool>(value) ? 1.0 : 0.0;
+}
+
+enum class Step { Continue, LoopDone, SideExit };
+
+Step execute(const std::vector<Instr>& code, double* r, const std::vector<const CCubeList*>& lists) {
+    for (const Instr& instr : code) {
+        switch (instr.op) {
+            case Op::DIV:
+                if (r[instr.b] == 0.0) return Step::SideExit; // Hata mesajını yorumlayıcı üretsin
+                r[instr.dst] = r[instr.a] / r[instr.b];
+                break;
+            case Op::LOAD_ELEMENT: {
+                const Value* element = elementOfType(lists[instr.b]->getElements(), r[instr.a], instr.type);
+                if (element == nullptr) return Step::SideExit;
+                r[instr.dst] = unbox(*element);
+                break;
+            }
+            case Op::GUARD_TRUE:
+                if (!truthy(r[instr.a])) return Step::SideExit;
+                break;
+            case Op::GUARD_FALSE:
+                if (truthy(r[instr.a])) return Step::SideExit;
+                break;
+            case Op::EXIT_IF_FALSE:
+                if (!truthy(r[instr.a])) return Step::LoopDone;
+                break;
+            case Op::MOVE:
+                r[instr.dst] = r[instr.a];
+                break;
+            default:
+                r[instr.dst] = pureOp(instr.op, r[instr.a], r[instr.b]);
+                break;
+        }
+    }
+    return Step::Continue;
+}
+
+bool hasResult(Op op) {
+    return op != Op::GUARD_TRUE && op != Op::GUARD_FALSE && op != Op::EXIT_IF_FALSE;
+}
+bool isUnary(Op op) {
+    return op == Op::NEGATE || op == Op::NOT || op == Op::LOAD_ELEMENT || op == Op::GUARD_TRUE ||
+           op == Op::GUARD_FALSE || op == Op::EXIT_IF_FALSE || op == Op::MOVE;
+}
+// Sonucu kullanılmasa da silinemeyen işlemler (yan çıkış yapabilir ya da döngü durumunu günceller)
+bool isEffectful(Op op) {
+    return op == Op::DIV || op == Op::LOAD_ELEMENT || !hasResult(op) || op == Op::MOVE;
+}
+
+// Değişkenin iz girişinde bulunduğu değer; bulunamazsa ya da arada aynı isimde bir değişken varsa nullptr
+const Value* locate(const std::string& name, Location location, Environment& environment, Environment& globals) {
+    if (location == Location::Local) {
+        auto found = environment.getValues().find(name);
+        return found == environment.getValues().end() ? nullptr : &found->second;
+    }
+    if (&environment != &globals) {
+        if (environment.contains(name)) return nullptr;
+        for (auto env = environment.getEnclosing(); env != nullptr && env.get() != &globals; env = env->getEnclosing()) {
+            if (env->contains(name)) return nullptr;
+        }
+    }
+    auto found = globals.getValues().find(name);
+    return found == globals.getValues().end() ? nullptr : &found->second;
+}
+
+// Kayıt, desteklenmeyen bir düğüme ya da yorumlayıcının hata vereceği bir duruma rastladı
+struct Untraceable {};
+
+// Kayıttaki bir ifadenin değeri: yazmacı ve statik türü
+struct Ref {
+    Reg reg;
+    Type type;
+};
+
+// Döngünün bir yinelemesini yorumlayıcının kurallarıyla, ama ortama dokunmadan yürütür ve izini
+// LoopTrace'e yazar. Her yazmacın kayıttaki somut değeri `values`ta tutulur; dallanmalar bu değerlere
+// göre seçilir.
+class TraceRecording : public ExprVisitor<Ref>, public StmtVisitor<void> {
+public:
+    TraceRecording(LoopTrace& trace, Environment& environment, Environment& globals)
+        : trace(trace), environment(environment), globals(globals) {}
+
+    void record(const WhileStmt& loop) {
+        Ref condition = expr(loop.condition);
+        if (!truthy(values[condition.reg])) throw Untraceable{}; // Döngü bu yinelemede bitiyor
+        if (!constant[condition.reg]) emit({Op::EXIT_IF_FALSE, Type::Bool, 0, condition.reg, 0});
+        stmt(loop.body);
+        closeLoop();
+        trace.recordedAtGlobalScope = &environment == &globals;
+    }
+
+    // --- İfadeler ---
+    Ref visitAssignExpr(std::shared_ptr<AssignExpr> node) override {
+        Ref value = expr(node->value);
+        assign(node->name, value);
+        return value;
+    }
+    Ref visitBinaryExpr(std::shared_ptr<BinaryExpr> node) override {
+        Ref left = expr(node->left);
+        Ref right = expr(node->right);
+        switch (node->op) {
+            case TokenType::PLUS: return numeric(Op::ADD, left, right, Type::Number); // String birleştirme izlenmez
+            case TokenType::MINUS: return numeric(Op::SUB, left, right, Type::Number);
+            case TokenType::STAR: return numeric(Op::MUL, left, right, Type::Number);
+            case TokenType::SLASH:
+                if (values[right.reg] == 0.0) throw Untraceable{}; // Yorumlayıcı sıfıra bölme hatası verecek
+                return numeric(Op::DIV, left, right, Type::Number);
+            case TokenType::LESS: return numeric(Op::LESS, left, right, Type::Bool);
+            case TokenType::LESS_EQUAL: return numeric(Op::LESS_EQUAL, left, right, Type::Bool);
+            case TokenType::GREATER: return numeric(Op::GREATER, left, right, Type::Bool);
+            case TokenType::GREATER_EQUAL: return numeric(Op::GREATER_EQUAL, left, right, Type::Bool);
+            case TokenType::EQUAL_EQUAL:
+                // Farklı türler hiçbir zaman eşit değildir (bkz. Interpreter::isEqual)
+                if (left.type != right.type) return constantRef(0.0, Type::Bool);
+                return operation(Op::EQUAL, left, right, Type::Bool);
+            case TokenType::BANG_EQUAL:
+                if (left.type != right.type) return constantRef(1.0, Type::Bool);
+                return operation(Op::NOT_EQUAL, left, right, Type::Bool);
+            default: throw Untraceable{};
+        }
+    }
+    Ref visitCallExpr(std::shared_ptr<CallExpr>) override { throw Untraceable{}; }
+    Ref visitGetExpr(std::shared_ptr<GetExpr>) override { throw Untraceable{}; }
+    Ref visitGroupingExpr(std::shared_ptr<GroupingExpr> node) override { return expr(node->expression); }
+    Ref visitIndexExpr(std::shared_ptr<IndexExpr> node) override {
+        auto variable = std::dynamic_pointer_cast<VariableExpr>(node->object);
+        if (variable == nullptr) throw Untraceable{};
+        Reg list = listInput(variable->name);
+        Ref index = expr(node->index);
+        if (index.type != Type::Number) throw Untraceable{};
+        const Value* element = nullptr;
+        for (Type type : {Type::Number, Type::Bool}) {
+            element = elementOfType(listObjects[list]->getElements(), values[index.reg], type);
+            if (element == nullptr) continue;
+            Ref result{newRegister(unbox(*element)), type};
+            emit({Op::LOAD_ELEMENT, type, result.reg, index.reg, list});
+            return result;
+        }
+        throw Untraceable{}; // Dizin geçersiz ya da eleman sayı/bool değil
+    }
+    Ref visitLiteralExpr(std::shared_ptr<LiteralExpr> node) override {
+        if (const double* number = std::get_if<double>(&node->value)) return constantRef(*number, Type::Number);
+        if (const bool* flag = std::get_if<bool>(&node->value)) return constantRef(*flag ? 1.0 : 0.0, Type::Bool);
+        throw Untraceable{};
+    }
+    Ref visitLogicalExpr(std::shared_ptr<LogicalExpr> node) override {
+        // and/or işlenenin kendisini döndürür: izde alınan yön muhafızla sabitlenir
+        Ref left = expr(node->left);
+        bool leftTruthy = truthy(values[left.reg]);
+        guard(left, leftTruthy);
+        bool shortCircuit = node->op == TokenType::OR ? leftTruthy : !leftTruthy;
+        return shortCircuit ? left : expr(node->right);
+    }
+    Ref visitSetExpr(std::shared_ptr<SetExpr>) override { throw Untraceable{}; }
+    Ref visitSuperExpr(std::shared_ptr<SuperExpr>) override { throw Untraceable{}; }
+    Ref visitThisExpr(std::shared_ptr<ThisExpr>) override { throw Untraceable{}; }
+    Ref visitUnaryExpr(std::shared_ptr<UnaryExpr> node) override {
+        Ref right = expr(node->right);
+        switch (node->op) {
+            case TokenType::MINUS:
+                if (right.type != Type::Number) throw Untraceable{};
+                return operation(Op::NEGATE, right, right, Type::Number);
+            case TokenType::BANG:
+                return operation(Op::NOT, right, right, Type::Bool);
+            default: throw Untraceable{};
+        }
+    }
+    Ref visitVariableExpr(std::shared_ptr<VariableExpr> node) override { return read(node->name); }
+    Ref visitListLiteralExpr(std::shared_ptr<ListLiteralExpr>) override { throw Untraceable{}; }
+
+    // --- Bildirimler ---
+    void visitBlockStmt(std::shared_ptr<BlockStmt> node) override {
+        scopes.emplace_back();
+        for (const auto& statement : node->statements) stmt(statement);
+        scopes.pop_back();
+    }
+    void visitClassStmt(std::shared_ptr<ClassStmt>) override { throw Untraceable{}; }
+    void visitExprStmt(std::shared_ptr<ExprStmt> node) override { expr(node->expression); }
+    void visitFunStmt(std::shared_ptr<FunStmt>) override { throw Untraceable{}; }
+    void visitIfStmt(std::shared_ptr<IfStmt> node) override {
+        Ref condition = expr(node->condition);
+        bool taken = truthy(values[condition.reg]);
+        guard(condition, taken);
+        stmt(taken ? node->thenBranch : node->elseBranch);
+    }
+    void visitImportStmt(std::shared_ptr<ImportStmt>) override { throw Untraceable{}; }
+    void visitReturnStmt(std::shared_ptr<ReturnStmt>) override { throw Untraceable{}; }
+    void visitVarStmt(std::shared_ptr<VarStmt> node) override {
+        // Döngü ortamındaki tanımlar yineleme sonrasında da yaşar; iz yalnızca blok yerellerini tutar
+        if (scopes.empty() || node->initializer == nullptr) throw Untraceable{};
+        Ref value = expr(node->initializer);
+        scopes.back()[node->name] = value;
+    }
+    void visitWhileStmt(std::shared_ptr<WhileStmt>) override { throw Untraceable{}; } // İç döngüler kendi izlerini alır
+    void visitMatchStmt(std::shared_ptr<MatchStmt>) override { throw Untraceable{}; }
+
+    const std::vector<bool>& constantRegisters() const { return constant; }
+
+private:
+    Ref expr(const ExprPtr& node) { return node->accept(static_cast<ExprVisitor<Ref>&>(*this)); }
+    void stmt(const StmtPtr& node) {
+        if (node == nullptr) return;
+        node->accept(static_cast<StmtVisitor<void>&>(*this));
+    }
+
+    void emit(Instr instr) { trace.loop.push_back(instr); }
+
+    Reg newRegister(double value, bool isConstant = false) {
+        if (trace.registers.size() >= std::numeric_limits<Reg>::max()) throw Untraceable{};
+        trace.registers.push_back(isConstant ? value : 0.0);
+        values.push_back(value);
+        constant.push_back(isConstant);
+        return static_cast<Reg>(trace.registers.size() - 1);
+    }
+
+    Ref constantRef(double value, Type type) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        auto found = constants.find(bits);
+        if (found != constants.end()) return Ref{found->second, type};
+        Reg reg = newRegister(value, true);
+        constants.emplace(bits, reg);
+        return Ref{reg, type};
+    }
+
+    // İşlenenleri sabitse kayıtta katlanır; değilse IR'a yazılır
+    Ref operation(Op op, Ref left, Ref right, Type type) {
+        double value = pureOp(op, values[left.reg], values[right.reg]);
+        if (constant[left.reg] && constant[right.reg]) return constantRef(value, type);
+        Ref result{newRegister(value), type};
+        emit({op, type, result.reg, left.reg, right.reg});
+        return result;
+    }
+    Ref numeric(Op op, Ref left, Ref right, Type type) {
+        if (left.type != Type::Number || right.type != Type::Number) throw Untraceable{}; // Tür hatası yorumlayıcıda
+        return operation(op, left, right, type);
+    }
+
+    void guard(Ref condition, bool expected) {
+        if (constant[condition.reg]) return; // Sabit koşul her yinelemede aynı yöne gider
+        emit({expected ? Op::GUARD_TRUE : Op::GUARD_FALSE, Type::Bool, 0, condition.reg, 0});
+    }
+
+    // --- İsim çözümü (Interpreter::lookUpVariable ve Environment::assign ile aynı kurallar) ---
+
+    // Döngü global kapsamda yürüyorsa iki konum aynı ortamdır; aynı değişken iki girişe bölünmesin
+    Location outerLocation(Name name) const {
+        if (&environment == &globals || environment.contains(names().spelling(name))) return Location::Local;
+        return Location::Global;
+    }
+    Location globalLocation() const { return &environment == &globals ? Location::Local : Location::Global; }
+
+    // lookUpVariable yalnızca en içteki ortama, sonra globals'a bakar
+    Ref read(Name name) {
+        if (scopes.empty()) return input(outerLocation(name), name);
+        auto found = scopes.back().find(name);
+        if (found != scopes.back().end()) return found->second;
+        for (const auto& scope : scopes) {
+            if (scope.count(name)) throw Untraceable{}; // Yorumlayıcı burada globals'a bakar; izlenmez
+        }
+        return input(globalLocation(), name);
+    }
+
+    // assign ise ortam zincirinde içten dışa arar
+    void assign(Name name, Ref value) {
+        for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+            auto found = scope->find(name);
+            if (found != scope->end()) {
+                found->second = value;
+                return;
+            }
+        }
+        size_t index = inputIndex(outerLocation(name), name);
+        if (value.type != trace.inputs[index].type) throw Untraceable{}; // Döngü değişkeninin türü değişemez
+        current[index] = value;
+    }
+
+    Ref input(Location location, Name name) {
+        size_t index = inputIndex(location, name);
+        return current[index];
+    }
+
+    size_t inputIndex(Location location, Name name) {
+        auto key = std::make_pair(location, name);
+        auto found = inputIndices.find(key);
+        if (found != inputIndices.end()) return found->second;
+        if (listIndices.count(key)) throw Untraceable{}; // Liste değişkeni izde atanamaz
+
+        const std::string& spelling = names().spelling(name);
+        const Value* value = locate(spelling, location, environment, globals);
+        if (value == nullptr) throw Untraceable{};
+        Type type = Type::Number;
+        if (std::holds_alternative<double>(*value)) {
+            type = Type::Number;
+        } else if (std::holds_alternative<bool>(*value)) {
+            type = Type::Bool;
+        } else {
+            throw Untraceable{};
+        }
+        Reg reg = newRegister(unbox(*value));
+        trace.inputs.push_back({spelling, location, type, reg, false});
+        current.push_back(Ref{reg, type});
+        inputIndices.emplace(key, trace.inputs.size() - 1);
+        return trace.inputs.size() - 1;
+    }
+
+    Reg listInput(Name name) {
+        for (const auto& scope : scopes) {
+            if (scope.count(name)) throw Untraceable{};
+        }
+        Location location = scopes.empty() ? outerLocation(name) : globalLocation();
+        auto key = std::make_pair(location, name);
+        auto found = listIndices.find(key);
+        if (found != listIndices.end()) return found->second;
+        if (inputIndices.count(key)) throw Untraceable{};
+
+        const std::string& spelling = names().spelling(name);
+        const Value* value = locate(spelling, location, environment, globals);
+        if (value == nullptr || !std::holds_alternative<ObjPtr>(*value) ||
+            std::get<ObjPtr>(*value)->getType() != Object::ObjectType::LIST) {
+            throw Untraceable{};
+        }
+        trace.lists.push_back({spelling, location});
+        listObjects.push_back(static_cast<const CCubeList*>(std::get<ObjPtr>(*value).get()));
+        Reg index = static_cast<Reg>(trace.lists.size() - 1);
+        listIndices.emplace(key, index);
+        return index;
+    }
+
+    // Yineleme sonu: değişen döngü değişkenleri giriş yazmaçlarına taşınır. Son değer başka bir girişin
+    // yazmacındaysa önce geçici yazmaca alınır ki taşımalar birbirini ezmesin (a, b = b, a).
+    void closeLoop() {
+        std::vector<std::pair<Reg, Reg>> moves;
+        for (size_t i = 0; i < trace.inputs.size(); ++i) {
+            LoopTrace::Input& input = trace.inputs[i];
+            if (current[i].reg == input.reg) continue;
+            input.written = true;
+            moves.emplace_back(input.reg, current[i].reg);
+        }
+        std::vector<bool> isInputRegister(trace.registers.size(), false);
+        for (const LoopTrace::Input& input : trace.inputs) isInputRegister[input.reg] = true;
+        for (auto& move : moves) {
+            if (!isInputRegister[move.second]) continue;
+            Reg temporary = newRegister(values[move.second]);
+            emit({Op::MOVE, Type::Number, temporary, move.second, 0});
+            move.second = temporary;
+        }
+        for (const auto& move : moves) emit({Op::MOVE, Type::Number, move.first, move.second, 0});
+    }
+
+    LoopTrace& trace;
+    Environment& environment;
+    Environment& globals;
+    std::vector<double> values;   // Kayıttaki somut değerler
+    std::vector<bool> constant;   // Yazmaç sabit mi
+    std::unordered_map<uint64_t, Reg> constants;
+    std::vector<std::unordered_map<Name, Ref>> scopes; // Gövde içindeki blok kapsamları
+    std::map<std::pair<Location, Name>, size_t> inputIndices;
+    std::map<std::pair<Location, Name>, Reg> listIndices;
+    std::vector<Ref> current; // Her girişin yinelemenin o noktasındaki değeri
+    std::vector<const CCubeList*> listObjects; // Kayıttaki liste nesneleri (trace.lists ile aynı sırada)
+};
+
+// Sonucu kullanılmayan yan etkisiz işlemleri siler
+void eliminateDeadCode(LoopTrace& trace) {
+    std::vector<bool> live(trace.registers.size(), false);
+    std::vector<Instr> kept;
+    for (auto instr = trace.loop.rbegin(); instr != trace.loop.rend(); ++instr) {
+        if (!isEffectful(instr->op) && !live[instr->dst]) continue;
+        live[instr->a] = true;
+        if (!isUnary(instr->op)) live[instr->b] = true;
+        kept.push_back(*instr);
+    }
+    trace.loop.assign(kept.rbegin(), kept.rend());
+}
+
+// İşlenenleri döngü boyunca değişmeyen işlemleri ve muhafızları döngü öncesine taşır. Taşınan bir
+// muhafızın ya da bölmenin yan çıkışı da güvenlidir: yan çıkış yalnızca "bu yinelemeyi yorumlayıcı
+// yürütsün" demektir ve iz o ana kadar ortama hiçbir şey yazmamıştır.
+void hoistInvariants(LoopTrace& trace, const std::vector<bool>& constant) {
+    std::vector<bool> invariant = constant;
+    for (const LoopTrace::Input& input : trace.inputs) {
+        if (!input.written) invariant[input.reg] = true;
+    }
+    std::vector<Instr> loop;
+    for (const Instr& instr : trace.loop) {
+        bool hoistable = instr.op != Op::EXIT_IF_FALSE && instr.op != Op::MOVE && invariant[instr.a] &&
+                         (isUnary(instr.op) || invariant[instr.b]);
+        if (hoistable) {
+            trace.preamble.push_back(instr);
+            if (hasResult(instr.op)) invariant[instr.dst] = true;
+        } else {
+            loop.push_back(instr);
+        }
+    }
+    trace.loop = std::move(loop);
+}
+
+} // namespace
+
+LoopTrace::Exit LoopTrace::run(Environment& environment, Environment& globals, uint64_t& iterations) const {
+    iterations = 0;
+    if ((&environment == &globals) != recordedAtGlobalScope) return Exit::NotEntered;
+
+    // Tür muhafızları: iz döngü değişkenlerine yalnızca aynı türde değer yazdığı için girişte bir
+    // kez denetlenmeleri yeterlidir
+    std::vector<double> r = registers;
+    for (const Input& input : inputs) {
+        const Value* value = locate(input.name, input.location, environment, globals);
+        if (value == nullptr) return Exit::NotEntered;
+        bool matches = input.type == Type::Number ? std::holds_alternative<double>(*value)
+                                                  : std::holds_alternative<bool>(*value);
+        if (!matches) return Exit::NotEntered;
+        r[input.reg] = unbox(*value);
+    }
+    std::vector<const CCubeList*> listObjects;
+    listObjects.reserve(lists.size());
+    for (const ListInput& list : lists) {
+        const Value* value = locate(list.name, list.location, environment, globals);
+        if (value == nullptr || !std::holds_alternative<ObjPtr>(*value) ||
+            std::get<ObjPtr>(*value)->getType() != Object::ObjectType::LIST) {
+            return Exit::NotEntered;
+        }
+        listObjects.push_back(static_cast<const CCubeList*>(std::get<ObjPtr>(*value).get()));
+    }
+
+    Step step = execute(preamble, r.data(), listObjects);
+    while (step == Step::Continue) {
+        step = execute(loop, r.data(), listObjects);
+        if (step == Step::Continue) ++iterations;
+    }
+
+    // Giriş yazmaçları son tamamlanan yinelemenin sonundaki değerleri tutar
+    for (const Input& input : inputs) {
+        if (!input.written) continue;
+        Value value = input.type == Type::Number ? Value(r[input.reg]) : Value(r[input.reg] != 0.0);
+        environment.assign(input.name, std::move(value), SourceLoc{});
+    }
+    return step == Step::LoopDone ? Exit::LoopDone : Exit::SideExit;
+}
+
+std::shared_ptr<const LoopTrace> TraceRecorder::record(const WhileStmt& loop, Environment& environment,
+                                                       Environment& globals) {
+    auto trace = std::make_shared<LoopTrace>();
+    TraceRecording recording(*trace, environment, globals);
+    try {
+        recording.record(loop);
+    } catch (const Untraceable&) {
+        return nullptr;
+    }
+    eliminateDeadCode(*trace);
+    hoistInvariants(*trace, recording.constantRegisters());
+    return trace;
+}
@@ -20,7 +20,7 @@ namespace Utils {
 
      // Helper to check if two values are strings
     bool areStrings(ValuePtr a, ValuePtr b) {
-        return a && b && std::holds_alternative<std::string>(*a) && std::holds_alternative<std::string>(*b);
+        return a && b && std::holds_alternative<CubeString>(*a) && std::holds_alternative<CubeString>(*b);
     }
 
     // Converts a ValuePtr to its string representation
@@ -48,7 +48,7 @@ namespace Utils {
                  if (s.back() == '.') s.pop_back();
                  return s;
 
-            } else if constexpr (std::is_same_v<T, std::string>) {
+            } else if constexpr (std::is_same_v<T, CubeString>) {
                 return arg; // String literals don't need quotes in this representation
             }
             // Handle shared pointers to complex types (if they are part of Value variant)
@@ -93,7 +93,7 @@ namespace Utils {
                 return arg; // Boolean value itself
             } else if constexpr (std::is_same_v<T, double>) {
                 return arg != 0; // Numbers are falsy only if 0
-            } else if constexpr (std::is_same_v<T, std::string>) {
+            } else if constexpr (std::is_same_v<T, CubeString>) {
                 return !arg.empty(); // Strings are falsy only if empty
             }
             // Objects, functions, classes, modules, lists, dicts etc. are typically truthy
@@ -176,7 +176,7 @@ namespace Utils {
         if (areNumbers(a, b)) {
             return std::get<double>(*a) > std::get<double>(*b);
         } else if (areStrings(a, b)) {
-            return std::get<std::string>(*a) > std::get<std::string>(*b);
+            return std::get<CubeString>(*a) > std::get<CubeString>(*b);
         }
 
         // Error: Invalid operand types for > operator
@@ -192,7 +192,7 @@ namespace Utils {
          if (areNumbers(a, b)) {
             return std::get<double>(*a) < std::get<double>(*b);
         } else if (areStrings(a, b)) {
-            return std::get<std::string>(*a) < std::get<std::string>(*b);
+            return std::get<CubeString>(*a) < std::get<CubeString>(*b);
         }
 
         // Error: Invalid operand types for < operator
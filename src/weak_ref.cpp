@@ -0,0 +1,54 @@
+#include "weak_ref.h"
+
+// --- CCubeWeakRef ---
+
+CCubeWeakRef::CCubeWeakRef(ObjPtr target) : target(target) {}
+
+std::string CCubeWeakRef::toString() const {
+    ObjPtr obj = target.lock();
+    return obj != nullptr ? "<weakref " + obj->toString() + ">" : "<weakref (dead)>";
+}
+
+size_t CCubeWeakRef::getSize() const {
+    return sizeof(CCubeWeakRef);
+}
+
+// --- CCubeWeakMap ---
+
+std::unordered_map<const Object*, CCubeWeakMap::Entry>::iterator CCubeWeakMap::findLive(const ObjPtr& key) {
+    auto it = entries.find(key.get());
+    if (it != entries.end() && it->second.key.lock() != key) {
+        // Aynı adreste eski (ölmüş) bir anahtarın girdisi kalmış
+        entries.erase(it);
+        return entries.end();
+    }
+    return it;
+}
+
+Value CCubeWeakMap::get(const ObjPtr& key) {
+    auto it = findLive(key);
+    return it != entries.end() ? it->second.value : Value(std::monostate{});
+}
+
+void CCubeWeakMap::set(const ObjPtr& key, Value value) {
+    entries[key.get()] = Entry{key, value};
+}
+
+bool CCubeWeakMap::has(const ObjPtr& key) {
+    return findLive(key) != entries.end();
+}
+
+bool CCubeWeakMap::remove(const ObjPtr& key) {
+    auto it = findLive(key);
+    if (it == entries.end()) return false;
+    entries.erase(it);
+    return true;
+}
+
+std::string CCubeWeakMap::toString() const {
+    return "<weakmap (" + std::to_string(entries.size()) + " entries)>";
+}
+
+size_t CCubeWeakMap::getSize() const {
+    return sizeof(CCubeWeakMap) + entries.size() * (sizeof(Entry) + sizeof(const Object*));
+}
@@ -0,0 +1,14 @@
+# Test betiklerinin ortak çıktı süzgeci (kaynak olarak yüklenir).
+
+# Koleksiyon başlangıç/bitiş satırları, istatistik blokları ve program sonundaki tam koleksiyon
+# yürütme biçimine göre değişir; karşılaştırılan yalnızca programın kendi çıktısıdır.
+filter_gc_output() {
+    awk '
+        /^--- Program Sonuçları ---$/ { exit }
+        /^GC Başladı / || /^GC Bitti\. / { next }
+        /^--- GC İstatistikleri ---$/ { stats = 1; next }
+        stats { if ($0 ~ /^-------------------------$/) stats = 0; next }
+        /^$/ { blank++; next }
+        { while (blank > 0) { print ""; blank-- } print }
+    '
+}
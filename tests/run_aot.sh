@@ -0,0 +1,80 @@
+#!/usr/bin/env bash
+# --emit-cpp testi: tests/aot altındaki her AD.cube modülü C++ kaynağına çevrilir, derlenir ve
+# yorumlayıcının nesne dosyalarıyla bağlanır. AD_test.cube sürücüsü (import AD;) hem .cube
+# dosyasını yükleyen c-cube ile hem de modülü derlenmiş olarak içeren ikili ile çalıştırılır.
+# GC tanılama çıktısı ve modül yükleyicisinin "Debug:" satırları ayıklandıktan sonra standart
+# çıktı, standart hata ve çıkış kodu aynı olmalıdır.
+#
+# Kullanım: tests/run_aot.sh [c-cube] [nesne dizini]
+# Nesne dizini varsayılan olarak build'dir (main.o dahil tüm .o dosyaları bağlanır).
+
+set -u
+
+TESTS_DIR="$(cd "$(dirname "$0")" && pwd)"
+ROOT_DIR="$(dirname "$TESTS_DIR")"
+C_CUBE="$(cd "$(dirname "${1:-./c-cube}")" && pwd)/$(basename "${1:-./c-cube}")"
+OBJ_DIR="${2:-build}"
+CXX="${CXX:-clang++}"
+CXXFLAGS="${CXXFLAGS:--std=c++17 -pthread}"
+
+if [ ! -x "$C_CUBE" ]; then
+    echo "Yorumlayıcı bulunamadı: $C_CUBE (önce 'make' çalıştırın)" >&2
+    exit 2
+fi
+
+set -- "$OBJ_DIR"/*.o
+if [ ! -f "$1" ]; then
+    echo "Nesne dosyaları bulunamadı: $OBJ_DIR (önce 'make' çalıştırın)" >&2
+    exit 2
+fi
+OBJS=("$@")
+
+WORK="$(mktemp -d)"
+trap 'rm -rf "$WORK"' EXIT
+
+# shellcheck source=tests/output_filter.sh
+. "$TESTS_DIR/output_filter.sh"
+
+run_driver() { # c-cube sürücü çıktı-öneki
+    (cd "$TESTS_DIR/aot" && "$1" --no-ast-cache "$2") > "$3.raw" 2> "$3.err"
+    echo $? > "$3.code"
+    filter_gc_output < "$3.raw" | grep -v '^Debug: ' > "$3.out"
+}
+
+failures=0
+for driver in "$TESTS_DIR"/aot/*_test.cube; do
+    name="$(basename "$driver" _test.cube)"
+    module="$TESTS_DIR/aot/$name.cube"
+    dir="$WORK/$name"
+    mkdir -p "$dir"
+    failed=0
+
+    if ! "$C_CUBE" --no-ast-cache --emit-cpp="$dir/$name.cpp" "$module" > "$dir/emit.log" 2>&1 ||
+       ! $CXX $CXXFLAGS -I"$ROOT_DIR/include" -c "$dir/$name.cpp" -o "$dir/$name.o" > "$dir/build.log" 2>&1 ||
+       ! $CXX $CXXFLAGS "${OBJS[@]}" "$dir/$name.o" -o "$dir/c-cube-aot" >> "$dir/build.log" 2>&1; then
+        cat "$dir/emit.log" "$dir/build.log" 2>/dev/null
+        echo "KALDI  $name (derlenemedi)"
+        failures=$((failures + 1))
+        continue
+    fi
+
+    run_driver "$C_CUBE" "$name"_test.cube "$dir/tree"
+    run_driver "$dir/c-cube-aot" "$name"_test.cube "$dir/aot"
+    for part in out err code; do
+        if ! diff -u --label "$name [tree] $part" --label "$name [aot] $part" \
+                "$dir/tree.$part" "$dir/aot.$part"; then
+            failed=1
+        fi
+    done
+    if [ $failed -eq 0 ]; then
+        echo "GEÇTİ  $name (aot)"
+    else
+        echo "KALDI  $name (aot)"
+        failures=$((failures + 1))
+    fi
+done
+
+if [ $failures -ne 0 ]; then
+    echo "$failures modülün derlenmiş hâli ağaç yürütücüsünden farklı sonuç verdi." >&2
+    exit 1
+fi
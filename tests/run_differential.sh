@@ -0,0 +1,81 @@
+#!/usr/bin/env bash
+# Yürütme biçimlerinin karşılaştırmalı testi: her .cube programı --exec=tree, --exec=closure,
+# --exec=flat, ağaç yürütücüsünde --jit=1 (her fonksiyon ilk çağrıda derlenir) ve --trace-loops=1
+# (her while döngüsünün izi ilk yinelemeden sonra kaydedilir) ile çalıştırılır.
+# GC tanılama çıktısı ayıklandıktan sonra standart çıktı, standart hata ve çıkış kodu ağaç
+# yürütücüsününkiyle aynı olmalıdır. Programın yanında .out dosyası varsa
+# ağaç yürütücüsünün çıktısı onunla da karşılaştırılır.
+#
+# Kullanım: tests/run_differential.sh [c-cube] [program.cube ...]
+# Program verilmezse tests/programs/*.cube çalıştırılır.
+
+set -u
+
+TESTS_DIR="$(cd "$(dirname "$0")" && pwd)"
+C_CUBE="${1:-./c-cube}"
+shift $(( $# > 0 ? 1 : 0 ))
+
+if [ ! -x "$C_CUBE" ]; then
+    echo "Yorumlayıcı bulunamadı: $C_CUBE (önce 'make' çalıştırın)" >&2
+    exit 2
+fi
+
+if [ $# -eq 0 ]; then
+    set -- "$TESTS_DIR"/programs/*.cube
+fi
+
+MODES="tree closure flat jit trace-loops"
+WORK="$(mktemp -d)"
+trap 'rm -rf "$WORK"' EXIT
+
+# shellcheck source=tests/output_filter.sh
+. "$TESTS_DIR/output_filter.sh"
+
+mode_options() { # mode
+    case "$1" in
+        jit) echo "--exec=tree --jit=1" ;;
+        trace-loops) echo "--exec=tree --trace-loops=1" ;;
+        *) echo "--exec=$1" ;;
+    esac
+}
+
+run_mode() { # program mode
+    local out="$WORK/$2"
+    "$C_CUBE" --no-ast-cache $(mode_options "$2") "$1" > "$out.raw" 2> "$out.err"
+    echo $? > "$out.code"
+    filter_gc_output < "$out.raw" > "$out.out"
+}
+
+failures=0
+for program in "$@"; do
+    name="$(basename "$program" .cube)"
+    failed=0
+    for mode in $MODES; do
+        run_mode "$program" "$mode"
+    done
+    for mode in $MODES; do
+        [ "$mode" = tree ] && continue
+        for part in out err code; do
+            if ! diff -u --label "$name [tree] $part" --label "$name [$mode] $part" \
+                    "$WORK/tree.$part" "$WORK/$mode.$part"; then
+                failed=1
+            fi
+        done
+    done
+    expected="${program%.cube}.out"
+    if [ -f "$expected" ] && ! diff -u --label "$name beklenen" --label "$name [tree]" \
+            "$expected" "$WORK/tree.out"; then
+        failed=1
+    fi
+    if [ $failed -eq 0 ]; then
+        echo "GEÇTİ  $name"
+    else
+        echo "KALDI  $name"
+        failures=$((failures + 1))
+    fi
+done
+
+if [ $failures -ne 0 ]; then
+    echo "$failures program yürütme biçimleri arasında farklı sonuç verdi." >&2
+    exit 1
+fi